@@ -17,6 +17,7 @@
 #include <tet_api.h>
 
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include <unistd.h>
 
@@ -42,6 +43,33 @@ void (*tet_cleanup)(void) = cleanup;
 #define API_NAME_SETTINGS_GET_VALUE_BOOL 	"system_settings_get_value_bool"
 #define API_NAME_SETTINGS_SET_CHANGED_CB 	"system_settings_set_changed_cb"
 #define API_NAME_SETTINGS_UNSET_CHANGED_CB 	"system_settings_unset_changed_cb"
+#define API_NAME_SETTINGS_SNAPSHOT_ACQUIRE 	"system_settings_snapshot_acquire"
+#define API_NAME_SETTINGS_ADD_VALUE_CHANGED_CB 	"system_settings_add_value_changed_cb"
+#define API_NAME_SETTINGS_ADD_GROUP_CHANGED_CB 	"system_settings_add_group_changed_cb"
+#define API_NAME_SETTINGS_GET_RINGTONE_METADATA 	"system_settings_get_ringtone_metadata"
+#define API_NAME_SETTINGS_GET_WALLPAPER_OPTIMIZED_PATH 	"system_settings_get_wallpaper_optimized_path"
+#define API_NAME_SETTINGS_GET_WALLPAPER_PALETTE 	"system_settings_get_wallpaper_palette"
+#define API_NAME_SETTINGS_FOREACH_FONT 	"system_settings_foreach_font"
+#define API_NAME_SETTINGS_SET_RATE_LIMIT 	"system_settings_set_rate_limit"
+#define API_NAME_SETTINGS_CONTEXT_CREATE 	"system_settings_context_create"
+#define API_NAME_SETTINGS_KEY_FROM_NAME 	"system_settings_key_from_name"
+#define API_NAME_SETTINGS_COMPARE_AND_SET_INT 	"system_settings_compare_and_set_value_int"
+
+#define WALLPAPER_SOURCE_PATH 	"/opt/share/settings/Wallpapers/Home_default.jpg"
+#define WALLPAPER_CACHE_DIR 	"/opt/var/cache/system-settings/wallpaper"
+
+static void utc_system_settings_value_changed_font_size(system_settings_key_e key, system_settings_value_h value, void *user_data)
+{
+	int font_size = -1;
+
+	system_settings_value_get_int(value, &font_size);
+	printf(">>>>>>>> system_settings_value_changed key = %d, font size = %d \n", key, font_size);
+}
+
+static void utc_system_settings_group_changed_font(system_settings_group_e group, const system_settings_key_e *keys, int count, void *user_data)
+{
+	printf(">>>>>>>> system_settings_group_changed group = %d, %d keys \n", group, count);
+}
 
 static void utc_system_settings_set_string_p(void);
 static void utc_system_settings_set_bool_p(void);
@@ -50,6 +78,17 @@ static void utc_system_settings_get_int_p(void);
 static void utc_system_settings_get_bool_p(void);
 static void utc_system_settings_set_changed_cb(void);
 static void utc_system_settings_unset_changed_cb(void);
+static void utc_system_settings_snapshot_p(void);
+static void utc_system_settings_add_value_changed_cb_p(void);
+static void utc_system_settings_add_group_changed_cb_p(void);
+static void utc_system_settings_get_ringtone_metadata_p(void);
+static void utc_system_settings_get_wallpaper_optimized_path_p(void);
+static void utc_system_settings_get_wallpaper_palette_p(void);
+static void utc_system_settings_foreach_font_p(void);
+static void utc_system_settings_set_rate_limit_p(void);
+static void utc_system_settings_context_p(void);
+static void utc_system_settings_key_from_name_p(void);
+static void utc_system_settings_compare_and_set_int_p(void);
 
 
 struct tet_testlist tet_testlist[] = {
@@ -60,6 +99,17 @@ struct tet_testlist tet_testlist[] = {
 	{utc_system_settings_get_bool_p, 1},
 	{utc_system_settings_set_changed_cb, 1},
 	{utc_system_settings_unset_changed_cb, 1},
+	{utc_system_settings_snapshot_p, 1},
+	{utc_system_settings_add_value_changed_cb_p, 1},
+	{utc_system_settings_add_group_changed_cb_p, 1},
+	{utc_system_settings_get_ringtone_metadata_p, 1},
+	{utc_system_settings_get_wallpaper_optimized_path_p, 1},
+	{utc_system_settings_get_wallpaper_palette_p, 1},
+	{utc_system_settings_foreach_font_p, 1},
+	{utc_system_settings_set_rate_limit_p, 1},
+	{utc_system_settings_context_p, 1},
+	{utc_system_settings_key_from_name_p, 1},
+	{utc_system_settings_compare_and_set_int_p, 1},
 	{NULL, 0},
 };
 
@@ -190,3 +240,263 @@ static void utc_system_settings_unset_changed_cb(void)
 		dts_fail(API_NAME_SETTINGS_UNSET_CHANGED_CB, "failed");
 	}
 }
+
+static void utc_system_settings_snapshot_p(void)
+{
+	system_settings_snapshot_h snapshot = NULL;
+	int font_size = -1;
+	const char *font_type = NULL;
+	int retcode = system_settings_snapshot_acquire(&snapshot);
+
+	if (retcode == SYSTEM_SETTINGS_ERROR_NONE) {
+		retcode = system_settings_snapshot_get_value_int(snapshot, SYSTEM_SETTINGS_KEY_FONT_SIZE, &font_size);
+	}
+	if (retcode == SYSTEM_SETTINGS_ERROR_NONE) {
+		retcode = system_settings_snapshot_get_value_string(snapshot, SYSTEM_SETTINGS_KEY_FONT_TYPE, &font_type);
+	}
+	if (snapshot) {
+		system_settings_snapshot_release(snapshot);
+	}
+
+	if (retcode == SYSTEM_SETTINGS_ERROR_NONE) {
+		dts_pass(API_NAME_SETTINGS_SNAPSHOT_ACQUIRE, "passed");
+	}
+	else {
+		dts_fail(API_NAME_SETTINGS_SNAPSHOT_ACQUIRE, "failed");
+	}
+}
+
+static void utc_system_settings_add_value_changed_cb_p(void)
+{
+	int retcode = system_settings_add_value_changed_cb(SYSTEM_SETTINGS_KEY_FONT_SIZE, utc_system_settings_value_changed_font_size, NULL);
+
+	if (retcode == SYSTEM_SETTINGS_ERROR_NONE) {
+		retcode = system_settings_remove_value_changed_cb(SYSTEM_SETTINGS_KEY_FONT_SIZE, utc_system_settings_value_changed_font_size);
+	}
+
+	if (retcode == SYSTEM_SETTINGS_ERROR_NONE) {
+		dts_pass(API_NAME_SETTINGS_ADD_VALUE_CHANGED_CB, "passed");
+	}
+	else {
+		dts_fail(API_NAME_SETTINGS_ADD_VALUE_CHANGED_CB, "failed");
+	}
+}
+
+static void utc_system_settings_add_group_changed_cb_p(void)
+{
+	int retcode = system_settings_add_group_changed_cb(SYSTEM_SETTINGS_GROUP_FONT, utc_system_settings_group_changed_font, NULL);
+
+	if (retcode == SYSTEM_SETTINGS_ERROR_NONE) {
+		retcode = system_settings_remove_group_changed_cb(SYSTEM_SETTINGS_GROUP_FONT, utc_system_settings_group_changed_font);
+	}
+
+	if (retcode == SYSTEM_SETTINGS_ERROR_NONE) {
+		dts_pass(API_NAME_SETTINGS_ADD_GROUP_CHANGED_CB, "passed");
+	}
+	else {
+		dts_fail(API_NAME_SETTINGS_ADD_GROUP_CHANGED_CB, "failed");
+	}
+}
+
+static void utc_system_settings_get_ringtone_metadata_p(void)
+{
+	system_settings_ringtone_metadata_s metadata;
+	int retcode = system_settings_set_value_string(SYSTEM_SETTINGS_KEY_INCOMING_CALL_RINGTONE, "/opt/share/settings/Ringtones/General_Over the horizon.mp3");
+
+	if (retcode == SYSTEM_SETTINGS_ERROR_NONE) {
+		retcode = system_settings_get_ringtone_metadata(&metadata);
+	}
+
+	if (retcode == SYSTEM_SETTINGS_ERROR_NONE && metadata.format == SYSTEM_SETTINGS_AUDIO_FORMAT_MP3) {
+		dts_pass(API_NAME_SETTINGS_GET_RINGTONE_METADATA, "passed");
+	}
+	else {
+		dts_fail(API_NAME_SETTINGS_GET_RINGTONE_METADATA, "failed");
+	}
+}
+
+static void utc_system_settings_get_wallpaper_optimized_path_p(void)
+{
+	char *path = NULL;
+	int retcode;
+
+	system_settings_set_wallpaper_prescale(true);
+	retcode = system_settings_set_value_string(SYSTEM_SETTINGS_KEY_WALLPAPER_HOME_SCREEN, WALLPAPER_SOURCE_PATH);
+
+	if (retcode == SYSTEM_SETTINGS_ERROR_NONE) {
+		retcode = system_settings_get_wallpaper_optimized_path(SYSTEM_SETTINGS_KEY_WALLPAPER_HOME_SCREEN, &path);
+	}
+
+	system_settings_set_wallpaper_prescale(false);
+
+	/* the original path is also a valid result, only a pre-scaled copy in the cache passes */
+	if (retcode == SYSTEM_SETTINGS_ERROR_NONE && path != NULL
+		&& strcmp(path, WALLPAPER_SOURCE_PATH) != 0
+		&& strncmp(path, WALLPAPER_CACHE_DIR "/", strlen(WALLPAPER_CACHE_DIR "/")) == 0
+		&& access(path, R_OK) == 0) {
+		dts_pass(API_NAME_SETTINGS_GET_WALLPAPER_OPTIMIZED_PATH, "passed");
+	}
+	else {
+		dts_fail(API_NAME_SETTINGS_GET_WALLPAPER_OPTIMIZED_PATH, "failed");
+	}
+	free(path);
+}
+
+static void utc_system_settings_get_wallpaper_palette_p(void)
+{
+	system_settings_palette_s palette;
+	int retcode = system_settings_set_value_string(SYSTEM_SETTINGS_KEY_WALLPAPER_LOCK_SCREEN, "/opt/share/settings/Wallpapers/Home_default.jpg");
+
+	if (retcode == SYSTEM_SETTINGS_ERROR_NONE) {
+		retcode = system_settings_get_wallpaper_palette(SYSTEM_SETTINGS_KEY_WALLPAPER_LOCK_SCREEN, &palette);
+	}
+
+	if (retcode == SYSTEM_SETTINGS_ERROR_NONE && palette.accent_count <= SYSTEM_SETTINGS_PALETTE_ACCENT_MAX) {
+		dts_pass(API_NAME_SETTINGS_GET_WALLPAPER_PALETTE, "passed");
+	}
+	else {
+		dts_fail(API_NAME_SETTINGS_GET_WALLPAPER_PALETTE, "failed");
+	}
+}
+
+static bool utc_system_settings_font_cb(const char *font_name, void *user_data)
+{
+	char **first = user_data;
+
+	*first = strdup(font_name);
+	return false;
+}
+
+static void utc_system_settings_foreach_font_p(void)
+{
+	char *font_name = NULL;
+	int retcode = system_settings_foreach_font(utc_system_settings_font_cb, &font_name);
+
+	/* an installed family is accepted as the font type */
+	if (retcode == SYSTEM_SETTINGS_ERROR_NONE && font_name != NULL) {
+		retcode = system_settings_set_value_string(SYSTEM_SETTINGS_KEY_FONT_TYPE, font_name);
+	}
+
+	if (retcode == SYSTEM_SETTINGS_ERROR_NONE && font_name != NULL) {
+		dts_pass(API_NAME_SETTINGS_FOREACH_FONT, "passed");
+	}
+	else {
+		dts_fail(API_NAME_SETTINGS_FOREACH_FONT, "failed");
+	}
+	free(font_name);
+}
+
+static void utc_system_settings_set_rate_limit_p(void)
+{
+	unsigned int rejected = 0;
+	int retcode = system_settings_set_rate_limit(SYSTEM_SETTINGS_KEY_MOTION_ACTIVATION, 1, 1, SYSTEM_SETTINGS_RATE_LIMIT_REJECT);
+
+	/* the burst allows one write, the next one is over the limit */
+	if (retcode == SYSTEM_SETTINGS_ERROR_NONE) {
+		retcode = system_settings_set_value_bool(SYSTEM_SETTINGS_KEY_MOTION_ACTIVATION, true);
+	}
+	if (retcode == SYSTEM_SETTINGS_ERROR_NONE) {
+		retcode = system_settings_set_value_bool(SYSTEM_SETTINGS_KEY_MOTION_ACTIVATION, false) == SYSTEM_SETTINGS_ERROR_RESOURCE_BUSY
+			? SYSTEM_SETTINGS_ERROR_NONE : SYSTEM_SETTINGS_ERROR_IO_ERROR;
+	}
+	if (retcode == SYSTEM_SETTINGS_ERROR_NONE) {
+		retcode = system_settings_get_stat(SYSTEM_SETTINGS_STAT_WRITES_REJECTED, &rejected);
+	}
+
+	system_settings_set_rate_limit(SYSTEM_SETTINGS_KEY_MOTION_ACTIVATION, 0, 0, SYSTEM_SETTINGS_RATE_LIMIT_REJECT);
+
+	if (retcode == SYSTEM_SETTINGS_ERROR_NONE && rejected > 0) {
+		dts_pass(API_NAME_SETTINGS_SET_RATE_LIMIT, "passed");
+	}
+	else {
+		dts_fail(API_NAME_SETTINGS_SET_RATE_LIMIT, "failed");
+	}
+}
+
+static void utc_system_settings_context_p(void)
+{
+	system_settings_context_h first = NULL;
+	system_settings_context_h second = NULL;
+	int font_size = -1;
+	int retcode = system_settings_context_create("utc/first", &first);
+
+	if (retcode == SYSTEM_SETTINGS_ERROR_NONE) {
+		retcode = system_settings_context_create("utc/second", &second);
+	}
+
+	/* the values of a context are not seen by the other */
+	if (retcode == SYSTEM_SETTINGS_ERROR_NONE) {
+		retcode = system_settings_context_set_value_int(first, SYSTEM_SETTINGS_KEY_FONT_SIZE, SYSTEM_SETTINGS_FONT_SIZE_LARGE);
+	}
+	if (retcode == SYSTEM_SETTINGS_ERROR_NONE) {
+		retcode = system_settings_context_set_value_int(second, SYSTEM_SETTINGS_KEY_FONT_SIZE, SYSTEM_SETTINGS_FONT_SIZE_SMALL);
+	}
+	if (retcode == SYSTEM_SETTINGS_ERROR_NONE) {
+		retcode = system_settings_context_get_value_int(first, SYSTEM_SETTINGS_KEY_FONT_SIZE, &font_size);
+	}
+
+	if (second) {
+		system_settings_context_destroy(second);
+	}
+	if (first) {
+		system_settings_context_destroy(first);
+	}
+
+	if (retcode == SYSTEM_SETTINGS_ERROR_NONE && font_size == SYSTEM_SETTINGS_FONT_SIZE_LARGE) {
+		dts_pass(API_NAME_SETTINGS_CONTEXT_CREATE, "passed");
+	}
+	else {
+		dts_fail(API_NAME_SETTINGS_CONTEXT_CREATE, "failed");
+	}
+}
+
+static void utc_system_settings_key_from_name_p(void)
+{
+	system_settings_key_e key = SYSTEM_SETTINGS_KEY_INCOMING_CALL_RINGTONE;
+	bool motion_activation = false;
+	int retcode = system_settings_key_from_name("font_size", &key);
+
+	/* near misses of a name are not found */
+	if (retcode == SYSTEM_SETTINGS_ERROR_NONE && key == SYSTEM_SETTINGS_KEY_FONT_SIZE
+		&& system_settings_key_from_name("font_siz", &key) == SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER
+		&& system_settings_key_from_name("font_size_", &key) == SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER) {
+		retcode = system_settings_set_value_bool_by_name("motion_activation", true);
+	}
+	else {
+		retcode = SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER;
+	}
+	if (retcode == SYSTEM_SETTINGS_ERROR_NONE) {
+		retcode = system_settings_get_value_bool(SYSTEM_SETTINGS_KEY_MOTION_ACTIVATION, &motion_activation);
+	}
+
+	if (retcode == SYSTEM_SETTINGS_ERROR_NONE && motion_activation) {
+		dts_pass(API_NAME_SETTINGS_KEY_FROM_NAME, "passed");
+	}
+	else {
+		dts_fail(API_NAME_SETTINGS_KEY_FROM_NAME, "failed");
+	}
+}
+
+static void utc_system_settings_compare_and_set_int_p(void)
+{
+	int font_size = -1;
+	int retcode = system_settings_set_value_int(SYSTEM_SETTINGS_KEY_FONT_SIZE, SYSTEM_SETTINGS_FONT_SIZE_NORMAL);
+
+	if (retcode == SYSTEM_SETTINGS_ERROR_NONE) {
+		retcode = system_settings_compare_and_set_value_int(SYSTEM_SETTINGS_KEY_FONT_SIZE,
+				SYSTEM_SETTINGS_FONT_SIZE_NORMAL, SYSTEM_SETTINGS_FONT_SIZE_LARGE, &font_size);
+	}
+
+	/* the second writer expecting the old value fails and gets the new one */
+	if (retcode == SYSTEM_SETTINGS_ERROR_NONE) {
+		retcode = system_settings_compare_and_set_value_int(SYSTEM_SETTINGS_KEY_FONT_SIZE,
+				SYSTEM_SETTINGS_FONT_SIZE_NORMAL, SYSTEM_SETTINGS_FONT_SIZE_SMALL, &font_size);
+	}
+
+	if (retcode == SYSTEM_SETTINGS_ERROR_TRY_AGAIN && font_size == SYSTEM_SETTINGS_FONT_SIZE_LARGE) {
+		dts_pass(API_NAME_SETTINGS_COMPARE_AND_SET_INT, "passed");
+	}
+	else {
+		dts_fail(API_NAME_SETTINGS_COMPARE_AND_SET_INT, "failed");
+	}
+}
@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef __SYSTEM_SETTINGS_BENCH_H__
+#define __SYSTEM_SETTINGS_BENCH_H__
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <time.h>
+#include <sys/time.h>
+#include <sys/resource.h>
+
+static inline uint64_t bench_now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+/* user + system CPU time of the process */
+static inline uint64_t bench_cpu_ns(void)
+{
+    struct rusage usage;
+
+    getrusage(RUSAGE_SELF, &usage);
+    return ((uint64_t)usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) * 1000000000ull
+        + ((uint64_t)usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) * 1000ull;
+}
+
+static inline void bench_sleep_until(uint64_t deadline)
+{
+    struct timespec ts;
+
+    ts.tv_sec = deadline / 1000000000ull;
+    ts.tv_nsec = deadline % 1000000000ull;
+    clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL);
+}
+
+static inline int bench_compare_ns(const void *a, const void *b)
+{
+    uint64_t x = *(const uint64_t*)a;
+    uint64_t y = *(const uint64_t*)b;
+
+    return x < y ? -1 : x > y;
+}
+
+/* samples must be sorted */
+static inline uint64_t bench_percentile(const uint64_t *samples, size_t count, double p)
+{
+    if (count == 0)
+        return 0;
+
+    return samples[(size_t)((count - 1) * p)];
+}
+
+#endif /* __SYSTEM_SETTINGS_BENCH_H__ */
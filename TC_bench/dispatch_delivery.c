@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Delivery checks of the asynchronous dispatch modes: every change pushed in
+ * a burst is delivered, the last one included, without waiting for a later
+ * change. Settings are stored in the in-memory backend. Exits with 1 when a
+ * check fails.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <glib.h>
+
+#include <system_settings.h>
+#include <system_settings_private.h>
+#include <system_settings_backend_private.h>
+
+#include "bench.h"
+
+#define DELIVERY_TIMEOUT_NS 5000000000ull
+
+static int failures;
+static volatile gint delivered;
+static bool last_value;
+
+
+static void changed_cb(system_settings_key_e key, system_settings_value_h value, void *user_data)
+{
+    system_settings_value_get_bool(value, &last_value);
+    g_atomic_int_inc(&delivered);
+}
+
+/* the main loop mode delivers from the default context, which is iterated here */
+static void wait_for(int count, system_settings_dispatch_mode_e mode)
+{
+    uint64_t deadline = bench_now_ns() + DELIVERY_TIMEOUT_NS;
+
+    while (g_atomic_int_get(&delivered) < count && bench_now_ns() < deadline) {
+        if (mode == SYSTEM_SETTINGS_DISPATCH_MAIN_LOOP)
+            g_main_context_iteration(NULL, FALSE);
+        g_usleep(1000);
+    }
+}
+
+static void check_burst(const char *name, system_settings_dispatch_mode_e mode, int count)
+{
+    bool value = last_value;
+    int i;
+
+    g_atomic_int_set(&delivered, 0);
+
+    /* every value differs from the previous one, so none is filtered */
+    for (i = 0; i < count; i++) {
+        value = !value;
+        system_setting_vconf_set_motion_activation(value);
+    }
+
+    wait_for(count, mode);
+
+    /* late extra deliveries would show up here */
+    g_usleep(10000);
+
+    printf("%s %-36s %d / %d delivered\n", g_atomic_int_get(&delivered) == count && last_value == value ? "PASS" : "FAIL",
+           name, g_atomic_int_get(&delivered), count);
+
+    if (g_atomic_int_get(&delivered) != count || last_value != value)
+        failures++;
+}
+
+int main(int argc, char *argv[])
+{
+    system_setting_backend_set(&system_setting_backend_memory);
+    system_setting_vconf_set_motion_activation(false);
+    last_value = false;
+
+    system_settings_add_value_changed_cb(SYSTEM_SETTINGS_KEY_MOTION_ACTIVATION, changed_cb, NULL);
+
+    system_settings_set_dispatch_mode(SYSTEM_SETTINGS_DISPATCH_WORKER);
+    check_burst("worker, 1 change", SYSTEM_SETTINGS_DISPATCH_WORKER, 1);
+    check_burst("worker, 3 changes", SYSTEM_SETTINGS_DISPATCH_WORKER, 3);
+    check_burst("worker, 1000 changes", SYSTEM_SETTINGS_DISPATCH_WORKER, 1000);
+
+    system_settings_set_dispatch_mode(SYSTEM_SETTINGS_DISPATCH_MAIN_LOOP);
+    check_burst("main loop, 3 changes", SYSTEM_SETTINGS_DISPATCH_MAIN_LOOP, 3);
+    check_burst("main loop, 1000 changes", SYSTEM_SETTINGS_DISPATCH_MAIN_LOOP, 1000);
+
+    system_settings_set_dispatch_mode(SYSTEM_SETTINGS_DISPATCH_SYNC);
+    system_settings_remove_value_changed_cb(SYSTEM_SETTINGS_KEY_MOTION_ACTIVATION, changed_cb);
+
+    printf("%d failed\n", failures);
+    return failures ? 1 : 0;
+}
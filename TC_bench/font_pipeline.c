@@ -0,0 +1,227 @@
+/*
+ * Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Font pipeline: times each stage of the font size and font type set paths.
+ *
+ * usage: bench_font_pipeline [-n iterations] [-o overlays] [-x]
+ *
+ *   -o  number of synthetic font overlays added to the elementary
+ *       configuration before the run (text classes come from the theme)
+ *   -x  notify the X root window; needs a display, e.g. Xvfb. By default the
+ *       notification is replaced by a stub.
+ *
+ * Elementary runs on the buffer engine unless ELM_ENGINE is set, and HOME is
+ * pointed to a temporary directory so that elm_config_save() does not touch
+ * the user configuration. Settings are stored in the in-memory backend.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <Elementary.h>
+
+#include <system_settings.h>
+#include <system_settings_private.h>
+#include <system_settings_backend_private.h>
+
+#include "bench.h"
+
+enum {
+    PATH_FONT_SIZE,
+    PATH_FONT_TYPE,
+    PATH_COUNT,
+};
+
+static const char *path_names[PATH_COUNT] = { "font size", "font type" };
+
+static const char *stage_names[SYSTEM_SETTING_FONT_STAGE_COUNT] = {
+    [SYSTEM_SETTING_FONT_STAGE_PARSE] = "parse",
+    [SYSTEM_SETTING_FONT_STAGE_OVERLAY_SET] = "overlay set",
+    [SYSTEM_SETTING_FONT_STAGE_APPLY] = "apply",
+    [SYSTEM_SETTING_FONT_STAGE_FLUSH] = "flush",
+    [SYSTEM_SETTING_FONT_STAGE_SAVE] = "save",
+    [SYSTEM_SETTING_FONT_STAGE_NOTIFY] = "notify",
+};
+
+/* the font type must be an installed family, see system_settings_foreach_font() */
+static char *font_names[3];
+static unsigned int font_count;
+
+static unsigned int iterations = 50;
+static unsigned int overlays = 0;
+static int use_x = 0;
+
+/* samples[path][stage][iteration], the last stage slot holds the total */
+static uint64_t *samples;
+static unsigned int current_path;
+static unsigned int current_iteration;
+static unsigned int stub_notifications;
+
+#define SAMPLE(path, stage, i) samples[((path) * (SYSTEM_SETTING_FONT_STAGE_COUNT + 1) + (stage)) * iterations + (i)]
+
+
+static void bench_stage_cb(system_setting_font_stage_e stage, unsigned long long ns, void *user_data)
+{
+    SAMPLE(current_path, stage, current_iteration) += ns;
+}
+
+static void bench_stub_notifier(void)
+{
+    stub_notifications++;
+}
+
+static bool bench_collect_font(const char *font_name, void *user_data)
+{
+    font_names[font_count++] = strdup(font_name);
+    return font_count < sizeof(font_names) / sizeof(font_names[0]);
+}
+
+static void bench_add_overlays(unsigned int count)
+{
+    char name[32];
+    unsigned int i;
+
+    for (i = 0; i < count; i++) {
+        snprintf(name, sizeof(name), "bench_class_%u", i);
+        elm_config_font_overlay_set(name, "Sans", -100);
+    }
+
+    elm_config_font_overlay_apply();
+}
+
+static int bench_prepare_environment(void)
+{
+    char home[] = "/tmp/system-settings-bench-XXXXXX";
+
+    if (mkdtemp(home) == NULL) {
+        perror("mkdtemp");
+        return -1;
+    }
+
+    setenv("HOME", home, 1);
+    setenv("ELM_ENGINE", "buffer", 0);
+
+    return 0;
+}
+
+static void bench_report(unsigned int path)
+{
+    uint64_t *row;
+    unsigned int stage;
+
+    printf("%s\n", path_names[path]);
+
+    for (stage = 0; stage <= SYSTEM_SETTING_FONT_STAGE_COUNT; stage++) {
+        row = &SAMPLE(path, stage, 0);
+        qsort(row, iterations, sizeof(uint64_t), bench_compare_ns);
+
+        if (row[iterations - 1] == 0)
+            continue;
+
+        printf("  %-12s p50 %10.1f us   p99 %10.1f us   max %10.1f us\n",
+               stage < SYSTEM_SETTING_FONT_STAGE_COUNT ? stage_names[stage] : "total",
+               bench_percentile(row, iterations, 0.50) / 1e3,
+               bench_percentile(row, iterations, 0.99) / 1e3,
+               bench_percentile(row, iterations, 1.0) / 1e3);
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    system_setting_value_s value;
+    system_setting_h item;
+    uint64_t begin;
+    int font_size;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "n:o:x")) != -1) {
+        switch (opt) {
+        case 'n':
+            iterations = atoi(optarg);
+            break;
+        case 'o':
+            overlays = atoi(optarg);
+            break;
+        case 'x':
+            use_x = 1;
+            break;
+        default:
+            fprintf(stderr, "usage: %s [-n iterations] [-o overlays] [-x]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    if (iterations == 0 || bench_prepare_environment())
+        return 1;
+
+    samples = calloc((size_t)PATH_COUNT * (SYSTEM_SETTING_FONT_STAGE_COUNT + 1) * iterations, sizeof(uint64_t));
+    if (samples == NULL) {
+        fprintf(stderr, "out of memory\n");
+        return 1;
+    }
+
+    elm_init(argc, argv);
+    bench_add_overlays(overlays);
+
+    system_setting_backend_set(&system_setting_backend_memory);
+
+    if (system_settings_foreach_font(bench_collect_font, NULL) || font_count == 0) {
+        fprintf(stderr, "no font installed\n");
+        return 1;
+    }
+
+    /* font_size_set() reads the current size back from the store */
+    system_settings_get_item(SYSTEM_SETTINGS_KEY_FONT_SIZE, &item);
+    value.data_type = SYSTEM_SETTING_DATA_TYPE_INT;
+    value.value.i = SYSTEM_SETTINGS_FONT_SIZE_NORMAL;
+    system_setting_backend_memory.set_value(item->vconf_key, &value);
+
+    if (!use_x)
+        system_setting_font_set_notifier(bench_stub_notifier);
+    system_setting_font_set_stage_cb(bench_stage_cb, NULL);
+
+    for (current_iteration = 0; current_iteration < iterations; current_iteration++) {
+        current_path = PATH_FONT_SIZE;
+        font_size = SYSTEM_SETTINGS_FONT_SIZE_SMALL + current_iteration % (SYSTEM_SETTINGS_FONT_SIZE_GIANT + 1);
+        begin = bench_now_ns();
+        system_settings_set_value(SYSTEM_SETTINGS_KEY_FONT_SIZE, SYSTEM_SETTING_DATA_TYPE_INT, &font_size);
+        SAMPLE(PATH_FONT_SIZE, SYSTEM_SETTING_FONT_STAGE_COUNT, current_iteration) = bench_now_ns() - begin;
+
+        current_path = PATH_FONT_TYPE;
+        begin = bench_now_ns();
+        system_settings_set_value(SYSTEM_SETTINGS_KEY_FONT_TYPE, SYSTEM_SETTING_DATA_TYPE_STRING,
+                                  font_names[current_iteration % font_count]);
+        SAMPLE(PATH_FONT_TYPE, SYSTEM_SETTING_FONT_STAGE_COUNT, current_iteration) = bench_now_ns() - begin;
+    }
+
+    system_setting_font_set_stage_cb(NULL, NULL);
+    system_setting_font_set_notifier(NULL);
+
+    printf("\n%u iterations, %u synthetic overlays, %s notifier, engine %s\n", iterations, overlays,
+           use_x ? "X" : "stub", getenv("ELM_ENGINE"));
+    bench_report(PATH_FONT_SIZE);
+    bench_report(PATH_FONT_TYPE);
+
+    elm_shutdown();
+    while (font_count > 0)
+        free(font_names[--font_count]);
+    free(samples);
+
+    return 0;
+}
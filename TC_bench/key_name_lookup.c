@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Key name lookup: compares system_settings_key_from_name() with a strcmp()
+ * chain over the key names, for every key name and for unknown names.
+ *
+ * usage: bench_key_name_lookup [-n iterations]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <system_settings.h>
+#include <system_settings_private.h>
+
+#include "bench.h"
+
+#define KEY_NAME_ENTRY(name, key, type, vconf_key, min, max, get, check, apply, groups) \
+    { #name, key },
+
+static const struct {
+    const char *name;
+    system_settings_key_e key;
+} key_names[] = {
+    SYSTEM_SETTING_SCHEMA(KEY_NAME_ENTRY)
+};
+
+#define KEY_NAME_COUNT (sizeof(key_names) / sizeof(key_names[0]))
+
+/* a prefix, a suffix, a same length miss and an empty name */
+static const char *unknown_names[] = { "font", "font_size_", "font_sizf", "" };
+
+#define UNKNOWN_NAME_COUNT (sizeof(unknown_names) / sizeof(unknown_names[0]))
+
+static unsigned int iterations = 1000000;
+
+static int strcmp_lookup(const char *name, system_settings_key_e *key)
+{
+    size_t i;
+
+    for (i = 0; i < KEY_NAME_COUNT; i++) {
+        if (!strcmp(name, key_names[i].name)) {
+            *key = key_names[i].key;
+            return 0;
+        }
+    }
+
+    return -1;
+}
+
+static double run(int (*lookup)(const char *, system_settings_key_e *), const char **names, size_t name_count,
+                  unsigned int *hits)
+{
+    system_settings_key_e key;
+    uint64_t start;
+    unsigned int i;
+    size_t j;
+
+    *hits = 0;
+    start = bench_now_ns();
+
+    for (i = 0; i < iterations; i++) {
+        for (j = 0; j < name_count; j++) {
+            if (lookup(names[j], &key) == 0)
+                (*hits)++;
+        }
+    }
+
+    return (double)(bench_now_ns() - start) / ((double)iterations * name_count);
+}
+
+static int parse_args(int argc, char *argv[])
+{
+    int opt;
+
+    while ((opt = getopt(argc, argv, "n:")) != -1) {
+        switch (opt) {
+        case 'n':
+            iterations = atoi(optarg);
+            break;
+        default:
+            return -1;
+        }
+    }
+
+    return iterations == 0 ? -1 : 0;
+}
+
+int main(int argc, char *argv[])
+{
+    const char *names[KEY_NAME_COUNT];
+    unsigned int hash_hits, strcmp_hits;
+    double hash_ns, strcmp_ns;
+    system_settings_key_e key;
+    size_t i;
+
+    if (parse_args(argc, argv)) {
+        fprintf(stderr, "usage: %s [-n iterations]\n", argv[0]);
+        return 1;
+    }
+
+    for (i = 0; i < KEY_NAME_COUNT; i++) {
+        names[i] = key_names[i].name;
+
+        if (system_settings_key_from_name(names[i], &key) || key != key_names[i].key) {
+            fprintf(stderr, "%s: wrong key\n", names[i]);
+            return 1;
+        }
+    }
+
+    printf("keys %u, iterations %u\n", (unsigned int)KEY_NAME_COUNT, iterations);
+
+    hash_ns = run(system_settings_key_from_name, names, KEY_NAME_COUNT, &hash_hits);
+    strcmp_ns = run(strcmp_lookup, names, KEY_NAME_COUNT, &strcmp_hits);
+    printf("known    hash %.1f ns, strcmp %.1f ns (hits %u / %u)\n", hash_ns, strcmp_ns, hash_hits, strcmp_hits);
+
+    hash_ns = run(system_settings_key_from_name, unknown_names, UNKNOWN_NAME_COUNT, &hash_hits);
+    strcmp_ns = run(strcmp_lookup, unknown_names, UNKNOWN_NAME_COUNT, &strcmp_hits);
+    printf("unknown  hash %.1f ns, strcmp %.1f ns (hits %u / %u)\n", hash_ns, strcmp_ns, hash_hits, strcmp_hits);
+
+    return hash_hits || strcmp_hits ? 1 : 0;
+}
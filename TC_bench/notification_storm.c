@@ -0,0 +1,246 @@
+/*
+ * Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Notification storm: changes are written to the in-memory backend from a
+ * producer thread at a fixed rate, round robin over the keys, and the time
+ * from the write to each callback invocation is measured.
+ *
+ * usage: bench_notification_storm [-n subscribers] [-r changes/s] [-c changes] [-m sync|worker|main-loop]
+ *
+ * Each key gets one system_settings_set_changed_cb() callback, which only
+ * counts, and n - 1 value callbacks, which measure the latency. BOOL keys
+ * can not carry a sequence number and are not written.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <glib.h>
+
+#include <system_settings.h>
+#include <system_settings_private.h>
+#include <system_settings_backend_private.h>
+
+#include "bench.h"
+
+#define DRAIN_TIMEOUT_NS 2000000000ull
+
+static unsigned int subscriber_count = 8;
+static unsigned int change_rate = 10000;
+static unsigned int change_count = 100000;
+static system_settings_dispatch_mode_e dispatch_mode = SYSTEM_SETTINGS_DISPATCH_WORKER;
+
+static system_settings_key_e keys[SYSTEM_SETTINGS_KEY_COUNT];
+static unsigned int key_count;
+
+static uint64_t *send_time;				/* by sequence number */
+static uint64_t *latencies;
+static volatile gint latency_count;
+static volatile gint value_deliveries;
+static volatile gint changed_deliveries;
+static volatile gint producer_done;
+
+static GMainLoop *main_loop;
+
+
+static void storm_changed_cb(system_settings_key_e key, void *user_data)
+{
+    g_atomic_int_inc(&changed_deliveries);
+}
+
+static void storm_value_changed_cb(system_settings_key_e key, system_settings_value_h value, void *user_data)
+{
+    uint64_t now = bench_now_ns();
+    const char *str;
+    int seq;
+    int i;
+
+    if (system_settings_value_get_int(value, &seq) != SYSTEM_SETTINGS_ERROR_NONE) {
+        if (system_settings_value_get_string(value, &str) != SYSTEM_SETTINGS_ERROR_NONE)
+            return;
+        seq = atoi(str);
+    }
+
+    g_atomic_int_inc(&value_deliveries);
+
+    if (seq < 0 || (unsigned int)seq >= change_count)
+        return;
+
+    i = g_atomic_int_add(&latency_count, 1);
+    latencies[i] = now - send_time[seq];
+}
+
+static gpointer storm_producer(gpointer data)
+{
+    system_setting_value_s value;
+    system_setting_h item;
+    char str[16];
+    uint64_t start = bench_now_ns();
+    unsigned int seq;
+
+    for (seq = 0; seq < change_count; seq++) {
+        bench_sleep_until(start + (uint64_t)seq * 1000000000ull / change_rate);
+
+        system_settings_get_item(keys[seq % key_count], &item);
+
+        value.data_type = item->data_type;
+        if (item->data_type == SYSTEM_SETTING_DATA_TYPE_INT) {
+            value.value.i = seq;
+        } else {
+            snprintf(str, sizeof(str), "%u", seq);
+            value.value.s = str;
+        }
+
+        send_time[seq] = bench_now_ns();
+        system_setting_backend_memory.set_value(item->vconf_key, &value);
+    }
+
+    g_atomic_int_set(&producer_done, 1);
+    return NULL;
+}
+
+static gboolean storm_check_done(gpointer data)
+{
+    static uint64_t deadline;
+
+    if (!g_atomic_int_get(&producer_done))
+        return TRUE;
+
+    if (deadline == 0)
+        deadline = bench_now_ns() + DRAIN_TIMEOUT_NS;
+
+    if ((unsigned int)g_atomic_int_get(&value_deliveries) >= change_count * (subscriber_count - 1)
+        || bench_now_ns() > deadline) {
+        g_main_loop_quit(main_loop);
+        return FALSE;
+    }
+
+    return TRUE;
+}
+
+static int parse_args(int argc, char *argv[])
+{
+    int opt;
+
+    while ((opt = getopt(argc, argv, "n:r:c:m:")) != -1) {
+        switch (opt) {
+        case 'n':
+            subscriber_count = atoi(optarg);
+            break;
+        case 'r':
+            change_rate = atoi(optarg);
+            break;
+        case 'c':
+            change_count = atoi(optarg);
+            break;
+        case 'm':
+            if (!strcmp(optarg, "sync"))
+                dispatch_mode = SYSTEM_SETTINGS_DISPATCH_SYNC;
+            else if (!strcmp(optarg, "worker"))
+                dispatch_mode = SYSTEM_SETTINGS_DISPATCH_WORKER;
+            else if (!strcmp(optarg, "main-loop"))
+                dispatch_mode = SYSTEM_SETTINGS_DISPATCH_MAIN_LOOP;
+            else
+                return -1;
+            break;
+        default:
+            return -1;
+        }
+    }
+
+    return subscriber_count < 2 || change_rate == 0 || change_count == 0 ? -1 : 0;
+}
+
+int main(int argc, char *argv[])
+{
+    system_setting_h item;
+    GThread *producer;
+    uint64_t start, elapsed, cpu;
+    unsigned int expected;
+    unsigned int i, k;
+    int key;
+
+    if (parse_args(argc, argv)) {
+        fprintf(stderr, "usage: %s [-n subscribers>=2] [-r changes/s] [-c changes] [-m sync|worker|main-loop]\n", argv[0]);
+        return 1;
+    }
+
+    system_setting_backend_set(&system_setting_backend_memory);
+    system_settings_set_dispatch_mode(dispatch_mode);
+
+    for (key = 0; key < SYSTEM_SETTINGS_KEY_COUNT; key++) {
+        system_settings_get_item(key, &item);
+        if (item->data_type == SYSTEM_SETTING_DATA_TYPE_INT || item->data_type == SYSTEM_SETTING_DATA_TYPE_STRING)
+            keys[key_count++] = key;
+    }
+
+    send_time = calloc(change_count, sizeof(uint64_t));
+    latencies = calloc((size_t)change_count * (subscriber_count - 1), sizeof(uint64_t));
+    if (send_time == NULL || latencies == NULL) {
+        fprintf(stderr, "out of memory\n");
+        return 1;
+    }
+
+    for (k = 0; k < key_count; k++) {
+        system_settings_set_changed_cb(keys[k], storm_changed_cb, NULL);
+        for (i = 1; i < subscriber_count; i++)
+            system_settings_add_value_changed_cb(keys[k], storm_value_changed_cb, NULL);
+    }
+
+    main_loop = g_main_loop_new(NULL, FALSE);
+    g_timeout_add(10, storm_check_done, NULL);
+
+    start = bench_now_ns();
+    cpu = bench_cpu_ns();
+
+    producer = g_thread_new("storm-producer", storm_producer, NULL);
+    g_main_loop_run(main_loop);
+    g_thread_join(producer);
+
+    elapsed = bench_now_ns() - start;
+    cpu = bench_cpu_ns() - cpu;
+
+    expected = change_count * (subscriber_count - 1);
+    qsort(latencies, latency_count, sizeof(uint64_t), bench_compare_ns);
+
+    printf("keys %u, subscribers/key %u, rate %u/s, changes %u, mode %s\n", key_count, subscriber_count,
+           change_rate, change_count, dispatch_mode == SYSTEM_SETTINGS_DISPATCH_SYNC ? "sync"
+           : dispatch_mode == SYSTEM_SETTINGS_DISPATCH_WORKER ? "worker" : "main-loop");
+    printf("elapsed          %.3f s\n", elapsed / 1e9);
+    printf("changed cb       %d / %u\n", g_atomic_int_get(&changed_deliveries), change_count);
+    printf("value cb         %d / %u (dropped or merged %d)\n", g_atomic_int_get(&value_deliveries), expected,
+           (int)expected - g_atomic_int_get(&value_deliveries));
+    printf("latency p50      %.1f us\n", bench_percentile(latencies, latency_count, 0.50) / 1e3);
+    printf("latency p99      %.1f us\n", bench_percentile(latencies, latency_count, 0.99) / 1e3);
+    printf("latency p999     %.1f us\n", bench_percentile(latencies, latency_count, 0.999) / 1e3);
+    printf("latency max      %.1f us\n", bench_percentile(latencies, latency_count, 1.0) / 1e3);
+    printf("cpu per change   %.2f us\n", cpu / 1e3 / change_count);
+
+    for (k = 0; k < key_count; k++) {
+        system_settings_unset_changed_cb(keys[k]);
+        for (i = 1; i < subscriber_count; i++)
+            system_settings_remove_value_changed_cb(keys[k], storm_value_changed_cb);
+    }
+
+    g_main_loop_unref(main_loop);
+    free(latencies);
+    free(send_time);
+
+    return 0;
+}
@@ -0,0 +1,317 @@
+/*
+ * Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Tail latency checks against the fault injecting backend. Each check pairs a
+ * baseline, which shows that the injected fault is visible, with the path
+ * that is expected to hide it. Exits with 1 when a check fails.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+
+#include <glib.h>
+
+#include <system_settings.h>
+#include <system_settings_private.h>
+#include <system_settings_backend_private.h>
+
+#include "bench.h"
+
+#define SAMPLES 200
+#define DELIVERY_TIMEOUT_NS 5000000000ull
+
+static int failures;
+
+static uint64_t send_time[SAMPLES];
+static uint64_t delivery[SAMPLES];
+static volatile gint delivered;
+static volatile gint slow_delivered;
+
+
+static uint64_t p99(uint64_t *samples, size_t count)
+{
+    qsort(samples, count, sizeof(uint64_t), bench_compare_ns);
+    return bench_percentile(samples, count, 0.99);
+}
+
+static void check(const char *name, int ok, const char *fmt, ...)
+{
+    va_list ap;
+
+    printf("%s %-36s ", ok ? "PASS" : "FAIL", name);
+    va_start(ap, fmt);
+    vprintf(fmt, ap);
+    va_end(ap);
+    printf("\n");
+
+    if (!ok)
+        failures++;
+}
+
+static void seed_key(system_settings_key_e key)
+{
+    system_setting_value_s value;
+    system_setting_h item;
+
+    system_settings_get_item(key, &item);
+    memset(&value, 0, sizeof(value));
+    value.data_type = item->data_type;
+
+    switch (item->data_type) {
+    case SYSTEM_SETTING_DATA_TYPE_STRING:
+        value.value.s = "seed";
+        break;
+    case SYSTEM_SETTING_DATA_TYPE_INT:
+        value.value.i = SYSTEM_SETTINGS_FONT_SIZE_NORMAL;
+        break;
+    default:
+        break;
+    }
+
+    system_setting_backend_memory.set_value(item->vconf_key, &value);
+}
+
+static const char *vconf_key_of(system_settings_key_e key)
+{
+    system_setting_h item;
+
+    system_settings_get_item(key, &item);
+    return item->vconf_key;
+}
+
+static void wait_for(volatile gint *counter, int count)
+{
+    uint64_t deadline = bench_now_ns() + DELIVERY_TIMEOUT_NS;
+
+    while (g_atomic_int_get(counter) < count && bench_now_ns() < deadline)
+        g_usleep(1000);
+}
+
+/* a snapshot is served from its cache while storage reads stall */
+static void check_snapshot_hides_read_latency(void)
+{
+    system_setting_fault_s fault = {
+        .latency_distribution = SYSTEM_SETTING_FAULT_LATENCY_CONSTANT,
+        .latency_us = 2000,
+        .stall_rate = 0.05,
+        .stall_us = 20000,
+    };
+    system_settings_snapshot_h snapshot;
+    uint64_t direct[SAMPLES], cached[SAMPLES];
+    uint64_t begin;
+    int value;
+    int i;
+
+    system_setting_backend_fault_set(NULL, &fault);
+
+    for (i = 0; i < SAMPLES; i++) {
+        begin = bench_now_ns();
+        system_settings_get_value_int(SYSTEM_SETTINGS_KEY_FONT_SIZE, &value);
+        direct[i] = bench_now_ns() - begin;
+    }
+
+    /* the first snapshot pays for every key */
+    system_settings_snapshot_acquire(&snapshot);
+    system_settings_snapshot_release(snapshot);
+
+    for (i = 0; i < SAMPLES; i++) {
+        begin = bench_now_ns();
+        system_settings_snapshot_acquire(&snapshot);
+        system_settings_snapshot_get_value_int(snapshot, SYSTEM_SETTINGS_KEY_FONT_SIZE, &value);
+        system_settings_snapshot_release(snapshot);
+        cached[i] = bench_now_ns() - begin;
+    }
+
+    system_setting_backend_fault_reset();
+
+    check("read latency, direct get", p99(direct, SAMPLES) >= fault.latency_us * 1000ull,
+          "p99 %.1f us", p99(direct, SAMPLES) / 1e3);
+    check("read latency, snapshot", p99(cached, SAMPLES) < fault.latency_us * 1000ull / 2,
+          "p99 %.1f us", p99(cached, SAMPLES) / 1e3);
+}
+
+/* failed reads surface as SYSTEM_SETTINGS_ERROR_IO_ERROR and nothing else */
+static void check_read_errors(void)
+{
+    system_setting_fault_s fault = { .read_error_rate = 0.5 };
+    int io_errors = 0;
+    int other_errors = 0;
+    int value;
+    int ret;
+    int i;
+
+    system_setting_backend_fault_set(vconf_key_of(SYSTEM_SETTINGS_KEY_FONT_SIZE), &fault);
+
+    for (i = 0; i < 1000; i++) {
+        /* every read goes to the backend, the negative cache would otherwise repeat a failure */
+        system_setting_backoff_reset(SYSTEM_SETTINGS_KEY_FONT_SIZE);
+        ret = system_settings_get_value_int(SYSTEM_SETTINGS_KEY_FONT_SIZE, &value);
+        if (ret == SYSTEM_SETTINGS_ERROR_IO_ERROR)
+            io_errors++;
+        else if (ret != SYSTEM_SETTINGS_ERROR_NONE)
+            other_errors++;
+    }
+
+    system_setting_backend_fault_reset();
+    system_setting_backoff_reset(SYSTEM_SETTINGS_KEY_FONT_SIZE);
+
+    check("read errors", io_errors > 350 && io_errors < 650 && other_errors == 0,
+          "%d io errors, %d other errors in 1000 reads", io_errors, other_errors);
+}
+
+/* font_size_set() gives up without touching elementary when the size can not be read back */
+static void check_font_size_read_error(void)
+{
+    system_setting_fault_s fault = { .read_error_rate = 1.0 };
+    uint64_t samples[SAMPLES];
+    uint64_t begin;
+    int errors = 0;
+    int i;
+
+    system_setting_backend_fault_set(vconf_key_of(SYSTEM_SETTINGS_KEY_FONT_SIZE), &fault);
+
+    for (i = 0; i < SAMPLES; i++) {
+        begin = bench_now_ns();
+        if (system_settings_set_value_int(SYSTEM_SETTINGS_KEY_FONT_SIZE, SYSTEM_SETTINGS_FONT_SIZE_NORMAL) != SYSTEM_SETTINGS_ERROR_NONE)
+            errors++;
+        samples[i] = bench_now_ns() - begin;
+    }
+
+    system_setting_backend_fault_reset();
+
+    check("font size apply, read error", errors == 0 && p99(samples, SAMPLES) < 50000000ull,
+          "%d errors, p99 %.1f us", errors, p99(samples, SAMPLES) / 1e3);
+}
+
+static void wallpaper_changed_cb(system_settings_key_e key, system_settings_value_h value, void *user_data)
+{
+    uint64_t now = bench_now_ns();
+    const char *str;
+    int seq;
+
+    if (system_settings_value_get_string(value, &str) != SYSTEM_SETTINGS_ERROR_NONE)
+        return;
+
+    seq = atoi(str);
+    if (seq >= 0 && seq < SAMPLES) {
+        delivery[seq] = now - send_time[seq];
+        g_atomic_int_inc(&delivered);
+    }
+}
+
+static void slow_changed_cb(system_settings_key_e key, system_settings_value_h value, void *user_data)
+{
+    g_usleep(GPOINTER_TO_UINT(user_data));
+    g_atomic_int_inc(&slow_delivered);
+}
+
+/* a key with slow notifications does not hold back the others */
+static void check_slow_notifications_isolated(void)
+{
+    system_setting_fault_s fault = { .notify_delay_us = 50000 };
+    char str[16];
+    int i;
+
+    system_setting_backend_fault_set(vconf_key_of(SYSTEM_SETTINGS_KEY_FONT_SIZE), &fault);
+    system_settings_set_dispatch_mode(SYSTEM_SETTINGS_DISPATCH_WORKER);
+
+    system_settings_add_value_changed_cb(SYSTEM_SETTINGS_KEY_WALLPAPER_HOME_SCREEN, wallpaper_changed_cb, NULL);
+    system_settings_add_value_changed_cb(SYSTEM_SETTINGS_KEY_FONT_SIZE, slow_changed_cb, GUINT_TO_POINTER(0));
+
+    g_atomic_int_set(&delivered, 0);
+    g_atomic_int_set(&slow_delivered, 0);
+
+    for (i = 0; i < SAMPLES; i++) {
+        system_setting_vconf_set_font_size(SYSTEM_SETTINGS_FONT_SIZE_SMALL + i % 2);
+
+        snprintf(str, sizeof(str), "%d", i);
+        send_time[i] = bench_now_ns();
+        system_setting_vconf_set_wallpaper_home_screen(str);
+
+        g_usleep(200);
+    }
+
+    wait_for(&delivered, SAMPLES);
+    wait_for(&slow_delivered, SAMPLES);
+
+    system_settings_remove_value_changed_cb(SYSTEM_SETTINGS_KEY_WALLPAPER_HOME_SCREEN, wallpaper_changed_cb);
+    system_settings_remove_value_changed_cb(SYSTEM_SETTINGS_KEY_FONT_SIZE, slow_changed_cb);
+    system_settings_set_dispatch_mode(SYSTEM_SETTINGS_DISPATCH_SYNC);
+    system_setting_backend_fault_reset();
+
+    check("slow notifications, other key", g_atomic_int_get(&delivered) == SAMPLES
+          && p99(delivery, SAMPLES) < fault.notify_delay_us * 1000ull / 10,
+          "%d delivered, p99 %.1f us", g_atomic_int_get(&delivered), p99(delivery, SAMPLES) / 1e3);
+    check("slow notifications, delayed key", g_atomic_int_get(&slow_delivered) == SAMPLES,
+          "%d delivered", g_atomic_int_get(&slow_delivered));
+}
+
+/* with worker dispatch a slow callback does not slow down the writer */
+static void check_slow_callback_async(void)
+{
+    uint64_t sync_samples[20], async_samples[SAMPLES];
+    uint64_t begin;
+    int i;
+
+    system_settings_add_value_changed_cb(SYSTEM_SETTINGS_KEY_FONT_SIZE, slow_changed_cb, GUINT_TO_POINTER(5000));
+
+    g_atomic_int_set(&slow_delivered, 0);
+    for (i = 0; i < 20; i++) {
+        begin = bench_now_ns();
+        system_setting_vconf_set_font_size(SYSTEM_SETTINGS_FONT_SIZE_SMALL + i % 2);
+        sync_samples[i] = bench_now_ns() - begin;
+    }
+
+    system_settings_set_dispatch_mode(SYSTEM_SETTINGS_DISPATCH_WORKER);
+
+    g_atomic_int_set(&slow_delivered, 0);
+    for (i = 0; i < SAMPLES; i++) {
+        begin = bench_now_ns();
+        system_setting_vconf_set_font_size(SYSTEM_SETTINGS_FONT_SIZE_SMALL + i % 2);
+        async_samples[i] = bench_now_ns() - begin;
+    }
+    wait_for(&slow_delivered, SAMPLES);
+
+    system_settings_remove_value_changed_cb(SYSTEM_SETTINGS_KEY_FONT_SIZE, slow_changed_cb);
+    system_settings_set_dispatch_mode(SYSTEM_SETTINGS_DISPATCH_SYNC);
+
+    check("slow callback, sync dispatch", p99(sync_samples, 20) >= 5000000ull,
+          "write p99 %.1f us", p99(sync_samples, 20) / 1e3);
+    check("slow callback, worker dispatch", p99(async_samples, SAMPLES) < 1000000ull,
+          "write p99 %.1f us", p99(async_samples, SAMPLES) / 1e3);
+}
+
+int main(int argc, char *argv[])
+{
+    int key;
+
+    system_setting_backend_set(&system_setting_backend_fault);
+
+    for (key = 0; key < SYSTEM_SETTINGS_KEY_COUNT; key++)
+        seed_key(key);
+
+    check_snapshot_hides_read_latency();
+    check_read_errors();
+    check_font_size_read_error();
+    check_slow_notifications_isolated();
+    check_slow_callback_async();
+
+    printf("%d failed\n", failures);
+    return failures ? 1 : 0;
+}
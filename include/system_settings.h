@@ -39,6 +39,8 @@ typedef enum
 	SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER = TIZEN_ERROR_INVALID_PARAMETER, /**< Invalid parameter */
 	SYSTEM_SETTINGS_ERROR_OUT_OF_MEMORY = TIZEN_ERROR_OUT_OF_MEMORY, /**< Out of memory */
 	SYSTEM_SETTINGS_ERROR_IO_ERROR =  TIZEN_ERROR_IO_ERROR, /**< Internal I/O error */
+	SYSTEM_SETTINGS_ERROR_RESOURCE_BUSY = TIZEN_ERROR_RESOURCE_BUSY, /**< Rate limit of writes exceeded */
+	SYSTEM_SETTINGS_ERROR_TRY_AGAIN = TIZEN_ERROR_TRY_AGAIN, /**< The value is not the expected one, see system_settings_compare_and_set_value_int() */
 } system_settings_error_e;
 
 
@@ -53,9 +55,23 @@ typedef enum
 	SYSTEM_SETTINGS_KEY_FONT_SIZE, /**< The current system font size */
 	SYSTEM_SETTINGS_KEY_FONT_TYPE, /**< The current system font type */
 	SYSTEM_SETTINGS_KEY_MOTION_ACTIVATION, /**< Indicates whether the motion service is activated */
+	SYSTEM_SETTINGS_KEY_VENDOR_BASE = 0x1000, /**< The first key ID of the vendor keys described by the installed vendor schema */
 } system_settings_key_e;
 
 
+/**
+ * @brief Enumeration of the groups of related system settings keys
+ * @see system_settings_add_group_changed_cb()
+ */
+typedef enum
+{
+	SYSTEM_SETTINGS_GROUP_FONT = 0, /**< #SYSTEM_SETTINGS_KEY_FONT_SIZE and #SYSTEM_SETTINGS_KEY_FONT_TYPE */
+	SYSTEM_SETTINGS_GROUP_WALLPAPER, /**< #SYSTEM_SETTINGS_KEY_WALLPAPER_HOME_SCREEN and #SYSTEM_SETTINGS_KEY_WALLPAPER_LOCK_SCREEN */
+	SYSTEM_SETTINGS_GROUP_SOUND, /**< #SYSTEM_SETTINGS_KEY_INCOMING_CALL_RINGTONE */
+	SYSTEM_SETTINGS_GROUP_ALL, /**< All the system settings keys except the vendor keys */
+} system_settings_group_e;
+
+
 /**
  * @brief Enumeration of font size
  */
@@ -69,6 +85,101 @@ typedef enum
 } system_settings_font_size_e;
 
 
+/**
+ * @brief Enumeration of the container formats of ringtone files
+ */
+typedef enum
+{
+	SYSTEM_SETTINGS_AUDIO_FORMAT_UNKNOWN = 0, /**< A format the library does not parse */
+	SYSTEM_SETTINGS_AUDIO_FORMAT_WAV, /**< RIFF WAVE */
+	SYSTEM_SETTINGS_AUDIO_FORMAT_OGG, /**< Ogg Vorbis or Ogg Opus */
+	SYSTEM_SETTINGS_AUDIO_FORMAT_MP3, /**< MPEG audio layer III */
+} system_settings_audio_format_e;
+
+
+/**
+ * @brief Structure of the metadata of the current ringtone file
+ * @see system_settings_get_ringtone_metadata()
+ */
+typedef struct
+{
+	system_settings_audio_format_e format; /**< The container format */
+	int duration_ms; /**< The duration in milliseconds, or -1 if unknown */
+	int sample_rate; /**< The sample rate in Hz, or -1 if unknown */
+	int channels; /**< The number of channels, or -1 if unknown */
+} system_settings_ringtone_metadata_s;
+
+
+/**
+ * @brief The maximum number of accent colours of a palette
+ */
+#define SYSTEM_SETTINGS_PALETTE_ACCENT_MAX 4
+
+
+/**
+ * @brief Structure of the colour palette of a wallpaper, colours are 0xRRGGBB
+ * @see system_settings_get_wallpaper_palette()
+ */
+typedef struct
+{
+	unsigned int dominant; /**< The most frequent colour */
+	unsigned int accents[SYSTEM_SETTINGS_PALETTE_ACCENT_MAX]; /**< Distinct frequent colours, most frequent first */
+	int accent_count; /**< The number of valid entries of @a accents */
+} system_settings_palette_s;
+
+
+/**
+ * @brief Enumeration of the threads on which change callbacks are invoked
+ * @see system_settings_set_dispatch_mode()
+ */
+typedef enum
+{
+	SYSTEM_SETTINGS_DISPATCH_SYNC = 0, /**< Callbacks are invoked inside the notification, before the next notification is handled */
+	SYSTEM_SETTINGS_DISPATCH_WORKER, /**< Callbacks are invoked on a pool of worker threads of the library */
+	SYSTEM_SETTINGS_DISPATCH_MAIN_LOOP, /**< Callbacks are invoked from the main loop of the thread which registered them */
+} system_settings_dispatch_mode_e;
+
+
+/**
+ * @brief Enumeration of the statistics counters of the library in the calling process
+ * @see system_settings_get_stat()
+ */
+typedef enum
+{
+	SYSTEM_SETTINGS_STAT_NOTIFICATIONS = 0, /**< The number of change notifications received from the backing store */
+	SYSTEM_SETTINGS_STAT_NOTIFICATIONS_FILTERED, /**< The number of change notifications dropped because the value did not change */
+	SYSTEM_SETTINGS_STAT_WRITES_REJECTED, /**< The number of writes failed with #SYSTEM_SETTINGS_ERROR_RESOURCE_BUSY by a rate limit */
+	SYSTEM_SETTINGS_STAT_WRITES_COALESCED, /**< The number of writes deferred by a rate limit, only the latest of them is written */
+	SYSTEM_SETTINGS_STAT_READS_NEGATIVE_CACHED, /**< The number of reads failed without reading the backing store because the key failed recently */
+	SYSTEM_SETTINGS_STAT_WRITES_CONFLICTED, /**< The number of compare-and-set writes failed with #SYSTEM_SETTINGS_ERROR_TRY_AGAIN */
+} system_settings_stat_e;
+
+
+/**
+ * @brief Enumeration of what happens to writes over a rate limit
+ * @see system_settings_set_rate_limit()
+ */
+typedef enum
+{
+	SYSTEM_SETTINGS_RATE_LIMIT_REJECT = 0, /**< The write fails with #SYSTEM_SETTINGS_ERROR_RESOURCE_BUSY */
+	SYSTEM_SETTINGS_RATE_LIMIT_COALESCE, /**< The write succeeds and the value is written when the limit allows it, unless a later write replaces it */
+} system_settings_rate_limit_policy_e;
+
+
+/**
+ * @brief The handle of an immutable view of all system settings values
+ * @see system_settings_snapshot_acquire()
+ */
+typedef struct system_settings_snapshot_s *system_settings_snapshot_h;
+
+
+/**
+ * @brief The handle of a namespace of system settings values
+ * @see system_settings_context_create()
+ */
+typedef struct system_settings_context_s *system_settings_context_h;
+
+
 /**
  * @brief Called when the system settings changes
  * @param[in] key The key name of the system settings changed
@@ -79,6 +190,59 @@ typedef enum
  */
 typedef void (*system_settings_changed_cb)(system_settings_key_e key, void *user_data);
 
+/**
+ * @brief The handle of the new value carried by a change notification
+ * @see system_settings_value_changed_cb()
+ */
+typedef struct system_settings_value_s *system_settings_value_h;
+
+/**
+ * @brief Called when the system settings changes, with the new value
+ * @remarks @a value is valid only during the callback.
+ * @param[in] key The key name of the system settings changed
+ * @param[in] value The new value of the system settings
+ * @param[in] user_data The user data passed from the callback registration function
+ * @pre system_settings_add_value_changed_cb() will invoke this callback function.
+ * @see system_settings_add_value_changed_cb()
+ * @see system_settings_remove_value_changed_cb()
+ */
+typedef void (*system_settings_value_changed_cb)(system_settings_key_e key, system_settings_value_h value, void *user_data);
+
+/**
+ * @brief Called when keys of a group change
+ * @details Keys which change before the callback runs are reported together in one invocation.
+ * @remarks @a keys is valid only during the callback.
+ * @param[in] group The group of the system settings
+ * @param[in] keys The keys of the group which changed
+ * @param[in] count The number of @a keys
+ * @param[in] user_data The user data passed from the callback registration function
+ * @pre system_settings_add_group_changed_cb() will invoke this callback function.
+ * @see system_settings_add_group_changed_cb()
+ * @see system_settings_remove_group_changed_cb()
+ */
+typedef void (*system_settings_group_changed_cb)(system_settings_group_e group, const system_settings_key_e *keys, int count, void *user_data);
+
+/**
+ * @brief Called once for each installed font family
+ * @remarks @a font_name is valid only during the callback.
+ * @param[in] font_name The family name, a valid value of #SYSTEM_SETTINGS_KEY_FONT_TYPE
+ * @param[in] user_data The user data passed from the foreach function
+ * @return @c true to continue with the next iteration of the loop, \n @c false to break out of the loop.
+ * @pre system_settings_foreach_font() will invoke this callback function.
+ * @see system_settings_foreach_font()
+ */
+typedef bool (*system_settings_font_cb)(const char *font_name, void *user_data);
+
+/**
+ * @brief Called when a system settings value of a context changes
+ * @param[in] context The context of the changed value
+ * @param[in] key The key name of the system settings changed
+ * @param[in] user_data The user data passed from the callback registration function
+ * @pre system_settings_context_set_changed_cb() will invoke this callback function.
+ * @see system_settings_context_set_changed_cb()
+ */
+typedef void (*system_settings_context_changed_cb)(system_settings_context_h context, system_settings_key_e key, void *user_data);
+
 /**
  * @brief Sets the system settings value associated with the given key as an integer.
  * @param[in] key The key name of the system settings
@@ -150,6 +314,7 @@ int system_settings_get_value_double(system_settings_key_e key, double *value);
 
 /**
  * @brief Sets the system settings value associated with the given key as a string.
+ * @remarks #SYSTEM_SETTINGS_KEY_INCOMING_CALL_RINGTONE must be the path of a readable regular file.
  * @param[in] key The key name of the system settings
  * @param[out] value The new system settings value of the given key
  * @return  0 on success, otherwise a negative error value.
@@ -172,6 +337,199 @@ int system_settings_set_value_string(system_settings_key_e key, const char *valu
 int system_settings_get_value_string(system_settings_key_e key, char **value);
 
 
+/**
+ * @brief Sets the system settings value of the given key as an integer if it holds the expected value.
+ * @details The comparison and the write are one operation among the users of the system settings API, so of
+ * those which read the same value and set a new one, exactly one succeeds and the others get
+ * #SYSTEM_SETTINGS_ERROR_TRY_AGAIN together with the value to retry from:
+ * @code
+ * int size, next;
+ *
+ * system_settings_get_value_int(SYSTEM_SETTINGS_KEY_FONT_SIZE, &size);
+ * do {
+ *     next = size < SYSTEM_SETTINGS_FONT_SIZE_GIANT ? size + 1 : size;
+ * } while (system_settings_compare_and_set_value_int(SYSTEM_SETTINGS_KEY_FONT_SIZE, size, next, &size) == SYSTEM_SETTINGS_ERROR_TRY_AGAIN);
+ * @endcode
+ * The value is compared with the one the get functions return, which for #SYSTEM_SETTINGS_KEY_FONT_TYPE is the font in use.
+ * On vconf the operation is a read and a write under a lock taken by the system settings API only: a write made
+ * with vconf directly between them is overwritten without #SYSTEM_SETTINGS_ERROR_TRY_AGAIN.
+ * A key which holds no value does not hold @a expected, @a current is then 0, false or NULL.
+ * It fails with #SYSTEM_SETTINGS_ERROR_IO_ERROR when other compare-and-set writers keep the key busy for too long.
+ * Writes over a rate limit fail with #SYSTEM_SETTINGS_ERROR_RESOURCE_BUSY whatever its policy.
+ * @param[in] key The key name of the system settings
+ * @param[in] expected The value the key must hold
+ * @param[in] value The new system settings value of the key
+ * @param[out] current The value held by the key when it is not @a expected, or NULL
+ * @return  0 on success, otherwise a negative error value.
+ * @retval  #SYSTEM_SETTINGS_ERROR_NONE Successful
+ * @retval  #SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER Invalid parameter
+ * @retval  #SYSTEM_SETTINGS_ERROR_IO_ERROR Internal I/O error
+ * @retval  #SYSTEM_SETTINGS_ERROR_RESOURCE_BUSY Rate limit of writes exceeded
+ * @retval  #SYSTEM_SETTINGS_ERROR_TRY_AGAIN The key does not hold @a expected, @a current is set
+ * @see system_settings_set_value_int()
+ */
+int system_settings_compare_and_set_value_int(system_settings_key_e key, int expected, int value, int *current);
+
+/**
+ * @brief Sets the system settings value of the given key as a boolean if it holds the expected value.
+ * @param[in] key The key name of the system settings
+ * @param[in] expected The value the key must hold
+ * @param[in] value The new system settings value of the key
+ * @param[out] current The value held by the key when it is not @a expected, or NULL
+ * @return  0 on success, otherwise a negative error value.
+ * @retval  #SYSTEM_SETTINGS_ERROR_NONE Successful
+ * @retval  #SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER Invalid parameter
+ * @retval  #SYSTEM_SETTINGS_ERROR_IO_ERROR Internal I/O error
+ * @retval  #SYSTEM_SETTINGS_ERROR_RESOURCE_BUSY Rate limit of writes exceeded
+ * @retval  #SYSTEM_SETTINGS_ERROR_TRY_AGAIN The key does not hold @a expected, @a current is set
+ * @see system_settings_set_value_bool()
+ */
+int system_settings_compare_and_set_value_bool(system_settings_key_e key, bool expected, bool value, bool *current);
+
+/**
+ * @brief Sets the system settings value of the given key as a double if it holds the expected value.
+ * @param[in] key The key name of the system settings
+ * @param[in] expected The value the key must hold
+ * @param[in] value The new system settings value of the key
+ * @param[out] current The value held by the key when it is not @a expected, or NULL
+ * @return  0 on success, otherwise a negative error value.
+ * @retval  #SYSTEM_SETTINGS_ERROR_NONE Successful
+ * @retval  #SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER Invalid parameter
+ * @retval  #SYSTEM_SETTINGS_ERROR_IO_ERROR Internal I/O error
+ * @retval  #SYSTEM_SETTINGS_ERROR_RESOURCE_BUSY Rate limit of writes exceeded
+ * @retval  #SYSTEM_SETTINGS_ERROR_TRY_AGAIN The key does not hold @a expected, @a current is set
+ * @see system_settings_set_value_double()
+ */
+int system_settings_compare_and_set_value_double(system_settings_key_e key, double expected, double value, double *current);
+
+/**
+ * @brief Sets the system settings value of the given key as a string if it holds the expected value.
+ * @remarks @a current must be released with free() by you.
+ * @param[in] key The key name of the system settings
+ * @param[in] expected The value the key must hold
+ * @param[in] value The new system settings value of the key
+ * @param[out] current The value held by the key when it is not @a expected, or NULL
+ * @return  0 on success, otherwise a negative error value.
+ * @retval  #SYSTEM_SETTINGS_ERROR_NONE Successful
+ * @retval  #SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER Invalid parameter
+ * @retval  #SYSTEM_SETTINGS_ERROR_IO_ERROR Internal I/O error
+ * @retval  #SYSTEM_SETTINGS_ERROR_RESOURCE_BUSY Rate limit of writes exceeded
+ * @retval  #SYSTEM_SETTINGS_ERROR_TRY_AGAIN The key does not hold @a expected, @a current is set
+ * @see system_settings_set_value_string()
+ */
+int system_settings_compare_and_set_value_string(system_settings_key_e key, const char* expected, const char* value, char* *current);
+
+/**
+ * @brief Gets the key of the given name.
+ * @details The name of a key is the lower case name of its #system_settings_key_e value without the
+ * SYSTEM_SETTINGS_KEY_ prefix, e.g. "font_size" for #SYSTEM_SETTINGS_KEY_FONT_SIZE. Names are looked up in a
+ * perfect hash table generated from the keys at build time, which costs one pass over the name and one comparison.
+ * Vendor keys have no name.
+ * @param[in] name The name of the key
+ * @param[out] key The key of the given name
+ * @return  0 on success, otherwise a negative error value.
+ * @retval  #SYSTEM_SETTINGS_ERROR_NONE Successful
+ * @retval  #SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER Invalid parameter, or no key has the name
+ */
+int system_settings_key_from_name(const char *name, system_settings_key_e *key);
+
+/**
+ * @brief Gets the system settings value of the key of the given name as an integer.
+ * @param[in] name The name of the key, see system_settings_key_from_name()
+ * @param[out] value The system settings value of the key
+ * @return  0 on success, otherwise a negative error value.
+ * @retval  #SYSTEM_SETTINGS_ERROR_NONE Successful
+ * @retval  #SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER Invalid parameter, or no key has the name
+ * @retval  #SYSTEM_SETTINGS_ERROR_IO_ERROR Internal I/O error
+ * @see system_settings_get_value_int()
+ */
+int system_settings_get_value_int_by_name(const char *name, int *value);
+
+/**
+ * @brief Gets the system settings value of the key of the given name as a boolean.
+ * @param[in] name The name of the key, see system_settings_key_from_name()
+ * @param[out] value The system settings value of the key
+ * @return  0 on success, otherwise a negative error value.
+ * @retval  #SYSTEM_SETTINGS_ERROR_NONE Successful
+ * @retval  #SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER Invalid parameter, or no key has the name
+ * @retval  #SYSTEM_SETTINGS_ERROR_IO_ERROR Internal I/O error
+ * @see system_settings_get_value_bool()
+ */
+int system_settings_get_value_bool_by_name(const char *name, bool *value);
+
+/**
+ * @brief Gets the system settings value of the key of the given name as a double.
+ * @param[in] name The name of the key, see system_settings_key_from_name()
+ * @param[out] value The system settings value of the key
+ * @return  0 on success, otherwise a negative error value.
+ * @retval  #SYSTEM_SETTINGS_ERROR_NONE Successful
+ * @retval  #SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER Invalid parameter, or no key has the name
+ * @retval  #SYSTEM_SETTINGS_ERROR_IO_ERROR Internal I/O error
+ * @see system_settings_get_value_double()
+ */
+int system_settings_get_value_double_by_name(const char *name, double *value);
+
+/**
+ * @brief Gets the system settings value of the key of the given name as a string.
+ * @remarks @a value must be released with free() by you.
+ * @param[in] name The name of the key, see system_settings_key_from_name()
+ * @param[out] value The system settings value of the key
+ * @return  0 on success, otherwise a negative error value.
+ * @retval  #SYSTEM_SETTINGS_ERROR_NONE Successful
+ * @retval  #SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER Invalid parameter, or no key has the name
+ * @retval  #SYSTEM_SETTINGS_ERROR_IO_ERROR Internal I/O error
+ * @see system_settings_get_value_string()
+ */
+int system_settings_get_value_string_by_name(const char *name, char* *value);
+
+/**
+ * @brief Sets the system settings value of the key of the given name as an integer.
+ * @param[in] name The name of the key, see system_settings_key_from_name()
+ * @param[in] value The new system settings value of the key
+ * @return  0 on success, otherwise a negative error value.
+ * @retval  #SYSTEM_SETTINGS_ERROR_NONE Successful
+ * @retval  #SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER Invalid parameter, or no key has the name
+ * @retval  #SYSTEM_SETTINGS_ERROR_IO_ERROR Internal I/O error
+ * @see system_settings_set_value_int()
+ */
+int system_settings_set_value_int_by_name(const char *name, int value);
+
+/**
+ * @brief Sets the system settings value of the key of the given name as a boolean.
+ * @param[in] name The name of the key, see system_settings_key_from_name()
+ * @param[in] value The new system settings value of the key
+ * @return  0 on success, otherwise a negative error value.
+ * @retval  #SYSTEM_SETTINGS_ERROR_NONE Successful
+ * @retval  #SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER Invalid parameter, or no key has the name
+ * @retval  #SYSTEM_SETTINGS_ERROR_IO_ERROR Internal I/O error
+ * @see system_settings_set_value_bool()
+ */
+int system_settings_set_value_bool_by_name(const char *name, bool value);
+
+/**
+ * @brief Sets the system settings value of the key of the given name as a double.
+ * @param[in] name The name of the key, see system_settings_key_from_name()
+ * @param[in] value The new system settings value of the key
+ * @return  0 on success, otherwise a negative error value.
+ * @retval  #SYSTEM_SETTINGS_ERROR_NONE Successful
+ * @retval  #SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER Invalid parameter, or no key has the name
+ * @retval  #SYSTEM_SETTINGS_ERROR_IO_ERROR Internal I/O error
+ * @see system_settings_set_value_double()
+ */
+int system_settings_set_value_double_by_name(const char *name, double value);
+
+/**
+ * @brief Sets the system settings value of the key of the given name as a string.
+ * @param[in] name The name of the key, see system_settings_key_from_name()
+ * @param[in] value The new system settings value of the key
+ * @return  0 on success, otherwise a negative error value.
+ * @retval  #SYSTEM_SETTINGS_ERROR_NONE Successful
+ * @retval  #SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER Invalid parameter, or no key has the name
+ * @retval  #SYSTEM_SETTINGS_ERROR_IO_ERROR Internal I/O error
+ * @see system_settings_set_value_string()
+ */
+int system_settings_set_value_string_by_name(const char *name, const char* value);
+
 /**
  * @brief Registers a change event callback for the given system settings key.
  * @param[in] key The key name of the system settings
@@ -200,6 +558,478 @@ int system_settings_set_changed_cb(system_settings_key_e key, system_settings_ch
 int system_settings_unset_changed_cb(system_settings_key_e key);
 
 
+/**
+ * @brief Registers a change event callback which receives the new value of the given system settings key.
+ * @details The new value is taken from the change notification, so no value needs to be read in the callback.
+ * Several callbacks can be registered for the same key.
+ * @param[in] key The key name of the system settings
+ * @param[in] callback The callback function to invoke
+ * @param[in] user_data The user data to be passed to the callback function
+ * @return  0 on success, otherwise a negative error value.
+ * @retval  #SYSTEM_SETTINGS_ERROR_NONE Successful
+ * @retval  #SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER Invalid parameter
+ * @retval  #SYSTEM_SETTINGS_ERROR_IO_ERROR Internal I/O error
+ * @post system_settings_value_changed_cb() will be invoked.
+ * @see system_settings_remove_value_changed_cb()
+ */
+int system_settings_add_value_changed_cb(system_settings_key_e key, system_settings_value_changed_cb callback, void *user_data);
+
+/**
+ * @brief Unregisters a callback registered by system_settings_add_value_changed_cb().
+ * @param[in] key The key name of the system settings
+ * @param[in] callback The callback function to unregister
+ * @return  0 on success, otherwise a negative error value.
+ * @retval  #SYSTEM_SETTINGS_ERROR_NONE Successful
+ * @retval  #SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER Invalid parameter
+ * @see system_settings_add_value_changed_cb()
+ */
+int system_settings_remove_value_changed_cb(system_settings_key_e key, system_settings_value_changed_cb callback);
+
+/**
+ * @brief Gets a value passed to system_settings_value_changed_cb() as an integer.
+ * @param[in] value The value handle
+ * @param[out] out The value
+ * @return  0 on success, otherwise a negative error value.
+ * @retval  #SYSTEM_SETTINGS_ERROR_NONE Successful
+ * @retval  #SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER Invalid parameter
+ */
+int system_settings_value_get_int(system_settings_value_h value, int *out);
+
+/**
+ * @brief Gets a value passed to system_settings_value_changed_cb() as a boolean.
+ * @param[in] value The value handle
+ * @param[out] out The value
+ * @return  0 on success, otherwise a negative error value.
+ * @retval  #SYSTEM_SETTINGS_ERROR_NONE Successful
+ * @retval  #SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER Invalid parameter
+ */
+int system_settings_value_get_bool(system_settings_value_h value, bool *out);
+
+/**
+ * @brief Gets a value passed to system_settings_value_changed_cb() as a double.
+ * @param[in] value The value handle
+ * @param[out] out The value
+ * @return  0 on success, otherwise a negative error value.
+ * @retval  #SYSTEM_SETTINGS_ERROR_NONE Successful
+ * @retval  #SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER Invalid parameter
+ */
+int system_settings_value_get_double(system_settings_value_h value, double *out);
+
+/**
+ * @brief Gets a value passed to system_settings_value_changed_cb() as a string.
+ * @remarks @a out is borrowed from @a value and is valid only during the callback. Do not free it.
+ * @param[in] value The value handle
+ * @param[out] out The value
+ * @return  0 on success, otherwise a negative error value.
+ * @retval  #SYSTEM_SETTINGS_ERROR_NONE Successful
+ * @retval  #SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER Invalid parameter
+ */
+int system_settings_value_get_string(system_settings_value_h value, const char **out);
+
+
+/**
+ * @brief Registers a change event callback for all the keys of a group.
+ * @details The callback is invoked from the main loop of the calling thread.
+ * @param[in] group The group of the system settings
+ * @param[in] callback The callback function to invoke
+ * @param[in] user_data The user data to be passed to the callback function
+ * @return  0 on success, otherwise a negative error value.
+ * @retval  #SYSTEM_SETTINGS_ERROR_NONE Successful
+ * @retval  #SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER Invalid parameter
+ * @retval  #SYSTEM_SETTINGS_ERROR_IO_ERROR Internal I/O error
+ * @post system_settings_group_changed_cb() will be invoked.
+ * @see system_settings_remove_group_changed_cb()
+ */
+int system_settings_add_group_changed_cb(system_settings_group_e group, system_settings_group_changed_cb callback, void *user_data);
+
+/**
+ * @brief Unregisters a callback registered by system_settings_add_group_changed_cb().
+ * @param[in] group The group of the system settings
+ * @param[in] callback The callback function to unregister
+ * @return  0 on success, otherwise a negative error value.
+ * @retval  #SYSTEM_SETTINGS_ERROR_NONE Successful
+ * @retval  #SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER Invalid parameter
+ * @see system_settings_add_group_changed_cb()
+ */
+int system_settings_remove_group_changed_cb(system_settings_group_e group, system_settings_group_changed_cb callback);
+
+/**
+ * @brief Retrieves all installed font families, in alphabetical order.
+ * @details The families are read from an index which is rebuilt only when font directories change,
+ * so this does not scan fonts. The directories are checked at most once per second, a font installed
+ * since may be missing for up to a second. Setting #SYSTEM_SETTINGS_KEY_FONT_TYPE to a family which is not installed
+ * fails with #SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER.
+ * @param[in] callback The callback function to invoke
+ * @param[in] user_data The user data to be passed to the callback function
+ * @return  0 on success, otherwise a negative error value.
+ * @retval  #SYSTEM_SETTINGS_ERROR_NONE Successful
+ * @retval  #SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER Invalid parameter
+ * @retval  #SYSTEM_SETTINGS_ERROR_IO_ERROR The fonts could not be listed
+ * @post This function invokes system_settings_font_cb() repeatedly for each family.
+ * @see system_settings_font_cb()
+ */
+int system_settings_foreach_font(system_settings_font_cb callback, void *user_data);
+
+
+/**
+ * @brief Sets how change callbacks are dispatched.
+ * @details In #SYSTEM_SETTINGS_DISPATCH_WORKER and #SYSTEM_SETTINGS_DISPATCH_MAIN_LOOP modes notifications are queued
+ * without waiting on callbacks, so a slow callback does not delay the others.
+ * Callbacks of a key are always invoked one at a time, in the order of the changes.
+ * The default mode is #SYSTEM_SETTINGS_DISPATCH_SYNC.
+ * @param[in] mode The dispatch mode
+ * @return  0 on success, otherwise a negative error value.
+ * @retval  #SYSTEM_SETTINGS_ERROR_NONE Successful
+ * @retval  #SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER Invalid parameter
+ * @see system_settings_set_changed_cb()
+ */
+int system_settings_set_dispatch_mode(system_settings_dispatch_mode_e mode);
+
+
+/**
+ * @brief Enables or disables filtering of change notifications which do not change the value.
+ * @details The backing store notifies every write, including writes which store the value the key already has.
+ * When the filter is enabled, the new value of each notification is compared with the last value delivered for the key,
+ * and change callbacks are only invoked when it differs. The filter is disabled by default.
+ * @param[in] enable @c true to drop notifications without a value change, otherwise @c false
+ * @return  0 on success, otherwise a negative error value.
+ * @retval  #SYSTEM_SETTINGS_ERROR_NONE Successful
+ * @see #SYSTEM_SETTINGS_STAT_NOTIFICATIONS_FILTERED
+ */
+int system_settings_set_changed_filter(bool enable);
+
+
+/**
+ * @brief Gets the value of a statistics counter.
+ * @param[in] stat The statistics counter
+ * @param[out] value The number of events counted in the calling process
+ * @return  0 on success, otherwise a negative error value.
+ * @retval  #SYSTEM_SETTINGS_ERROR_NONE Successful
+ * @retval  #SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER Invalid parameter
+ */
+int system_settings_get_stat(system_settings_stat_e stat, unsigned int *value);
+
+/**
+ * @brief Limits the rate of writes of a key by the calling process.
+ * @details Writes use tokens of a bucket which holds up to @a burst tokens and is refilled with @a rate tokens per second.
+ * The limits can also be set with the SYSTEM_SETTINGS_RATE_LIMIT environment variable, e.g.
+ * "font_type=1/3/coalesce,process=20/40".
+ * @remarks With #SYSTEM_SETTINGS_RATE_LIMIT_COALESCE, the deferred value is written from the Ecore main loop,
+ * and errors of that write are only logged.
+ * @param[in] key The key name of the system settings
+ * @param[in] rate The number of writes per second, 0 to remove the limit
+ * @param[in] burst The number of writes allowed at once
+ * @param[in] policy What happens to writes over the limit
+ * @return  0 on success, otherwise a negative error value.
+ * @retval  #SYSTEM_SETTINGS_ERROR_NONE Successful
+ * @retval  #SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER Invalid parameter
+ * @see system_settings_set_process_rate_limit()
+ */
+int system_settings_set_rate_limit(system_settings_key_e key, unsigned int rate, unsigned int burst, system_settings_rate_limit_policy_e policy);
+
+/**
+ * @brief Limits the rate of writes of all keys by the calling process.
+ * @details The limit applies in addition to the limits of the keys.
+ * @param[in] rate The number of writes per second, 0 to remove the limit
+ * @param[in] burst The number of writes allowed at once
+ * @param[in] policy What happens to writes over the limit
+ * @return  0 on success, otherwise a negative error value.
+ * @retval  #SYSTEM_SETTINGS_ERROR_NONE Successful
+ * @retval  #SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER Invalid parameter
+ * @see system_settings_set_rate_limit()
+ */
+int system_settings_set_process_rate_limit(unsigned int rate, unsigned int burst, system_settings_rate_limit_policy_e policy);
+
+
+/**
+ * @brief Acquires an immutable view of all system settings values.
+ * @details The values of a snapshot are consistent: the keys changed while the snapshot is taken are read again, until
+ * no change is notified during the reads. Changes are notified by the writers of the calling process, and by other
+ * processes while a main loop runs; without a main loop, every acquire reads all the keys again.
+ * A change of several keys which is notified key by key may still be seen in part.
+ * The values never change afterwards, so a snapshot can be read from any thread without locking. Snapshots are shared and cached:
+ * acquiring one while no key has changed only takes a reference, and after a change only the changed keys are read again.
+ * @remarks @a snapshot must be released with system_settings_snapshot_release() by you.
+ * @param[out] snapshot The snapshot handle
+ * @return  0 on success, otherwise a negative error value.
+ * @retval  #SYSTEM_SETTINGS_ERROR_NONE Successful
+ * @retval  #SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER Invalid parameter
+ * @see system_settings_snapshot_release()
+ */
+int system_settings_snapshot_acquire(system_settings_snapshot_h *snapshot);
+
+/**
+ * @brief Releases a snapshot acquired by system_settings_snapshot_acquire().
+ * @param[in] snapshot The snapshot handle
+ * @return  0 on success, otherwise a negative error value.
+ * @retval  #SYSTEM_SETTINGS_ERROR_NONE Successful
+ * @retval  #SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER Invalid parameter
+ * @see system_settings_snapshot_acquire()
+ */
+int system_settings_snapshot_release(system_settings_snapshot_h snapshot);
+
+/**
+ * @brief Gets the value of the given key from a snapshot as an integer.
+ * @param[in] snapshot The snapshot handle
+ * @param[in] key The key name of the system settings
+ * @param[out] value The system settings value of the given key when the snapshot was taken
+ * @return  0 on success, otherwise a negative error value.
+ * @retval  #SYSTEM_SETTINGS_ERROR_NONE Successful
+ * @retval  #SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER Invalid parameter
+ * @retval  #SYSTEM_SETTINGS_ERROR_IO_ERROR The value could not be read when the snapshot was taken
+ */
+int system_settings_snapshot_get_value_int(system_settings_snapshot_h snapshot, system_settings_key_e key, int *value);
+
+/**
+ * @brief Gets the value of the given key from a snapshot as a boolean.
+ * @param[in] snapshot The snapshot handle
+ * @param[in] key The key name of the system settings
+ * @param[out] value The system settings value of the given key when the snapshot was taken
+ * @return  0 on success, otherwise a negative error value.
+ * @retval  #SYSTEM_SETTINGS_ERROR_NONE Successful
+ * @retval  #SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER Invalid parameter
+ * @retval  #SYSTEM_SETTINGS_ERROR_IO_ERROR The value could not be read when the snapshot was taken
+ */
+int system_settings_snapshot_get_value_bool(system_settings_snapshot_h snapshot, system_settings_key_e key, bool *value);
+
+/**
+ * @brief Gets the value of the given key from a snapshot as a double.
+ * @param[in] snapshot The snapshot handle
+ * @param[in] key The key name of the system settings
+ * @param[out] value The system settings value of the given key when the snapshot was taken
+ * @return  0 on success, otherwise a negative error value.
+ * @retval  #SYSTEM_SETTINGS_ERROR_NONE Successful
+ * @retval  #SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER Invalid parameter
+ * @retval  #SYSTEM_SETTINGS_ERROR_IO_ERROR The value could not be read when the snapshot was taken
+ */
+int system_settings_snapshot_get_value_double(system_settings_snapshot_h snapshot, system_settings_key_e key, double *value);
+
+/**
+ * @brief Gets the value of the given key from a snapshot as a string.
+ * @remarks @a value belongs to the snapshot and is valid until the snapshot is released. Do not free it.
+ * @param[in] snapshot The snapshot handle
+ * @param[in] key The key name of the system settings
+ * @param[out] value The system settings value of the given key when the snapshot was taken
+ * @return  0 on success, otherwise a negative error value.
+ * @retval  #SYSTEM_SETTINGS_ERROR_NONE Successful
+ * @retval  #SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER Invalid parameter
+ * @retval  #SYSTEM_SETTINGS_ERROR_IO_ERROR The value could not be read when the snapshot was taken
+ */
+int system_settings_snapshot_get_value_string(system_settings_snapshot_h snapshot, system_settings_key_e key, const char **value);
+
+/**
+ * @brief Gets the metadata of the current ringtone file.
+ * @details The metadata is computed when #SYSTEM_SETTINGS_KEY_INCOMING_CALL_RINGTONE is set, so that
+ * the incoming call path does not need to open and probe the file.
+ * @param[out] metadata The metadata of the file of #SYSTEM_SETTINGS_KEY_INCOMING_CALL_RINGTONE
+ * @return  0 on success, otherwise a negative error value.
+ * @retval  #SYSTEM_SETTINGS_ERROR_NONE Successful
+ * @retval  #SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER Invalid parameter
+ * @retval  #SYSTEM_SETTINGS_ERROR_IO_ERROR The ringtone file could not be read
+ * @see system_settings_set_value_string()
+ */
+int system_settings_get_ringtone_metadata(system_settings_ringtone_metadata_s *metadata);
+
+/**
+ * @brief Enables or disables the pre-scaling of wallpapers set by the calling process.
+ * @details When enabled, setting #SYSTEM_SETTINGS_KEY_WALLPAPER_HOME_SCREEN or #SYSTEM_SETTINGS_KEY_WALLPAPER_LOCK_SCREEN
+ * decodes the image once, stores its palette and a copy scaled to the screen size, which is then returned by
+ * system_settings_get_wallpaper_optimized_path(). Only the copies of the current home and lock screen wallpapers
+ * are kept. It is disabled by default.
+ * @param[in] enable @c true to pre-scale wallpapers when they are set
+ * @return  0 on success, otherwise a negative error value.
+ * @retval  #SYSTEM_SETTINGS_ERROR_NONE Successful
+ */
+int system_settings_set_wallpaper_prescale(bool enable);
+
+/**
+ * @brief Gets the path of the image to display for a wallpaper.
+ * @details This is the pre-scaled copy of the wallpaper if there is one, otherwise the wallpaper itself.
+ * @remarks @a path must be released with free() by you.
+ * @param[in] key #SYSTEM_SETTINGS_KEY_WALLPAPER_HOME_SCREEN or #SYSTEM_SETTINGS_KEY_WALLPAPER_LOCK_SCREEN
+ * @param[out] path The path of the image to display
+ * @return  0 on success, otherwise a negative error value.
+ * @retval  #SYSTEM_SETTINGS_ERROR_NONE Successful
+ * @retval  #SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER Invalid parameter
+ * @retval  #SYSTEM_SETTINGS_ERROR_IO_ERROR Internal I/O error
+ * @see system_settings_set_wallpaper_prescale()
+ */
+int system_settings_get_wallpaper_optimized_path(system_settings_key_e key, char **path);
+
+/**
+ * @brief Gets the colour palette of a wallpaper.
+ * @details When pre-scaling is enabled, the palette is computed when the wallpaper is set, before the change
+ * callbacks of the key are invoked, so that it can be read from them without decoding the image. Otherwise the
+ * image is decoded by this function.
+ * @param[in] key #SYSTEM_SETTINGS_KEY_WALLPAPER_HOME_SCREEN or #SYSTEM_SETTINGS_KEY_WALLPAPER_LOCK_SCREEN
+ * @param[out] palette The palette of the wallpaper
+ * @return  0 on success, otherwise a negative error value.
+ * @retval  #SYSTEM_SETTINGS_ERROR_NONE Successful
+ * @retval  #SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER Invalid parameter
+ * @retval  #SYSTEM_SETTINGS_ERROR_OUT_OF_MEMORY Out of memory
+ * @retval  #SYSTEM_SETTINGS_ERROR_IO_ERROR The wallpaper could not be decoded
+ * @see system_settings_set_changed_cb()
+ * @see system_settings_set_wallpaper_prescale()
+ */
+int system_settings_get_wallpaper_palette(system_settings_key_e key, system_settings_palette_s *palette);
+
+
+/**
+ * @brief Creates a context which stores the system settings values of a namespace.
+ * @details The keys of a context are stored apart from the global keys and from the keys of the other contexts:
+ * @a name is inserted after the first component of the backing key, e.g. "db/setting/font_size" is
+ * "db/<name>/setting/font_size" in the context named @a name. Each context caches the values it reads and
+ * notifies its own callbacks, so one process can serve many contexts, e.g. one per user session or container.
+ * @remarks Only the keys of #system_settings_key_e below #SYSTEM_SETTINGS_KEY_VENDOR_BASE can be used in a context.
+ * Values are only stored: setting a key of a context does not apply it, e.g. it does not change the fonts of the calling process.
+ * @remarks @a context must be released with system_settings_context_destroy() by you.
+ * @param[in] name The name of the namespace, path components of letters, digits, '_', '-' and '.' separated by '/', e.g. "user/5001"
+ * @param[out] context The context handle
+ * @return  0 on success, otherwise a negative error value.
+ * @retval  #SYSTEM_SETTINGS_ERROR_NONE Successful
+ * @retval  #SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER Invalid parameter, or a context of the same name exists in the calling process
+ * @retval  #SYSTEM_SETTINGS_ERROR_OUT_OF_MEMORY Out of memory
+ * @see system_settings_context_destroy()
+ */
+int system_settings_context_create(const char *name, system_settings_context_h *context);
+
+/**
+ * @brief Destroys a context created by system_settings_context_create().
+ * @details The values stored in the namespace are kept.
+ * @param[in] context The context handle
+ * @return  0 on success, otherwise a negative error value.
+ * @retval  #SYSTEM_SETTINGS_ERROR_NONE Successful
+ * @retval  #SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER Invalid parameter
+ * @see system_settings_context_create()
+ */
+int system_settings_context_destroy(system_settings_context_h context);
+
+/**
+ * @brief Gets the system settings value of the given key in a context as an integer.
+ * @param[in] context The context handle
+ * @param[in] key The key name of the system settings
+ * @param[out] value The system settings value of the given key in the context
+ * @return  0 on success, otherwise a negative error value.
+ * @retval  #SYSTEM_SETTINGS_ERROR_NONE Successful
+ * @retval  #SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER Invalid parameter
+ * @retval  #SYSTEM_SETTINGS_ERROR_IO_ERROR Internal I/O error
+ */
+int system_settings_context_get_value_int(system_settings_context_h context, system_settings_key_e key, int *value);
+
+/**
+ * @brief Gets the system settings value of the given key in a context as a boolean.
+ * @param[in] context The context handle
+ * @param[in] key The key name of the system settings
+ * @param[out] value The system settings value of the given key in the context
+ * @return  0 on success, otherwise a negative error value.
+ * @retval  #SYSTEM_SETTINGS_ERROR_NONE Successful
+ * @retval  #SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER Invalid parameter
+ * @retval  #SYSTEM_SETTINGS_ERROR_IO_ERROR Internal I/O error
+ */
+int system_settings_context_get_value_bool(system_settings_context_h context, system_settings_key_e key, bool *value);
+
+/**
+ * @brief Gets the system settings value of the given key in a context as a double.
+ * @param[in] context The context handle
+ * @param[in] key The key name of the system settings
+ * @param[out] value The system settings value of the given key in the context
+ * @return  0 on success, otherwise a negative error value.
+ * @retval  #SYSTEM_SETTINGS_ERROR_NONE Successful
+ * @retval  #SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER Invalid parameter
+ * @retval  #SYSTEM_SETTINGS_ERROR_IO_ERROR Internal I/O error
+ */
+int system_settings_context_get_value_double(system_settings_context_h context, system_settings_key_e key, double *value);
+
+/**
+ * @brief Gets the system settings value of the given key in a context as a string.
+ * @remarks @a value must be released with free() by you.
+ * @param[in] context The context handle
+ * @param[in] key The key name of the system settings
+ * @param[out] value The system settings value of the given key in the context
+ * @return  0 on success, otherwise a negative error value.
+ * @retval  #SYSTEM_SETTINGS_ERROR_NONE Successful
+ * @retval  #SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER Invalid parameter
+ * @retval  #SYSTEM_SETTINGS_ERROR_IO_ERROR Internal I/O error
+ */
+int system_settings_context_get_value_string(system_settings_context_h context, system_settings_key_e key, char* *value);
+
+/**
+ * @brief Sets the system settings value of the given key in a context as an integer.
+ * @param[in] context The context handle
+ * @param[in] key The key name of the system settings
+ * @param[in] value The new system settings value of the given key in the context
+ * @return  0 on success, otherwise a negative error value.
+ * @retval  #SYSTEM_SETTINGS_ERROR_NONE Successful
+ * @retval  #SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER Invalid parameter
+ * @retval  #SYSTEM_SETTINGS_ERROR_IO_ERROR Internal I/O error
+ */
+int system_settings_context_set_value_int(system_settings_context_h context, system_settings_key_e key, int value);
+
+/**
+ * @brief Sets the system settings value of the given key in a context as a boolean.
+ * @param[in] context The context handle
+ * @param[in] key The key name of the system settings
+ * @param[in] value The new system settings value of the given key in the context
+ * @return  0 on success, otherwise a negative error value.
+ * @retval  #SYSTEM_SETTINGS_ERROR_NONE Successful
+ * @retval  #SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER Invalid parameter
+ * @retval  #SYSTEM_SETTINGS_ERROR_IO_ERROR Internal I/O error
+ */
+int system_settings_context_set_value_bool(system_settings_context_h context, system_settings_key_e key, bool value);
+
+/**
+ * @brief Sets the system settings value of the given key in a context as a double.
+ * @param[in] context The context handle
+ * @param[in] key The key name of the system settings
+ * @param[in] value The new system settings value of the given key in the context
+ * @return  0 on success, otherwise a negative error value.
+ * @retval  #SYSTEM_SETTINGS_ERROR_NONE Successful
+ * @retval  #SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER Invalid parameter
+ * @retval  #SYSTEM_SETTINGS_ERROR_IO_ERROR Internal I/O error
+ */
+int system_settings_context_set_value_double(system_settings_context_h context, system_settings_key_e key, double value);
+
+/**
+ * @brief Sets the system settings value of the given key in a context as a string.
+ * @param[in] context The context handle
+ * @param[in] key The key name of the system settings
+ * @param[in] value The new system settings value of the given key in the context
+ * @return  0 on success, otherwise a negative error value.
+ * @retval  #SYSTEM_SETTINGS_ERROR_NONE Successful
+ * @retval  #SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER Invalid parameter
+ * @retval  #SYSTEM_SETTINGS_ERROR_IO_ERROR Internal I/O error
+ */
+int system_settings_context_set_value_string(system_settings_context_h context, system_settings_key_e key, const char* value);
+
+/**
+ * @brief Registers a change event callback for the given key of a context.
+ * @details The callback is invoked on the thread which receives the change notification from the backing store.
+ * It replaces the callback registered before for the key in the context, if any.
+ * @param[in] context The context handle
+ * @param[in] key The key name of the system settings
+ * @param[in] callback The callback function to invoke
+ * @param[in] user_data The user data to be passed to the callback function
+ * @return  0 on success, otherwise a negative error value.
+ * @retval  #SYSTEM_SETTINGS_ERROR_NONE Successful
+ * @retval  #SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER Invalid parameter
+ * @retval  #SYSTEM_SETTINGS_ERROR_IO_ERROR Internal I/O error
+ * @post system_settings_context_changed_cb() will be invoked.
+ * @see system_settings_context_unset_changed_cb()
+ */
+int system_settings_context_set_changed_cb(system_settings_context_h context, system_settings_key_e key, system_settings_context_changed_cb callback, void *user_data);
+
+/**
+ * @brief Unregisters the change event callback of the given key of a context.
+ * @param[in] context The context handle
+ * @param[in] key The key name of the system settings
+ * @return  0 on success, otherwise a negative error value.
+ * @retval  #SYSTEM_SETTINGS_ERROR_NONE Successful
+ * @retval  #SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER Invalid parameter
+ * @see system_settings_context_set_changed_cb()
+ */
+int system_settings_context_unset_changed_cb(system_settings_context_h context, system_settings_key_e key);
+
+
 /**
  * @}
  */
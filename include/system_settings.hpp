@@ -0,0 +1,571 @@
+/*
+ * Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef __TIZEN_SYSTEM_SYSTEM_SETTINGS_HPP__
+#define __TIZEN_SYSTEM_SYSTEM_SETTINGS_HPP__
+
+#include <system_settings.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+/**
+ * @file system_settings.hpp
+ * @brief Header-only C++17 interface of the system settings.
+ * @details The value type and the C function of a key are selected at compile time from its key traits:
+ * @code
+ * auto size = tizen::settings::get<tizen::settings::Key::FontSize>();
+ * tizen::settings::String font = tizen::settings::get<tizen::settings::Key::FontType>();
+ * auto subscription = tizen::settings::subscribe<tizen::settings::Key::FontType>([](std::string_view font) { ... });
+ * @endcode
+ */
+
+namespace tizen {
+namespace settings {
+
+/**
+ * @brief The system settings keys
+ */
+enum class Key : int
+{
+	IncomingCallRingtone = SYSTEM_SETTINGS_KEY_INCOMING_CALL_RINGTONE,
+	WallpaperHomeScreen = SYSTEM_SETTINGS_KEY_WALLPAPER_HOME_SCREEN,
+	WallpaperLockScreen = SYSTEM_SETTINGS_KEY_WALLPAPER_LOCK_SCREEN,
+	FontSize = SYSTEM_SETTINGS_KEY_FONT_SIZE,
+	FontType = SYSTEM_SETTINGS_KEY_FONT_TYPE,
+	MotionActivation = SYSTEM_SETTINGS_KEY_MOTION_ACTIVATION,
+};
+
+/**
+ * @brief The groups of related keys
+ */
+enum class Group : int
+{
+	Font = SYSTEM_SETTINGS_GROUP_FONT,
+	Wallpaper = SYSTEM_SETTINGS_GROUP_WALLPAPER,
+	Sound = SYSTEM_SETTINGS_GROUP_SOUND,
+	All = SYSTEM_SETTINGS_GROUP_ALL,
+};
+
+/**
+ * @brief A set of keys, e.g. the keys of a group which changed
+ */
+class KeySet
+{
+public:
+	constexpr KeySet() noexcept = default;
+	KeySet(const system_settings_key_e *keys, int count) noexcept
+	{
+		for (int i = 0; i < count; i++)
+		{
+			insert(static_cast<Key>(keys[i]));
+		}
+	}
+
+	constexpr bool contains(Key key) const noexcept { return (mask_ & bit(key)) != 0; }
+	constexpr bool empty() const noexcept { return mask_ == 0; }
+
+	void insert(Key key) noexcept { mask_ |= bit(key); }
+	void merge(const KeySet &other) noexcept { mask_ |= other.mask_; }
+	void clear() noexcept { mask_ = 0; }
+
+private:
+	/* vendor keys are not in the set */
+	static constexpr unsigned long long bit(Key key) noexcept
+	{
+		return static_cast<unsigned int>(key) < 64 ? 1ull << static_cast<unsigned int>(key) : 0;
+	}
+
+	unsigned long long mask_ = 0;
+};
+
+/**
+ * @brief Thrown by get() and set() with the #system_settings_error_e of the failure
+ */
+class Error : public std::runtime_error
+{
+public:
+	Error(int code, const char *what) : std::runtime_error(what), code_(code) {}
+
+	int code() const noexcept { return code_; }
+
+private:
+	int code_;
+};
+
+/**
+ * @brief A string value of the library, released with free() when destroyed
+ * @details The string is owned as returned by the C API, it is never copied.
+ */
+class String
+{
+public:
+	String() noexcept = default;
+	explicit String(char *value) noexcept : value_(value) {}
+	String(String &&other) noexcept : value_(std::exchange(other.value_, nullptr)) {}
+	String(const String &) = delete;
+	~String() { std::free(value_); }
+
+	String &operator=(String &&other) noexcept
+	{
+		std::free(std::exchange(value_, std::exchange(other.value_, nullptr)));
+		return *this;
+	}
+	String &operator=(const String &) = delete;
+
+	const char *c_str() const noexcept { return value_ != nullptr ? value_ : ""; }
+	std::string_view view() const noexcept { return c_str(); }
+	operator std::string_view() const noexcept { return view(); }
+	explicit operator bool() const noexcept { return value_ != nullptr; }
+
+	/** @brief Gives up the ownership, the string must be released with free() */
+	char *release() noexcept { return std::exchange(value_, nullptr); }
+
+private:
+	char *value_ = nullptr;
+};
+
+/**
+ * @brief Compile-time description of a key
+ * @details value_type is returned by get(), arg_type is taken by set(), and view_type is passed to the
+ * callbacks of subscribe().
+ */
+template <Key K>
+struct key_traits;
+
+namespace detail {
+
+struct string_traits
+{
+	using value_type = String;
+	using arg_type = const char *;
+	using view_type = std::string_view;
+
+	static int get(system_settings_key_e key, value_type &value) noexcept
+	{
+		char *c_value = nullptr;
+		int ret = system_settings_get_value_string(key, &c_value);
+
+		if (ret == SYSTEM_SETTINGS_ERROR_NONE)
+		{
+			value = String(c_value);
+		}
+		return ret;
+	}
+
+	static int set(system_settings_key_e key, arg_type value) noexcept
+	{
+		return system_settings_set_value_string(key, value);
+	}
+
+	static int view(system_settings_value_h value, view_type &out) noexcept
+	{
+		const char *c_value = nullptr;
+		int ret = system_settings_value_get_string(value, &c_value);
+
+		out = c_value != nullptr ? c_value : "";
+		return ret;
+	}
+};
+
+struct bool_traits
+{
+	using value_type = bool;
+	using arg_type = bool;
+	using view_type = bool;
+
+	static int get(system_settings_key_e key, value_type &value) noexcept
+	{
+		return system_settings_get_value_bool(key, &value);
+	}
+
+	static int set(system_settings_key_e key, arg_type value) noexcept
+	{
+		return system_settings_set_value_bool(key, value);
+	}
+
+	static int view(system_settings_value_h value, view_type &out) noexcept
+	{
+		return system_settings_value_get_bool(value, &out);
+	}
+};
+
+struct font_size_traits
+{
+	using value_type = system_settings_font_size_e;
+	using arg_type = system_settings_font_size_e;
+	using view_type = system_settings_font_size_e;
+
+	static int get(system_settings_key_e key, value_type &value) noexcept
+	{
+		int c_value = 0;
+		int ret = system_settings_get_value_int(key, &c_value);
+
+		value = static_cast<value_type>(c_value);
+		return ret;
+	}
+
+	static int set(system_settings_key_e key, arg_type value) noexcept
+	{
+		return system_settings_set_value_int(key, static_cast<int>(value));
+	}
+
+	static int view(system_settings_value_h value, view_type &out) noexcept
+	{
+		int c_value = 0;
+		int ret = system_settings_value_get_int(value, &c_value);
+
+		out = static_cast<view_type>(c_value);
+		return ret;
+	}
+};
+
+} // namespace detail
+
+template <> struct key_traits<Key::IncomingCallRingtone> : detail::string_traits {};
+template <> struct key_traits<Key::WallpaperHomeScreen> : detail::string_traits {};
+template <> struct key_traits<Key::WallpaperLockScreen> : detail::string_traits {};
+template <> struct key_traits<Key::FontSize> : detail::font_size_traits {};
+template <> struct key_traits<Key::FontType> : detail::string_traits {};
+template <> struct key_traits<Key::MotionActivation> : detail::bool_traits {};
+
+template <Key K>
+using value_t = typename key_traits<K>::value_type;
+
+template <Key K>
+constexpr system_settings_key_e c_key = static_cast<system_settings_key_e>(K);
+
+/**
+ * @brief Gets the value of a key without throwing
+ * @return #SYSTEM_SETTINGS_ERROR_NONE on success, otherwise a negative error value
+ */
+template <Key K>
+int try_get(value_t<K> &value) noexcept
+{
+	return key_traits<K>::get(c_key<K>, value);
+}
+
+/**
+ * @brief Gets the value of a key
+ * @exception Error The value could not be read
+ */
+template <Key K>
+value_t<K> get()
+{
+	value_t<K> value{};
+	int ret = try_get<K>(value);
+
+	if (ret != SYSTEM_SETTINGS_ERROR_NONE)
+	{
+		throw Error(ret, "system_settings_get_value failed");
+	}
+	return value;
+}
+
+/**
+ * @brief Sets the value of a key without throwing
+ * @return #SYSTEM_SETTINGS_ERROR_NONE on success, otherwise a negative error value
+ */
+template <Key K>
+int try_set(typename key_traits<K>::arg_type value) noexcept
+{
+	return key_traits<K>::set(c_key<K>, value);
+}
+
+/**
+ * @brief Sets the value of a key
+ * @exception Error The value could not be written
+ */
+template <Key K>
+void set(typename key_traits<K>::arg_type value)
+{
+	int ret = try_set<K>(value);
+
+	if (ret != SYSTEM_SETTINGS_ERROR_NONE)
+	{
+		throw Error(ret, "system_settings_set_value failed");
+	}
+}
+
+namespace detail {
+
+/*
+ * The C library removes change callbacks by function, so all subscriptions of
+ * a key or a group share one registration and are dispatched from here.
+ *
+ * The listeners are an immutable vector replaced on every (un)subscription, so
+ * a notification only takes a reference to the current one: it does not
+ * allocate, and callbacks are invoked without the lock so that they can
+ * subscribe or unsubscribe.
+ */
+template <typename Signature>
+class listener_list
+{
+public:
+	using callback_type = std::function<Signature>;
+	using listener = std::shared_ptr<const callback_type>;
+	using listeners = std::shared_ptr<const std::vector<listener>>;
+
+	/* attach() registers the C callback when the first listener is added */
+	template <typename Attach>
+	int add(const listener &l, Attach &&attach)
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+
+		if (!listeners_)
+		{
+			int ret = attach();
+
+			if (ret != SYSTEM_SETTINGS_ERROR_NONE)
+			{
+				return ret;
+			}
+		}
+
+		auto next = listeners_ ? std::make_shared<std::vector<listener>>(*listeners_) : std::make_shared<std::vector<listener>>();
+		next->push_back(l);
+		listeners_ = std::move(next);
+
+		return SYSTEM_SETTINGS_ERROR_NONE;
+	}
+
+	/* detach() removes the C callback with the last listener */
+	template <typename Detach>
+	void remove(const listener &l, Detach &&detach) noexcept
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+
+		if (!listeners_ || std::find(listeners_->begin(), listeners_->end(), l) == listeners_->end())
+		{
+			return;
+		}
+
+		if (listeners_->size() == 1)
+		{
+			detach();
+			listeners_.reset();
+			return;
+		}
+
+		auto next = std::make_shared<std::vector<listener>>();
+		next->reserve(listeners_->size() - 1);
+		std::remove_copy(listeners_->begin(), listeners_->end(), std::back_inserter(*next), l);
+		listeners_ = std::move(next);
+	}
+
+	listeners get() const
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		return listeners_;
+	}
+
+private:
+	mutable std::mutex mutex_;
+	listeners listeners_;
+};
+
+template <Key K>
+class dispatcher
+{
+public:
+	using view_type = typename key_traits<K>::view_type;
+	using list_type = listener_list<void(view_type)>;
+
+	static dispatcher &instance()
+	{
+		static dispatcher *self = new dispatcher();	/* callbacks may outlive static destruction */
+		return *self;
+	}
+
+	int add(const typename list_type::listener &l)
+	{
+		return list_.add(l, [this]() { return system_settings_add_value_changed_cb(c_key<K>, &dispatcher::changed_cb, this); });
+	}
+
+	void remove(const typename list_type::listener &l) noexcept
+	{
+		list_.remove(l, []() { system_settings_remove_value_changed_cb(c_key<K>, &dispatcher::changed_cb); });
+	}
+
+private:
+	static void changed_cb(system_settings_key_e, system_settings_value_h value, void *user_data)
+	{
+		auto listeners = static_cast<dispatcher *>(user_data)->list_.get();
+		view_type view{};
+
+		if (!listeners || key_traits<K>::view(value, view) != SYSTEM_SETTINGS_ERROR_NONE)
+		{
+			return;
+		}
+
+		for (const auto &l : *listeners)
+		{
+			(*l)(view);
+		}
+	}
+
+	list_type list_;
+};
+
+template <Group G>
+class group_dispatcher
+{
+public:
+	using list_type = listener_list<void(const KeySet &)>;
+
+	static group_dispatcher &instance()
+	{
+		static group_dispatcher *self = new group_dispatcher();	/* callbacks may outlive static destruction */
+		return *self;
+	}
+
+	int add(const typename list_type::listener &l)
+	{
+		return list_.add(l, [this]() {
+			return system_settings_add_group_changed_cb(c_group, &group_dispatcher::changed_cb, this);
+		});
+	}
+
+	void remove(const typename list_type::listener &l) noexcept
+	{
+		list_.remove(l, []() { system_settings_remove_group_changed_cb(c_group, &group_dispatcher::changed_cb); });
+	}
+
+private:
+	static constexpr system_settings_group_e c_group = static_cast<system_settings_group_e>(G);
+
+	static void changed_cb(system_settings_group_e, const system_settings_key_e *keys, int count, void *user_data)
+	{
+		auto listeners = static_cast<group_dispatcher *>(user_data)->list_.get();
+		KeySet changed(keys, count);
+
+		if (!listeners)
+		{
+			return;
+		}
+
+		for (const auto &l : *listeners)
+		{
+			(*l)(changed);
+		}
+	}
+
+	list_type list_;
+};
+
+} // namespace detail
+
+/**
+ * @brief A change callback registration, removed when destroyed
+ */
+class Subscription
+{
+public:
+	Subscription() noexcept = default;
+	Subscription(Subscription &&other) noexcept : unsubscribe_(std::exchange(other.unsubscribe_, nullptr)) {}
+	Subscription(const Subscription &) = delete;
+	~Subscription() { reset(); }
+
+	Subscription &operator=(Subscription &&other) noexcept
+	{
+		if (this != &other)
+		{
+			reset();
+			unsubscribe_ = std::exchange(other.unsubscribe_, nullptr);
+		}
+		return *this;
+	}
+	Subscription &operator=(const Subscription &) = delete;
+
+	explicit operator bool() const noexcept { return static_cast<bool>(unsubscribe_); }
+
+	/** @brief Removes the callback, it is not invoked once this returns, unless it is being invoked */
+	void reset() noexcept
+	{
+		if (unsubscribe_)
+		{
+			std::exchange(unsubscribe_, nullptr)();
+		}
+	}
+
+private:
+	template <Key K, typename F>
+	friend Subscription subscribe(F &&callback);
+	template <Group G, typename F>
+	friend Subscription subscribe(F &&callback);
+
+	explicit Subscription(std::function<void()> unsubscribe) : unsubscribe_(std::move(unsubscribe)) {}
+
+	std::function<void()> unsubscribe_;
+};
+
+/**
+ * @brief Invokes @a callback with the new value of a key whenever it changes
+ * @details The callback takes key_traits<K>::view_type, strings are passed as a std::string_view
+ * valid during the call. It is invoked as the callbacks of system_settings_add_value_changed_cb().
+ * @exception Error The key could not be watched
+ */
+template <Key K, typename F>
+Subscription subscribe(F &&callback)
+{
+	using dispatcher = detail::dispatcher<K>;
+
+	auto l = std::make_shared<const typename dispatcher::list_type::callback_type>(std::forward<F>(callback));
+	int ret = dispatcher::instance().add(l);
+
+	if (ret != SYSTEM_SETTINGS_ERROR_NONE)
+	{
+		throw Error(ret, "system_settings_add_value_changed_cb failed");
+	}
+
+	return Subscription([l]() { dispatcher::instance().remove(l); });
+}
+
+/**
+ * @brief Invokes @a callback with the set of keys of a group which changed
+ * @details The callback takes a const KeySet &. It is invoked as the callbacks of system_settings_add_group_changed_cb().
+ * @exception Error The keys could not be watched
+ */
+template <Group G, typename F>
+Subscription subscribe(F &&callback)
+{
+	using dispatcher = detail::group_dispatcher<G>;
+
+	auto l = std::make_shared<const typename dispatcher::list_type::callback_type>(std::forward<F>(callback));
+	int ret = dispatcher::instance().add(l);
+
+	if (ret != SYSTEM_SETTINGS_ERROR_NONE)
+	{
+		throw Error(ret, "system_settings_add_group_changed_cb failed");
+	}
+
+	return Subscription([l]() { dispatcher::instance().remove(l); });
+}
+
+} // namespace settings
+} // namespace tizen
+
+#endif /* __TIZEN_SYSTEM_SYSTEM_SETTINGS_HPP__ */
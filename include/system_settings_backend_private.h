@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef __TIZEN_SYSTEM_SETTING_BACKEND_PRIVATE_H__
+#define __TIZEN_SYSTEM_SETTING_BACKEND_PRIVATE_H__
+
+#include <system_settings_private.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/*
+ * Storage backend of the system_setting_vconf_* functions.
+ *
+ * Settings are stored under their vconf key name whatever the backend. vconf
+ * is the default; the in-memory backend stands in for it in tools and tests.
+ * The backend must be selected before any key is read, written or watched.
+ *
+ * All operations return 0 on success and -1 on failure. get_value returns a
+ * newly allocated string for STRING keys.
+ *
+ * compare_and_set writes value only if the key holds expected, atomically with
+ * respect to the other compare_and_set writers, and otherwise returns
+ * SYSTEM_SETTING_BACKEND_MISMATCH and the stored value in current, which may be
+ * NULL. A key which holds no value is a mismatch too, current is then zeroed.
+ * Backends without it are emulated with get_value and set_value under a lock
+ * of the process.
+ */
+typedef struct {
+	const char *name;
+
+	int (*get_value)(const char *vconf_key, system_setting_data_type_e data_type, system_setting_value_s *value);
+	int (*set_value)(const char *vconf_key, const system_setting_value_s *value);
+	int (*compare_and_set)(const char *vconf_key, const system_setting_value_s *expected, const system_setting_value_s *value,
+		system_setting_value_s *current);
+
+	/* changes of a watched key are reported with system_setting_backend_changed() */
+	int (*watch)(const char *vconf_key, system_settings_key_e key);
+	int (*unwatch)(const char *vconf_key);
+} system_setting_backend_s;
+
+#define SYSTEM_SETTING_BACKEND_MISMATCH 1
+
+extern const system_setting_backend_s system_setting_backend_vconf;
+extern const system_setting_backend_s system_setting_backend_memory;
+
+// NULL restores the vconf backend
+void system_setting_backend_set(const system_setting_backend_s *backend);
+const system_setting_backend_s *system_setting_backend_get(void);
+
+// value is the new value of the key, or NULL if the backend does not know it
+void system_setting_backend_changed(system_settings_key_e key, const system_setting_value_s *value);
+
+// in-memory backend
+typedef void (*system_setting_backend_notify_cb)(system_settings_key_e key, const system_setting_value_s *value);
+
+void system_setting_backend_memory_reset(void);
+// changes of watched keys are passed to notify, NULL restores system_setting_backend_changed()
+void system_setting_backend_memory_set_notify(system_setting_backend_notify_cb notify);
+system_setting_backend_notify_cb system_setting_backend_memory_get_notify(void);
+
+
+/*
+ * Fault injecting backend. It stores values in the in-memory backend and
+ * delays, fails or late-notifies operations as configured per vconf key.
+ */
+extern const system_setting_backend_s system_setting_backend_fault;
+
+typedef enum {
+	SYSTEM_SETTING_FAULT_LATENCY_CONSTANT,		/* latency_us */
+	SYSTEM_SETTING_FAULT_LATENCY_UNIFORM,		/* uniform in [0, latency_us] */
+	SYSTEM_SETTING_FAULT_LATENCY_EXPONENTIAL,	/* exponential of mean latency_us */
+} system_setting_fault_latency_e;
+
+typedef struct {
+	system_setting_fault_latency_e latency_distribution;
+	unsigned int latency_us;					/* added to every read and write */
+	double stall_rate;							/* probability of an additional stall */
+	unsigned int stall_us;
+	double read_error_rate;						/* probability that a read fails */
+	double write_error_rate;					/* probability that a write fails */
+	unsigned int notify_delay_us;				/* delay of the change notifications */
+} system_setting_fault_s;
+
+// vconf_key NULL sets the faults of the keys without faults of their own, fault NULL removes them
+void system_setting_backend_fault_set(const char *vconf_key, const system_setting_fault_s *fault);
+// removes every fault
+void system_setting_backend_fault_reset(void);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __TIZEN_SYSTEM_SETTING_BACKEND_PRIVATE_H__ */
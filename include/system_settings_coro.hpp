@@ -0,0 +1,328 @@
+/*
+ * Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef __TIZEN_SYSTEM_SYSTEM_SETTINGS_CORO_HPP__
+#define __TIZEN_SYSTEM_SYSTEM_SETTINGS_CORO_HPP__
+
+#if __cplusplus < 202002L
+#error "system_settings_coro.hpp requires C++20"
+#endif
+
+#include <system_settings.hpp>
+
+#include <glib.h>
+
+#include <coroutine>
+#include <type_traits>
+
+/**
+ * @file system_settings_coro.hpp
+ * @brief Change streams of the system settings for C++20 coroutines.
+ * @details A stream is bound to a GMainContext, the thread-default context of the thread which creates it
+ * by default, and resumes the coroutines awaiting it from that context:
+ * @code
+ * tizen::settings::ChangeStream<tizen::settings::Key::FontType> fonts;
+ *
+ * for (;;) {
+ *     std::string_view font = co_await fonts;
+ *     ...
+ * }
+ * @endcode
+ * Changes which arrive before the stream is awaited again are merged: a key stream keeps the latest value only,
+ * and a group stream the set of keys which changed, so a stream never holds more than one pending change.
+ */
+
+namespace tizen {
+namespace settings {
+
+namespace detail {
+
+/* value kept by the stream of a key, strings are copied into a buffer which keeps its capacity */
+template <typename View>
+struct stream_buffer
+{
+	using type = View;
+
+	static void assign(type &buffer, const View &value) noexcept { buffer = value; }
+	static View view(const type &buffer) noexcept { return buffer; }
+	static void clear(type &) noexcept {}
+};
+
+template <>
+struct stream_buffer<std::string_view>
+{
+	using type = std::string;
+
+	static void assign(type &buffer, std::string_view value) { buffer.assign(value.data(), value.size()); }
+	static std::string_view view(const type &buffer) noexcept { return buffer; }
+	static void clear(type &buffer) noexcept { buffer.clear(); }
+};
+
+template <>
+struct stream_buffer<KeySet>
+{
+	using type = KeySet;
+
+	static void assign(type &buffer, const KeySet &value) noexcept { buffer.merge(value); }
+	static const KeySet &view(const type &buffer) noexcept { return buffer; }
+	static void clear(type &buffer) noexcept { buffer.clear(); }
+};
+
+/*
+ * State shared by a stream and its listener. Changes are merged into pending_
+ * on the notifying thread; the waiting coroutine is resumed by a GSource of the
+ * stream, which is woken with g_source_set_ready_time() so that no event
+ * allocates. pending_ and current_ are swapped when a change is consumed, so
+ * the string buffers are reused.
+ */
+template <typename View>
+class stream_state
+{
+public:
+	using buffer = stream_buffer<View>;
+
+	explicit stream_state(GMainContext *context)
+	{
+		static GSourceFuncs funcs = { nullptr, nullptr, &stream_state::dispatch, nullptr, nullptr, nullptr };
+
+		source_ = reinterpret_cast<wake_source *>(g_source_new(&funcs, sizeof(wake_source)));
+		source_->state = this;
+		g_source_attach(&source_->base, context);
+	}
+
+	stream_state(const stream_state &) = delete;
+	stream_state &operator=(const stream_state &) = delete;
+
+	~stream_state()
+	{
+		g_source_unref(&source_->base);
+	}
+
+	/* notifying thread */
+	void post(const View &value)
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+
+		if (closed_)
+		{
+			return;
+		}
+
+		buffer::assign(pending_, value);
+
+		if (has_pending_)
+		{
+			merged_++;
+		}
+		has_pending_ = true;
+
+		if (waiter_)
+		{
+			g_source_set_ready_time(&source_->base, 0);
+		}
+	}
+
+	/* owning thread, the stream must not be awaited any more */
+	void close() noexcept
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+
+		closed_ = true;
+		waiter_ = nullptr;
+		g_source_destroy(&source_->base);
+	}
+
+	bool ready()
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		return has_pending_;
+	}
+
+	/* returns false when a change arrived meanwhile and the coroutine goes on */
+	bool suspend(std::coroutine_handle<> waiter)
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+
+		if (has_pending_)
+		{
+			return false;
+		}
+
+		waiter_ = waiter;
+		return true;
+	}
+
+	/* the returned value is valid until the stream is awaited again */
+	decltype(auto) consume()
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+
+		std::swap(pending_, current_);
+		buffer::clear(pending_);
+		has_pending_ = false;
+
+		return buffer::view(current_);
+	}
+
+	unsigned long merged() const
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		return merged_;
+	}
+
+private:
+	struct wake_source
+	{
+		GSource base;
+		stream_state *state;
+	};
+
+	static gboolean dispatch(GSource *source, GSourceFunc, gpointer)
+	{
+		stream_state *self = reinterpret_cast<wake_source *>(source)->state;
+		std::coroutine_handle<> waiter;
+
+		{
+			std::lock_guard<std::mutex> lock(self->mutex_);
+
+			g_source_set_ready_time(source, -1);
+			waiter = std::exchange(self->waiter_, nullptr);
+		}
+
+		if (waiter)
+		{
+			waiter.resume();
+		}
+
+		return G_SOURCE_CONTINUE;
+	}
+
+	mutable std::mutex mutex_;
+	wake_source *source_;
+	typename buffer::type pending_{};
+	typename buffer::type current_{};
+	bool has_pending_ = false;
+	bool closed_ = false;
+	unsigned long merged_ = 0;
+	std::coroutine_handle<> waiter_;
+};
+
+template <typename View>
+class stream_awaiter
+{
+public:
+	explicit stream_awaiter(stream_state<View> &state) noexcept : state_(state) {}
+
+	bool await_ready() { return state_.ready(); }
+	bool await_suspend(std::coroutine_handle<> waiter) { return state_.suspend(waiter); }
+	decltype(auto) await_resume() { return state_.consume(); }
+
+private:
+	stream_state<View> &state_;
+};
+
+template <typename View, typename Subscribe>
+class change_stream
+{
+public:
+	explicit change_stream(GMainContext *context, Subscribe subscribe)
+	{
+		GMainContext *stream_context = context != nullptr ? g_main_context_ref(context) : g_main_context_ref_thread_default();
+
+		state_ = std::make_shared<stream_state<View>>(stream_context);
+		g_main_context_unref(stream_context);
+
+		subscription_ = subscribe([state = state_](const View &value) { state->post(value); });
+	}
+
+	change_stream(change_stream &&) noexcept = default;
+	change_stream &operator=(change_stream &&) = delete;
+
+	~change_stream()
+	{
+		subscription_.reset();
+
+		if (state_)
+		{
+			state_->close();
+		}
+	}
+
+	/** @brief Waits for the next change, the result is valid until the stream is awaited again */
+	stream_awaiter<View> operator co_await() noexcept { return stream_awaiter<View>(*state_); }
+
+	/** @brief The number of changes merged into a later one since the stream was created */
+	unsigned long merged() const { return state_->merged(); }
+
+private:
+	std::shared_ptr<stream_state<View>> state_;
+	Subscription subscription_;
+};
+
+template <Key K>
+struct key_subscriber
+{
+	template <typename F>
+	Subscription operator()(F &&callback) const { return subscribe<K>(std::forward<F>(callback)); }
+};
+
+template <Group G>
+struct group_subscriber
+{
+	template <typename F>
+	Subscription operator()(F &&callback) const { return subscribe<G>(std::forward<F>(callback)); }
+};
+
+} // namespace detail
+
+/**
+ * @brief The changes of a key, co_await yields its latest value as key_traits<K>::view_type
+ * @details Strings are yielded as a std::string_view valid until the stream is awaited again.
+ * @remarks The stream must outlive the coroutines awaiting it, and be destroyed on the thread of its context.
+ * @exception Error The key could not be watched
+ */
+template <Key K>
+class ChangeStream : public detail::change_stream<typename key_traits<K>::view_type, detail::key_subscriber<K>>
+{
+public:
+	/** @param[in] context The context which resumes the awaiting coroutines, nullptr for the thread-default context */
+	explicit ChangeStream(GMainContext *context = nullptr)
+		: detail::change_stream<typename key_traits<K>::view_type, detail::key_subscriber<K>>(context, detail::key_subscriber<K>())
+	{
+	}
+};
+
+/**
+ * @brief The changes of the keys of a group, co_await yields the const KeySet & of the keys changed since the last one
+ * @remarks The stream must outlive the coroutines awaiting it, and be destroyed on the thread of its context.
+ * @exception Error The keys could not be watched
+ */
+template <Group G>
+class GroupChangeStream : public detail::change_stream<KeySet, detail::group_subscriber<G>>
+{
+public:
+	/** @param[in] context The context which resumes the awaiting coroutines, nullptr for the thread-default context */
+	explicit GroupChangeStream(GMainContext *context = nullptr)
+		: detail::change_stream<KeySet, detail::group_subscriber<G>>(context, detail::group_subscriber<G>())
+	{
+	}
+};
+
+} // namespace settings
+} // namespace tizen
+
+#endif /* __TIZEN_SYSTEM_SYSTEM_SETTINGS_CORO_HPP__ */
@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef __TIZEN_SYSTEM_SETTING_FONT_INDEX_PRIVATE_H__
+#define __TIZEN_SYSTEM_SETTING_FONT_INDEX_PRIVATE_H__
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/*
+ * Index of the installed font families.
+ *
+ * The file is built from fontconfig by the first process that finds it missing
+ * or stale, and mapped read-only by the others. It is laid out in native byte
+ * order:
+ *
+ *   header | stamp[stamp_count] | family[family_count] | bucket[bucket_count] | string pool
+ *
+ * stamp[i] is the modification time of a font directory or configuration file
+ * when the index was built. The index is stale as soon as one of them differs.
+ *
+ * bucket[] is an open addressing hash table of family indices plus one, 0 for
+ * an empty bucket. bucket_count is a power of two. Names are hashed and
+ * compared ignoring case and blanks, as fontconfig matches families.
+ */
+#define SYSTEM_SETTING_FONT_INDEX_FILE "/opt/var/cache/system-settings/fonts.index"
+#define SYSTEM_SETTING_FONT_INDEX_MAGIC 0x49465353	/* "SSFI" */
+#define SYSTEM_SETTING_FONT_INDEX_VERSION 2
+
+#define SYSTEM_SETTING_FONT_INDEX_PRIMARY 0x1		/* first family name of a font */
+#define SYSTEM_SETTING_FONT_INDEX_LOCALIZED 0x2		/* other family name of a font */
+#define SYSTEM_SETTING_FONT_INDEX_ALIAS 0x4			/* <alias> of the configuration, e.g. "Sans" */
+
+typedef struct {
+	uint32_t magic;
+	uint32_t version;
+	uint32_t stamp_count;
+	uint32_t family_count;
+	uint32_t bucket_count;
+	uint32_t strings_offset;	/* offset of the string pool from the start of the file */
+	uint32_t strings_size;		/* size of the string pool including the last NUL */
+	uint32_t reserved;			/* keeps the stamps 8 byte aligned */
+} system_setting_font_index_header_s;
+
+typedef struct {
+	uint32_t path;				/* offset into the string pool */
+	uint32_t reserved;
+	int64_t mtime_sec;
+	int64_t mtime_nsec;
+} system_setting_font_index_stamp_s;
+
+typedef struct {
+	uint32_t name;				/* offset into the string pool */
+	uint32_t hash;
+	uint32_t flags;
+} system_setting_font_index_family_s;
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __TIZEN_SYSTEM_SETTING_FONT_INDEX_PRIVATE_H__ */
@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef __TIZEN_SYSTEM_SETTING_KEY_NAME_PRIVATE_H__
+#define __TIZEN_SYSTEM_SETTING_KEY_NAME_PRIVATE_H__
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/*
+ * Perfect hash of the key names.
+ *
+ * The name of a key is its name in the key schema, e.g. "font_size".
+ * system-settings-key-hash-generator runs at build time and searches a seed
+ * for which system_setting_key_name_hash() maps every name of the schema to a
+ * slot of its own. It writes SYSTEM_SETTING_KEY_NAME_TABLE_FILE:
+ *
+ *   SYSTEM_SETTING_KEY_NAME_SEED      the seed
+ *   SYSTEM_SETTING_KEY_NAME_SLOTS     number of slots, a power of two
+ *   SYSTEM_SETTING_KEY_NAME_MAX       length of the longest name
+ *   system_setting_key_name_slots[]   { length, key, name } of each slot
+ *
+ * A lookup hashes the name once and compares it with the single name of its
+ * slot. Empty slots have length 0. Names are stored in the table rather than
+ * pointed to, so the table needs no relocation.
+ */
+#define SYSTEM_SETTING_KEY_NAME_TABLE_FILE "system_settings_key_name_table.h"
+
+/* FNV-1a from the seed, the length of name is returned in length */
+static inline unsigned int system_setting_key_name_hash(const char *name, unsigned int seed, size_t *length)
+{
+	const unsigned char *p = (const unsigned char*)name;
+	unsigned int hash = 2166136261u ^ seed;
+
+	while (*p != '\0')
+	{
+		hash = (hash ^ *p++) * 16777619u;
+	}
+
+	*length = (size_t)((const char*)p - name);
+
+	return hash ^ (hash >> 15);
+}
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __TIZEN_SYSTEM_SETTING_KEY_NAME_PRIVATE_H__ */
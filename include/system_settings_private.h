@@ -18,13 +18,13 @@
 #ifndef __TIZEN_SYSTEM_SETTING_PRIVATE_H__
 #define __TIZEN_SYSTEM_SETTING_PRIVATE_H__
 
+#include <system_settings_schema_private.h>
+
 #ifdef __cplusplus
 extern "C"
 {
 #endif
 
-#define VCONFKEY_SETAPPL_ACCESSIBILITY_FONT_NAME  "db/setting/accessibility/font_name"
-
 typedef enum {
 	SYSTEM_SETTING_DATA_TYPE_STRING,
 	SYSTEM_SETTING_DATA_TYPE_INT,
@@ -36,20 +36,42 @@ typedef enum {
 typedef int (*system_setting_get_value_cb) (system_settings_key_e key, system_setting_data_type_e data_type, void** value);
 typedef int (*system_setting_set_value_cb) (system_settings_key_e key, system_setting_data_type_e data_type, void* value);
 
-typedef int (*system_setting_set_changed_callback_cb)(system_settings_key_e key, system_settings_changed_cb callback, void *user_data);
-typedef int (*system_setting_unset_changed_callback_cb)(system_settings_key_e key);
+
+typedef struct system_settings_value_s {
+	system_setting_data_type_e data_type;
+	union {
+		char *s;
+		int i;
+		double d;
+		bool b;
+	} value;
+} system_setting_value_s;
 
 
 typedef struct {
 	system_settings_key_e key;										/* key */
 	system_setting_data_type_e data_type;
-	system_setting_get_value_cb get_value_cb;						/* get value */
-	system_setting_set_value_cb set_value_cb;						/* set value */
+	const char *vconf_key;											/* backing vconf key */
+	int min;														/* valid range of INT keys */
+	int max;
 
-	system_setting_set_changed_callback_cb set_changed_cb;
-	system_setting_unset_changed_callback_cb unset_changed_cb ;
+	system_setting_get_value_cb get_value_cb;						/* get value, overrides vconf_key */
+	system_setting_set_value_cb check_value_cb;						/* called before vconf_key is written */
+	system_setting_set_value_cb apply_value_cb;						/* called after vconf_key is written */
+	unsigned int groups;											/* SYSTEM_SETTING_GROUP_MASK() of the key groups */
 
 	system_settings_changed_cb changed_cb;							/* registered by user application */
+	void *user_data;
+
+	int notify_refcount;											/* users of the vconf subscription */
+
+	void *value_listeners;											/* GList of value changed callbacks */
+
+	system_setting_value_s last_value;								/* last value notified, for the changed filter */
+	bool has_last_value;
+
+	void *context;													/* GMainContext of the registering thread */
+	struct system_setting_dispatch_queue_s *dispatch_queue;			/* notifications not delivered yet */
 } system_setting_s;
 
 typedef system_setting_s* system_setting_h;
@@ -57,54 +79,152 @@ typedef system_setting_s* system_setting_h;
 
 int system_settings_get_item(system_settings_key_e key, system_setting_h *item);
 
+int system_settings_get_value(system_settings_key_e key, system_setting_data_type_e data_type, void** value);
+int system_settings_set_value(system_settings_key_e key, system_setting_data_type_e data_type, void* value);
+// system_settings_set_value() without the rate limit
+int system_setting_set_value_unlimited(system_settings_key_e key, system_setting_data_type_e data_type, void* value);
+// SYSTEM_SETTINGS_ERROR_TRY_AGAIN and the stored value in current, if not NULL, when the key does not hold expected
+int system_settings_compare_and_set_value(system_settings_key_e key, system_setting_data_type_e data_type, void* expected, void* value, void** current);
+
+// value
+int system_setting_value_get(system_settings_key_e key, system_setting_value_s *value);
+void system_setting_value_copy(system_setting_value_s *dst, const system_setting_value_s *src);
+void system_setting_value_clear(system_setting_value_s *value);
+bool system_setting_value_equal(const system_setting_value_s *a, const system_setting_value_s *b);
+// wraps the value pointed to by raw, as passed to system_settings_set_value()
+int system_setting_value_init(system_setting_value_s *value, system_setting_data_type_e data_type, void *raw);
+// stores value to raw, as returned by system_settings_get_value()
+void system_setting_value_output(const system_setting_value_s *value, void **raw);
+
+// notification, one vconf subscription per backing key shared by all users
+int system_setting_notify_ref(system_setting_h item);
+void system_setting_notify_unref(system_setting_h item);
+// the GMainContext notifications of item are delivered on, NULL for the default one, to be released with g_main_context_unref()
+void *system_setting_notify_context_ref(system_setting_h item);
+// value is the new value carried by the notification, or NULL if unknown
+void system_setting_notify_changed(system_settings_key_e key, const system_setting_value_s *value);
+void system_setting_notify_deliver(system_settings_key_e key, const system_setting_value_s *value);
+
+// dispatcher, returns non-zero when the notification is queued for delivery
+int system_setting_dispatch(system_setting_h item, const system_setting_value_s *value);
+
+// groups
+void system_setting_group_notify(system_settings_key_e key);
+
+// statistics
+#define SYSTEM_SETTING_STAT_COUNT (SYSTEM_SETTINGS_STAT_WRITES_CONFLICTED + 1)
+
+void system_setting_stat_inc(system_settings_stat_e stat);
+
+// rate limit, see system_setting_rate_limit_load_env() for the format of the variable
+#define SYSTEM_SETTING_RATE_LIMIT_ENV "SYSTEM_SETTINGS_RATE_LIMIT"
+#define SYSTEM_SETTING_RATE_LIMIT_DEFERRED 1
+
+// SYSTEM_SETTINGS_ERROR_NONE to write now, SYSTEM_SETTING_RATE_LIMIT_DEFERRED if the value is written later,
+// value NULL for writes which cannot be deferred, they are rejected instead
+int system_setting_rate_limit_acquire(system_settings_key_e key, system_setting_data_type_e data_type, void *value);
+
+// snapshot
+void system_setting_snapshot_invalidate(system_settings_key_e key);
+
+// contexts, a watch of a context key is reported under a watch key which identifies the context
+#define SYSTEM_SETTING_CONTEXT_WATCH_FLAG 0x40000000
+#define SYSTEM_SETTING_CONTEXT_ID_MAX 0x3fffff
+#define SYSTEM_SETTING_CONTEXT_WATCH_KEY(id, key) (SYSTEM_SETTING_CONTEXT_WATCH_FLAG | ((id) << 8) | (key))
+#define SYSTEM_SETTING_CONTEXT_WATCH_ID(watch_key) (((watch_key) & ~SYSTEM_SETTING_CONTEXT_WATCH_FLAG) >> 8)
+#define SYSTEM_SETTING_CONTEXT_WATCH_ITEM(watch_key) ((watch_key) & 0xff)
+
+void system_setting_context_changed(system_settings_key_e watch_key, const system_setting_value_s *value);
+
+// negative cache of failed reads
+int system_setting_backoff_check(system_settings_key_e key);
+void system_setting_backoff_failed(system_settings_key_e key, int error);
+void system_setting_backoff_reset(system_settings_key_e key);
+
 
 // get
 int system_setting_vconf_get_value_int(const char *vconf_key, int *value);
 int system_setting_vconf_get_value_bool(const char *vconf_key, bool *value);
 int system_setting_vconf_get_value_double(const char *vconf_key, double *value);
 int system_setting_vconf_get_value_string(const char *vconf_key, char **value);
+int system_setting_vconf_get_value(const char *vconf_key, system_setting_data_type_e data_type, void **value);
 
 // set
 int system_setting_vconf_set_value_int(const char *vconf_key, int value);
 int system_setting_vconf_set_value_bool(const char *vconf_key, bool value);
 int system_setting_vconf_set_value_double(const char *vconf_key, double value);
 int system_setting_vconf_set_value_string(const char *vconf_key, char *value);
+int system_setting_vconf_set_value(const char *vconf_key, system_setting_data_type_e data_type, void *value);
+
+// compare-and-set, 0 when written, SYSTEM_SETTING_BACKEND_MISMATCH when vconf_key does not hold expected, -1 on failure
+int system_setting_vconf_compare_and_set_value(const char *vconf_key, system_setting_data_type_e data_type, void *expected, void *value, void **current);
+// serializes compare-and-set writers, also between processes with the vconf backend, -1 when the lock is not free in time
+int system_setting_vconf_cas_lock(void);
+void system_setting_vconf_cas_unlock(void);
 
 
-int system_setting_vconf_set_changed_cb(const char *vconf_key, system_settings_key_e system_setting_key, int slot);
-int system_setting_vconf_unset_changed_cb(const char *vconf_key, int slot);
+int system_setting_vconf_set_changed_cb(const char *vconf_key, system_settings_key_e system_setting_key);
+int system_setting_vconf_unset_changed_cb(const char *vconf_key);
+
+// hooks referenced by the key schema
+int system_setting_check_incoming_call_ringtone(system_settings_key_e key, system_setting_data_type_e data_type, void* value);
+int system_setting_check_wallpaper(system_settings_key_e key, system_setting_data_type_e data_type, void* value);
+int system_setting_check_font_type(system_settings_key_e key, system_setting_data_type_e data_type, void* value);
 
-int system_setting_get_incoming_call_ringtone(system_settings_key_e key, system_setting_data_type_e data_type, void** value);
-int system_setting_get_wallpaper_home_screen(system_settings_key_e key, system_setting_data_type_e data_type, void** value);
-int system_setting_get_wallpaper_lock_screen(system_settings_key_e key, system_setting_data_type_e data_type, void** value);
-int system_setting_get_font_size(system_settings_key_e key, system_setting_data_type_e data_type, void** value);
 int system_setting_get_font_type(system_settings_key_e key, system_setting_data_type_e data_type, void** value);
-int system_setting_get_motion_activation(system_settings_key_e key, system_setting_data_type_e data_type, void** value);
 
-int system_setting_set_incoming_call_ringtone(system_settings_key_e key, system_setting_data_type_e data_type, void* value);
-int system_setting_set_wallpaper_home_screen(system_settings_key_e key, system_setting_data_type_e data_type, void* value);
-int system_setting_set_wallpaper_lock_screen(system_settings_key_e key, system_setting_data_type_e data_type, void* value);
-int system_setting_set_font_size(system_settings_key_e key, system_setting_data_type_e data_type, void* value);
-int system_setting_set_font_type(system_settings_key_e key, system_setting_data_type_e data_type, void* value);
-int system_setting_set_motion_activation(system_settings_key_e key, system_setting_data_type_e data_type, void* value);
+int system_setting_apply_font_size(system_settings_key_e key, system_setting_data_type_e data_type, void* value);
+int system_setting_apply_font_type(system_settings_key_e key, system_setting_data_type_e data_type, void* value);
 
-int system_setting_set_changed_callback_incoming_call_ringtone(system_settings_key_e key, system_settings_changed_cb callback, void *user_data);
-int system_setting_unset_changed_callback_incoming_call_ringtone(system_settings_key_e key);
+// dominant colour and accents of pixels in ARGB32, stride in bytes
+int system_setting_palette_compute(const unsigned int *pixels, int width, int height, int stride, system_settings_palette_s *palette);
 
-int system_setting_set_changed_callback_wallpaper_home_screen(system_settings_key_e key, system_settings_changed_cb callback, void *user_data);
-int system_setting_unset_changed_callback_wallpaper_home_screen(system_settings_key_e key);
+// font pipeline profiling, stages of a font size or font type change
+typedef enum {
+	SYSTEM_SETTING_FONT_STAGE_PARSE,			/* read the current font from the fontconfig file */
+	SYSTEM_SETTING_FONT_STAGE_OVERLAY_SET,		/* elm_config_font_overlay_set() of every text class */
+	SYSTEM_SETTING_FONT_STAGE_APPLY,			/* elm_config_font_overlay_apply() */
+	SYSTEM_SETTING_FONT_STAGE_FLUSH,			/* elm_config_all_flush() */
+	SYSTEM_SETTING_FONT_STAGE_SAVE,				/* elm_config_save() */
+	SYSTEM_SETTING_FONT_STAGE_NOTIFY,			/* font change notification */
+	SYSTEM_SETTING_FONT_STAGE_COUNT,
+} system_setting_font_stage_e;
+
+typedef void (*system_setting_font_stage_cb)(system_setting_font_stage_e stage, unsigned long long ns, void *user_data);
+typedef void (*system_setting_font_notifier_cb)(void);
+
+// stages are timed only while a callback is set
+void system_setting_font_set_stage_cb(system_setting_font_stage_cb callback, void *user_data);
+// replaces system_setting_font_notify(), NULL restores it
+void system_setting_font_set_notifier(system_setting_font_notifier_cb notifier);
+// resolves the family and reads its files ahead on a background thread
+void system_setting_font_prewarm(const char *font_name);
 
-int system_setting_set_changed_callback_wallpaper_lock_screen(system_settings_key_e key, system_settings_changed_cb callback, void *user_data);
-int system_setting_unset_changed_callback_wallpaper_lock_screen(system_settings_key_e key);
+/*
+ * Font change transports. SYSTEM_SETTINGS_FONT_NOTIFY selects them with a
+ * comma separated list of their names, e.g. "x,socket", and defaults to "x".
+ *
+ *   x      : "FONT_TYPE_change" property of the X root window set to "slp"
+ *   vconf  : VCONFKEY_SETAPPL_FONT_CHANGED_INT incremented
+ *   socket : "FONT_TYPE_change" datagram sent to every socket bound in
+ *            SYSTEM_SETTING_FONT_NOTIFY_SOCKET_DIR, its listener removes the socket
+ */
+#define SYSTEM_SETTING_FONT_NOTIFY_ENV "SYSTEM_SETTINGS_FONT_NOTIFY"
+#define SYSTEM_SETTING_FONT_NOTIFY_SOCKET_DIR "/run/system-settings/font"
+#define SYSTEM_SETTING_FONT_NOTIFY_MESSAGE "FONT_TYPE_change"
 
-int system_setting_set_changed_callback_font_size(system_settings_key_e key, system_settings_changed_cb callback, void *user_data);
-int system_setting_unset_changed_callback_font_size(system_settings_key_e key);
+typedef enum {
+	SYSTEM_SETTING_FONT_TRANSPORT_X = 1 << 0,
+	SYSTEM_SETTING_FONT_TRANSPORT_VCONF = 1 << 1,
+	SYSTEM_SETTING_FONT_TRANSPORT_SOCKET = 1 << 2,
+} system_setting_font_transport_e;
 
-int system_setting_set_changed_callback_font_type(system_settings_key_e key, system_settings_changed_cb callback, void *user_data);
-int system_setting_unset_changed_callback_font_type(system_settings_key_e key);
+// broadcasts a font change on the enabled transports, the changes that follow it within a burst are sent once
+void system_setting_font_notify(void);
+// overrides SYSTEM_SETTINGS_FONT_NOTIFY with a mask of system_setting_font_transport_e
+void system_setting_font_set_transports(unsigned int transports);
 
-int system_setting_set_changed_callback_motion_activation(system_settings_key_e key, system_settings_changed_cb callback, void *user_data);
-int system_setting_unset_changed_callback_motion_activation(system_settings_key_e key);
+SYSTEM_SETTING_SCHEMA(SYSTEM_SETTING_SCHEMA_ACCESSOR)
 
 
 
@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef __TIZEN_SYSTEM_SETTING_RECORD_PRIVATE_H__
+#define __TIZEN_SYSTEM_SETTING_RECORD_PRIVATE_H__
+
+#include <stdint.h>
+
+#include <system_settings_private.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/*
+ * Settings traffic trace.
+ *
+ * When SYSTEM_SETTINGS_RECORD names a file, every get, set, compare-and-set,
+ * subscription and change notification of the process is appended to it. The trace is replayed
+ * by system-settings-replay. It is laid out in native byte order:
+ *
+ *   header | (record | payload)*
+ *
+ * The payload is the value of the record: 4 bytes for INT, 8 for DOUBLE, 1 for
+ * BOOL and the characters without the terminating NUL for STRING. Records
+ * without a value have no payload.
+ */
+#define SYSTEM_SETTING_RECORD_ENV "SYSTEM_SETTINGS_RECORD"
+#define SYSTEM_SETTING_RECORD_MAGIC 0x52535353	/* "SSSR" */
+#define SYSTEM_SETTING_RECORD_VERSION 1
+
+#define SYSTEM_SETTING_RECORD_NO_VALUE 0xff
+
+typedef enum {
+	SYSTEM_SETTING_RECORD_GET = 1,		/* system_settings_get_value_* */
+	SYSTEM_SETTING_RECORD_SET,			/* system_settings_set_value_* */
+	SYSTEM_SETTING_RECORD_NOTIFY,		/* change notification */
+	SYSTEM_SETTING_RECORD_SUBSCRIBE,	/* system_settings_set_changed_cb, system_settings_add_value_changed_cb */
+	SYSTEM_SETTING_RECORD_UNSUBSCRIBE,	/* system_settings_unset_changed_cb, system_settings_remove_value_changed_cb */
+	SYSTEM_SETTING_RECORD_COMPARE_AND_SET,	/* system_settings_compare_and_set_value_*, the payload is the new value */
+} system_setting_record_op_e;
+
+typedef struct {
+	uint32_t magic;
+	uint32_t version;
+} system_setting_record_header_s;
+
+typedef struct {
+	uint64_t timestamp;		/* ns since the start of the recording */
+	uint32_t duration;		/* ns spent in the call */
+	int32_t key;			/* system_settings_key_e */
+	int32_t result;			/* error code returned by the call */
+	uint8_t op;				/* system_setting_record_op_e */
+	uint8_t data_type;		/* system_setting_data_type_e of the payload, or SYSTEM_SETTING_RECORD_NO_VALUE */
+	uint16_t size;			/* size of the payload */
+} __attribute__((packed)) system_setting_record_s;
+
+
+// returns the start time of a recorded call, or 0 when recording is off
+uint64_t system_setting_record_begin(void);
+// value as passed to system_settings_get_value(), system_settings_set_value() or
+// system_settings_compare_and_set_value(), NULL if none
+void system_setting_record_call(system_setting_record_op_e op, system_settings_key_e key,
+		system_setting_data_type_e data_type, void *value, int result, uint64_t begin);
+void system_setting_record_notify(system_settings_key_e key, const system_setting_value_s *value);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __TIZEN_SYSTEM_SETTING_RECORD_PRIVATE_H__ */
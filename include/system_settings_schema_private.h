@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef __TIZEN_SYSTEM_SETTING_SCHEMA_PRIVATE_H__
+#define __TIZEN_SYSTEM_SETTING_SCHEMA_PRIVATE_H__
+
+#include <vconf.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#define VCONFKEY_SETAPPL_ACCESSIBILITY_FONT_NAME  "db/setting/accessibility/font_name"
+
+/* incremented on every font change by the vconf font transport */
+#define VCONFKEY_SETAPPL_FONT_CHANGED_INT "memory/setting/font_changed"
+
+/* derived from VCONFKEY_SETAPPL_CALL_RINGTONE_PATH_STR when it is set */
+#define VCONFKEY_SETAPPL_CALL_RINGTONE_METADATA_STR "db/setting/sound/call/ringtone_metadata"
+
+/* derived from VCONFKEY_BGSET and VCONFKEY_IDLE_LOCK_BGSET when they are set */
+#define VCONFKEY_SETAPPL_WALLPAPER_HOME_SCREEN_CACHE_STR "db/setting/wallpaper/home_screen_cache"
+#define VCONFKEY_SETAPPL_WALLPAPER_LOCK_SCREEN_CACHE_STR "db/setting/wallpaper/lock_screen_cache"
+#define VCONFKEY_SETAPPL_WALLPAPER_HOME_SCREEN_PALETTE_STR "db/setting/wallpaper/home_screen_palette"
+#define VCONFKEY_SETAPPL_WALLPAPER_LOCK_SCREEN_PALETTE_STR "db/setting/wallpaper/lock_screen_palette"
+
+/*
+ * Key schema.
+ *
+ * Every system settings key is declared once here, and the dispatch table,
+ * the typed vconf accessors and the change notification wiring are all
+ * expanded from this list. Keys must be listed in system_settings_key_e order.
+ *
+ * X(name, key, type, vconf_key, min, max, get, check, apply, groups)
+ *   name      : lower case identifier used for generated accessors
+ *   key       : system_settings_key_e value
+ *   type      : STRING, INT, DOUBLE or BOOL
+ *   vconf_key : backing vconf key
+ *   min, max  : valid range of INT keys (ignored when min >= max)
+ *   get       : getter overriding the vconf read, or NULL
+ *   check     : validation hook called before the vconf write, or NULL
+ *   apply     : side-effect hook called after the vconf write, or NULL
+ *   groups    : SYSTEM_SETTING_GROUP_MASK() of the key groups other than "all"
+ */
+#define SYSTEM_SETTING_SCHEMA(X) \
+	X(incoming_call_ringtone, SYSTEM_SETTINGS_KEY_INCOMING_CALL_RINGTONE, STRING, \
+		VCONFKEY_SETAPPL_CALL_RINGTONE_PATH_STR, 0, 0, \
+		NULL, system_setting_check_incoming_call_ringtone, NULL, \
+		SYSTEM_SETTING_GROUP_MASK(SYSTEM_SETTINGS_GROUP_SOUND)) \
+	X(wallpaper_home_screen, SYSTEM_SETTINGS_KEY_WALLPAPER_HOME_SCREEN, STRING, \
+		VCONFKEY_BGSET, 0, 0, \
+		NULL, system_setting_check_wallpaper, NULL, \
+		SYSTEM_SETTING_GROUP_MASK(SYSTEM_SETTINGS_GROUP_WALLPAPER)) \
+	X(wallpaper_lock_screen, SYSTEM_SETTINGS_KEY_WALLPAPER_LOCK_SCREEN, STRING, \
+		VCONFKEY_IDLE_LOCK_BGSET, 0, 0, \
+		NULL, system_setting_check_wallpaper, NULL, \
+		SYSTEM_SETTING_GROUP_MASK(SYSTEM_SETTINGS_GROUP_WALLPAPER)) \
+	X(font_size, SYSTEM_SETTINGS_KEY_FONT_SIZE, INT, \
+		VCONFKEY_SETAPPL_ACCESSIBILITY_FONT_SIZE, SYSTEM_SETTINGS_FONT_SIZE_SMALL, SYSTEM_SETTINGS_FONT_SIZE_GIANT, \
+		NULL, NULL, system_setting_apply_font_size, \
+		SYSTEM_SETTING_GROUP_MASK(SYSTEM_SETTINGS_GROUP_FONT)) \
+	X(font_type, SYSTEM_SETTINGS_KEY_FONT_TYPE, STRING, \
+		VCONFKEY_SETAPPL_ACCESSIBILITY_FONT_NAME, 0, 0, \
+		system_setting_get_font_type, system_setting_check_font_type, system_setting_apply_font_type, \
+		SYSTEM_SETTING_GROUP_MASK(SYSTEM_SETTINGS_GROUP_FONT)) \
+	X(motion_activation, SYSTEM_SETTINGS_KEY_MOTION_ACTIVATION, BOOL, \
+		VCONFKEY_SETAPPL_MOTION_ACTIVATION, 0, 0, \
+		NULL, NULL, NULL, \
+		0)
+
+
+#define SYSTEM_SETTING_GROUP_MASK(group) (1u << (group))
+
+/* number of keys declared in the schema */
+#define SYSTEM_SETTING_SCHEMA_COUNT_ENTRY(name, key, type, vconf_key, min, max, get, check, apply, groups) + 1
+#define SYSTEM_SETTINGS_KEY_COUNT (0 SYSTEM_SETTING_SCHEMA(SYSTEM_SETTING_SCHEMA_COUNT_ENTRY))
+
+
+/* C type and vconf accessor of each schema type */
+#define SYSTEM_SETTING_CTYPE_STRING char*
+#define SYSTEM_SETTING_CTYPE_INT int
+#define SYSTEM_SETTING_CTYPE_DOUBLE double
+#define SYSTEM_SETTING_CTYPE_BOOL bool
+
+#define SYSTEM_SETTING_VCONF_GET_STRING system_setting_vconf_get_value_string
+#define SYSTEM_SETTING_VCONF_GET_INT system_setting_vconf_get_value_int
+#define SYSTEM_SETTING_VCONF_GET_DOUBLE system_setting_vconf_get_value_double
+#define SYSTEM_SETTING_VCONF_GET_BOOL system_setting_vconf_get_value_bool
+
+#define SYSTEM_SETTING_VCONF_SET_STRING system_setting_vconf_set_value_string
+#define SYSTEM_SETTING_VCONF_SET_INT system_setting_vconf_set_value_int
+#define SYSTEM_SETTING_VCONF_SET_DOUBLE system_setting_vconf_set_value_double
+#define SYSTEM_SETTING_VCONF_SET_BOOL system_setting_vconf_set_value_bool
+
+/*
+ * Typed accessors of the backing vconf key, e.g.
+ *   int system_setting_vconf_get_font_size(int *value);
+ *   int system_setting_vconf_set_font_size(int value);
+ */
+#define SYSTEM_SETTING_SCHEMA_ACCESSOR(name, key, type, vconf_key, min, max, get, check, apply, groups) \
+	static inline int system_setting_vconf_get_##name(SYSTEM_SETTING_CTYPE_##type *value) \
+	{ \
+		return SYSTEM_SETTING_VCONF_GET_##type(vconf_key, value); \
+	} \
+	static inline int system_setting_vconf_set_##name(SYSTEM_SETTING_CTYPE_##type value) \
+	{ \
+		return SYSTEM_SETTING_VCONF_SET_##type(vconf_key, value); \
+	}
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __TIZEN_SYSTEM_SETTING_SCHEMA_PRIVATE_H__ */
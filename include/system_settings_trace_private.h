@@ -0,0 +1,49 @@
+/*
+ * Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef __TIZEN_SYSTEM_SETTING_TRACE_PRIVATE_H__
+#define __TIZEN_SYSTEM_SETTING_TRACE_PRIVATE_H__
+
+/*
+ * Static tracepoints (USDT) of the "system_settings" provider.
+ *
+ * A probe compiles to a single nop and an ELF note, so it costs nothing until
+ * a tracer attaches to it. See tools/bpftrace for examples.
+ *
+ *   get_value_entry(key, type)          get_value_return(key, ret)
+ *   set_value_entry(key, type)          set_value_return(key, ret)
+ *   dispatch_entry(key)                 dispatch_return(key)
+ *   get_cur_font_entry()                get_cur_font_return(font_name)
+ *   font_config_set_entry(font_name)    font_config_set_return()
+ *   font_size_set_entry()               font_size_set_return(font_size)
+ *   elm_config_save_entry()             elm_config_save_return()
+ *   font_notify_entry()                 font_notify_return()
+ *   font_prewarm_entry(font_name)       font_prewarm_return()
+ */
+#ifdef HAVE_SYS_SDT_H
+#include <sys/sdt.h>
+
+#define SYSTEM_SETTING_TRACE(name) DTRACE_PROBE(system_settings, name)
+#define SYSTEM_SETTING_TRACE1(name, a) DTRACE_PROBE1(system_settings, name, a)
+#define SYSTEM_SETTING_TRACE2(name, a, b) DTRACE_PROBE2(system_settings, name, a, b)
+#else
+#define SYSTEM_SETTING_TRACE(name) do { } while (0)
+#define SYSTEM_SETTING_TRACE1(name, a) do { } while (0)
+#define SYSTEM_SETTING_TRACE2(name, a, b) do { } while (0)
+#endif
+
+#endif /* __TIZEN_SYSTEM_SETTING_TRACE_PRIVATE_H__ */
@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef __TIZEN_SYSTEM_SETTING_VENDOR_PRIVATE_H__
+#define __TIZEN_SYSTEM_SETTING_VENDOR_PRIVATE_H__
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/*
+ * Compiled vendor key schema.
+ *
+ * The file is produced by system-settings-vendor-compiler and mapped read-only
+ * by every process, so it is shared through the page cache and used in place.
+ * It is laid out in native byte order:
+ *
+ *   header | record[count] | string pool
+ *
+ * record[i] describes key SYSTEM_SETTINGS_KEY_VENDOR_BASE + i. Unused IDs
+ * have data_type SYSTEM_SETTING_VENDOR_TYPE_NONE. vconf_key is an offset
+ * into the NUL terminated string pool.
+ */
+#define SYSTEM_SETTING_VENDOR_SCHEMA_FILE "/usr/share/system-settings/vendor.schema"
+#define SYSTEM_SETTING_VENDOR_SCHEMA_MAGIC 0x53565353	/* "SSVS" */
+#define SYSTEM_SETTING_VENDOR_SCHEMA_VERSION 1
+
+#define SYSTEM_SETTING_VENDOR_TYPE_NONE 0xffffffff
+
+typedef struct {
+	uint32_t magic;
+	uint32_t version;
+	uint32_t count;				/* number of records */
+	uint32_t strings_offset;	/* offset of the string pool from the start of the file */
+	uint32_t strings_size;		/* size of the string pool including the last NUL */
+} system_setting_vendor_header_s;
+
+typedef struct {
+	uint32_t data_type;			/* system_setting_data_type_e */
+	int32_t min;				/* valid range of INT keys */
+	int32_t max;
+	uint32_t vconf_key;			/* offset into the string pool */
+} system_setting_vendor_record_s;
+
+
+int system_setting_vendor_get_item(system_settings_key_e key, system_setting_h *item);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __TIZEN_SYSTEM_SETTING_VENDOR_PRIVATE_H__ */
@@ -13,10 +13,12 @@ BuildRequires:  pkgconfig(elementary)
 BuildRequires:  pkgconfig(ecore)
 BuildRequires:  pkgconfig(ecore-x)
 BuildRequires:  pkgconfig(ecore-file)
+BuildRequires:  pkgconfig(ecore-evas)
 BuildRequires:  pkgconfig(appcore-efl)
 BuildRequires:  pkgconfig(capi-base-common)
 BuildRequires:  pkgconfig(glib-2.0)
 BuildRequires:  pkgconfig(gobject-2.0)
+BuildRequires:  pkgconfig(gthread-2.0)
 BuildRequires:  pkgconfig(fontconfig)
 BuildRequires:  pkgconfig(libxml-2.0)
 
@@ -58,10 +60,14 @@ rm -rf %{buildroot}
 
 %files
 %{_libdir}/lib*.so.*
+%{_prefix}/lib/tmpfiles.d/%{name}.conf
 # /usr/local/bin/test_system_settings
 /usr/local/bin/test_system_settings_gui
 
 %files devel
+%{_bindir}/system-settings-vendor-compiler
+%{_bindir}/system-settings-replay
 %{_includedir}/system/*.h
+%{_includedir}/system/*.hpp
 %{_libdir}/pkgconfig/*.pc
 %{_libdir}/lib*.so
@@ -21,6 +21,7 @@
 #include <sys/types.h>
 #include <sys/stat.h>
 #include <fcntl.h>
+#include <time.h>
 
 #include <dlog.h>
 #include <vconf.h>
@@ -34,6 +35,7 @@
 
 #include <system_settings.h>
 #include <system_settings_private.h>
+#include <system_settings_trace_private.h>
 
 
 #ifdef LOG_TAG
@@ -50,256 +52,112 @@
 #define SETTING_STR_SLP_LEN  256
 
 static char* _get_cur_font();
+static char* _parse_cur_font();
 static void font_size_set();
 static int __font_size_get();
+static int __font_size_dpi(int font_size);
 
 static void font_config_set(char *font_name);
-static void font_config_set_notification();
 
-int system_setting_get_incoming_call_ringtone(system_settings_key_e key, system_setting_data_type_e data_type, void** value)
+static system_setting_font_stage_cb font_stage_cb;
+static void *font_stage_user_data;
+static system_setting_font_notifier_cb font_notifier = system_setting_font_notify;
+
+void system_setting_font_set_stage_cb(system_setting_font_stage_cb callback, void *user_data)
 {
-	char* vconf_value;
-	if (system_setting_vconf_get_value_string(VCONFKEY_SETAPPL_CALL_RINGTONE_PATH_STR, &vconf_value)) {
-		return SYSTEM_SETTINGS_ERROR_IO_ERROR;
-	}
-	*value = vconf_value;
-	return SYSTEM_SETTINGS_ERROR_NONE;
+	font_stage_user_data = user_data;
+	font_stage_cb = callback;
 }
 
-
-int system_setting_get_wallpaper_home_screen(system_settings_key_e key, system_setting_data_type_e data_type, void** value)
+void system_setting_font_set_notifier(system_setting_font_notifier_cb notifier)
 {
-	char* vconf_value;
-	if (system_setting_vconf_get_value_string(VCONFKEY_BGSET, &vconf_value)) {
-		return SYSTEM_SETTINGS_ERROR_IO_ERROR;
-	}
-	*value = vconf_value;
-	return SYSTEM_SETTINGS_ERROR_NONE;
+	font_notifier = notifier != NULL ? notifier : system_setting_font_notify;
 }
 
-
-int system_setting_get_wallpaper_lock_screen(system_settings_key_e key, system_setting_data_type_e data_type, void** value)
+// returns the start time of the next stage, 0 when stages are not timed
+static unsigned long long font_stage_begin(void)
 {
-	char* vconf_value;
+	struct timespec ts;
 
-	if (system_setting_vconf_get_value_string(VCONFKEY_IDLE_LOCK_BGSET, &vconf_value)) {
-		return SYSTEM_SETTINGS_ERROR_IO_ERROR;
+	if (font_stage_cb == NULL)
+	{
+		return 0;
 	}
-	*value = vconf_value;
 
-	return SYSTEM_SETTINGS_ERROR_NONE;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (unsigned long long)ts.tv_sec * 1000000000ull + ts.tv_nsec;
 }
 
-
-// [int] vconf GET
-int system_setting_get_font_size(system_settings_key_e key, system_setting_data_type_e data_type, void** value)
+static unsigned long long font_stage_end(system_setting_font_stage_e stage, unsigned long long begin)
 {
-	printf("system_setting_get_font_size \n");
-	int vconf_value;
+	unsigned long long end;
 
-	if (system_setting_vconf_get_value_int(VCONFKEY_SETAPPL_ACCESSIBILITY_FONT_SIZE, &vconf_value)) {
-		return SYSTEM_SETTINGS_ERROR_IO_ERROR;
+	if (begin == 0 || font_stage_cb == NULL)
+	{
+		return 0;
 	}
-	*value = (void*)vconf_value;
 
-	return SYSTEM_SETTINGS_ERROR_NONE;
-}
+	end = font_stage_begin();
+	font_stage_cb(stage, end - begin, font_stage_user_data);
 
+	return end;
+}
 
-// [int] vconf GET
+// [string] font name of the current fontconfig configuration
 int system_setting_get_font_type(system_settings_key_e key, system_setting_data_type_e data_type, void** value)
 {
-	printf("system_setting_get_font_type\n");
-	//int vconf_value;
-
 	char* font_name = _get_cur_font();
-	#if 0
-	if (system_setting_vconf_get_value_int(VCONFKEY_SETAPPL_FONT_TYPE_INT, &vconf_value)) {
-		return SYSTEM_SETTINGS_ERROR_IO_ERROR;
-	}
-	//*value = (void*)vconf_value;
-	#endif
 	*value = (void*)font_name;
 
-	return SYSTEM_SETTINGS_ERROR_NONE;
-}
-
-
-int system_setting_get_motion_activation(system_settings_key_e key, system_setting_data_type_e data_type, void** value)
-{
-	bool vconf_value;
-
-	if (system_setting_vconf_get_value_bool(VCONFKEY_SETAPPL_MOTION_ACTIVATION, &vconf_value)) {
+	/* the fontconfig file is missing or invalid */
+	if (font_name == NULL) {
 		return SYSTEM_SETTINGS_ERROR_IO_ERROR;
 	}
-	*value = (void*)vconf_value;
 
 	return SYSTEM_SETTINGS_ERROR_NONE;
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
-int system_setting_set_incoming_call_ringtone(system_settings_key_e key, system_setting_data_type_e data_type, void* value)
-{
-	printf(" mock --> real system_setting_set_incoming_call_ringtone \n");
-	char* vconf_value;
-	vconf_value = (char*)value;
-	if (system_setting_vconf_set_value_string(VCONFKEY_SETAPPL_CALL_RINGTONE_PATH_STR, vconf_value)) {
-		return SYSTEM_SETTINGS_ERROR_IO_ERROR;
-	}
-
-	return SYSTEM_SETTINGS_ERROR_NONE;
-}
-
-int system_setting_set_wallpaper_home_screen(system_settings_key_e key, system_setting_data_type_e data_type, void* value)
+int system_setting_apply_font_size(system_settings_key_e key, system_setting_data_type_e data_type, void* value)
 {
-	printf(" mock --> real system_setting_set_wallpaper_home_screen \n");
-
-	char* vconf_value;
-	vconf_value = (char*)value;
-	if (system_setting_vconf_set_value_string(VCONFKEY_BGSET, vconf_value)) {
-		return SYSTEM_SETTINGS_ERROR_IO_ERROR;
-	}
+	font_size_set();
 
 	return SYSTEM_SETTINGS_ERROR_NONE;
 }
 
-int system_setting_set_wallpaper_lock_screen(system_settings_key_e key, system_setting_data_type_e data_type, void* value)
+int system_setting_apply_font_type(system_settings_key_e key, system_setting_data_type_e data_type, void* value)
 {
-	printf(" mock --> real system_setting_set_wallpaper_lock_screen \n");
-
-	char* vconf_value;
-	vconf_value = (char*)value;
-	if (system_setting_vconf_set_value_string(VCONFKEY_IDLE_LOCK_BGSET, vconf_value)) {
-		return SYSTEM_SETTINGS_ERROR_IO_ERROR;
-	}
+	char* font_name = (char*)value;
 
-	return SYSTEM_SETTINGS_ERROR_NONE;
-}
-
-int system_setting_set_font_size(system_settings_key_e key, system_setting_data_type_e data_type, void* value)
-{
-	printf(" real system_setting_set_font_size \n");
-	int* vconf_value;
-	vconf_value = (int*)value;
+	unsigned long long stage;
 
-	if (*vconf_value < 0 || *vconf_value > SYSTEM_SETTINGS_FONT_SIZE_GIANT) {
-		return SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER;
-	}
+	LOGD("[%s] font name = %s", __FUNCTION__, font_name);
 
-	if (system_setting_vconf_set_value_int(VCONFKEY_SETAPPL_ACCESSIBILITY_FONT_SIZE, *vconf_value)) {
-		return SYSTEM_SETTINGS_ERROR_IO_ERROR;
-	}
-	font_size_set();
-
-	printf(">>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>. system_setting_set_font_size called \n");
-
-	return SYSTEM_SETTINGS_ERROR_NONE;
-}
-
-int system_setting_set_font_type(system_settings_key_e key, system_setting_data_type_e data_type, void* value)
-{
-	printf(" real system_setting_set_font_type \n");
-	char* font_name = NULL;
-	font_name = (char*)value;
-
-	printf(">>>>>>>>>>>>> font name = %s \n", font_name);
+	/* runs while the elementary configuration is saved and the change is notified */
+	system_setting_font_prewarm(font_name);
 	font_config_set(font_name);
-	font_config_set_notification();
 
-	char* vconf_value;
-	vconf_value = (char*)value;
-	if (system_setting_vconf_set_value_string(VCONFKEY_SETAPPL_ACCESSIBILITY_FONT_NAME, vconf_value)) {
-		return SYSTEM_SETTINGS_ERROR_IO_ERROR;
-	}
-	return SYSTEM_SETTINGS_ERROR_NONE;
-}
+	stage = font_stage_begin();
+	font_notifier();
+	font_stage_end(SYSTEM_SETTING_FONT_STAGE_NOTIFY, stage);
 
-int system_setting_set_motion_activation(system_settings_key_e key, system_setting_data_type_e data_type, void* value)
-{
-	printf(" mock --> real system_setting_set_motion_activation \n");
-
-	bool* vconf_value;
-	vconf_value = (bool*)value;
-	if (system_setting_vconf_set_value_bool(VCONFKEY_SETAPPL_MOTION_ACTIVATION, *vconf_value)) {
-		return SYSTEM_SETTINGS_ERROR_IO_ERROR;
-	}
 	return SYSTEM_SETTINGS_ERROR_NONE;
 }
 
-/////////////////////////////////////////////////////////////////////////////////////////////////
-//
-
-int system_setting_set_changed_callback_incoming_call_ringtone(system_settings_key_e key, system_settings_changed_cb callback, void *user_data)
-{
-	return system_setting_vconf_set_changed_cb(VCONFKEY_SETAPPL_CALL_RINGTONE_PATH_STR, SYSTEM_SETTINGS_KEY_INCOMING_CALL_RINGTONE, 0);
-}
-
-int system_setting_unset_changed_callback_incoming_call_ringtone(system_settings_key_e key)
-{
-	return system_setting_vconf_unset_changed_cb(VCONFKEY_SETAPPL_CALL_RINGTONE_PATH_STR, 0);
-}
-
-int system_setting_set_changed_callback_wallpaper_home_screen(system_settings_key_e key, system_settings_changed_cb callback, void *user_data)
-{
-	return system_setting_vconf_set_changed_cb(VCONFKEY_BGSET, SYSTEM_SETTINGS_KEY_WALLPAPER_HOME_SCREEN, 0);
-}
-
-int system_setting_unset_changed_callback_wallpaper_home_screen(system_settings_key_e key)
-{
-	return system_setting_vconf_unset_changed_cb(VCONFKEY_BGSET, 0);
-}
-
-int system_setting_set_changed_callback_wallpaper_lock_screen(system_settings_key_e key, system_settings_changed_cb callback, void *user_data)
-{
-	return system_setting_vconf_set_changed_cb(VCONFKEY_IDLE_LOCK_BGSET,SYSTEM_SETTINGS_KEY_WALLPAPER_LOCK_SCREEN, 0);
-}
-
-int system_setting_unset_changed_callback_wallpaper_lock_screen(system_settings_key_e key)
-{
-	return system_setting_vconf_unset_changed_cb(VCONFKEY_IDLE_LOCK_BGSET, 0);
-}
-
-int system_setting_set_changed_callback_font_size(system_settings_key_e key, system_settings_changed_cb callback, void *user_data)
-{
-	return system_setting_vconf_set_changed_cb(VCONFKEY_SETAPPL_ACCESSIBILITY_FONT_SIZE,SYSTEM_SETTINGS_KEY_FONT_SIZE, 1);
-}
-
-int system_setting_unset_changed_callback_font_size(system_settings_key_e key)
-{
-	return system_setting_vconf_unset_changed_cb(VCONFKEY_SETAPPL_ACCESSIBILITY_FONT_SIZE, 1);
-}
-
-/**
- * @todo need to add custom event notification method
- */
-int system_setting_set_changed_callback_font_type(system_settings_key_e key, system_settings_changed_cb callback, void *user_data)
-{
-	return system_setting_vconf_set_changed_cb(VCONFKEY_SETAPPL_ACCESSIBILITY_FONT_NAME,SYSTEM_SETTINGS_KEY_FONT_TYPE, 2);
-}
-
-int system_setting_unset_changed_callback_font_type(system_settings_key_e key)
+static char* _get_cur_font()
 {
-	return system_setting_vconf_unset_changed_cb(VCONFKEY_SETAPPL_ACCESSIBILITY_FONT_NAME,2);
-}
+    char *font_name;
 
-// TODO : 2th argument, callback, is not in use.
-int system_setting_set_changed_callback_motion_activation(system_settings_key_e key, system_settings_changed_cb callback, void *user_data)
-{
-	printf("system_setting_set_changed_callback_motion_activation \n");
-	return system_setting_vconf_set_changed_cb(VCONFKEY_SETAPPL_MOTION_ACTIVATION, SYSTEM_SETTINGS_KEY_MOTION_ACTIVATION, 3);
-}
+    SYSTEM_SETTING_TRACE(get_cur_font_entry);
+    font_name = _parse_cur_font();
+    SYSTEM_SETTING_TRACE1(get_cur_font_return, font_name);
 
-int system_setting_unset_changed_callback_motion_activation(system_settings_key_e key)
-{
-	printf("system_setting_unset_changed_callback_motion_activation \n");
-	return system_setting_vconf_unset_changed_cb(VCONFKEY_SETAPPL_MOTION_ACTIVATION, 3);
+    return font_name;
 }
 
-static char* _get_cur_font()
+static char* _parse_cur_font()
 {
-    printf("get current font \n");
-
     xmlDocPtr doc = NULL;
     xmlNodePtr cur = NULL;
     xmlNodePtr cur2 = NULL;
@@ -313,14 +171,14 @@ static char* _get_cur_font()
     cur = xmlDocGetRootElement(doc);
 
     if(cur == NULL) {
-        printf("empty document");
+        LOGE("[%s] %s : empty document", __FUNCTION__, SETTING_FONT_CONF_FILE);
         xmlFreeDoc(doc);
         doc = NULL;
         return NULL;
     }
 
     if(xmlStrcmp(cur->name, (const xmlChar *)"fontconfig")) {
-        printf("document of the wrong type, root node != fontconfig");
+        LOGE("[%s] %s : root node != fontconfig", __FUNCTION__, SETTING_FONT_CONF_FILE);
         xmlFreeDoc(doc);
         doc = NULL;
         return NULL;
@@ -366,15 +224,6 @@ static char* _get_cur_font()
     return NULL;
 }
 
-static void font_config_set_notification()
-{
-    /* notification */
-	Ecore_X_Window ecore_win = ecore_x_window_root_first_get();
-	printf("FONT CHANGE NOTIFICATION >>>>>>>>>> : %d  \n", (unsigned int)ecore_win);
-	Ecore_X_Atom atom = ecore_x_atom_get("FONT_TYPE_change");
-	ecore_x_window_prop_string_set(ecore_win, atom, "slp");
-}
-
 static void font_config_set(char *font_name)
 {
     Eina_List *text_classes = NULL;
@@ -396,6 +245,11 @@ static void font_config_set(char *font_name)
     Eina_Bool slp_roman_exist = EINA_FALSE;
     Eina_Bool slp_bold_exist = EINA_FALSE;
     Eina_Bool slp_regular_exist = EINA_FALSE;
+    unsigned long long stage;
+
+    SYSTEM_SETTING_TRACE1(font_config_set_entry, font_name);
+
+    stage = font_stage_begin();
 
     EINA_LIST_FOREACH_SAFE(fo_list, ll, l_next, efo)
     {
@@ -441,12 +295,20 @@ static void font_config_set(char *font_name)
         }
         elm_config_font_overlay_set(etc->name, (const char*)font_name, size);
     }
+    stage = font_stage_end(SYSTEM_SETTING_FONT_STAGE_OVERLAY_SET, stage);
 
     elm_config_font_overlay_apply();
+    stage = font_stage_end(SYSTEM_SETTING_FONT_STAGE_APPLY, stage);
     elm_config_all_flush();
+    stage = font_stage_end(SYSTEM_SETTING_FONT_STAGE_FLUSH, stage);
+    SYSTEM_SETTING_TRACE(elm_config_save_entry);
     elm_config_save();
+    SYSTEM_SETTING_TRACE(elm_config_save_return);
+    font_stage_end(SYSTEM_SETTING_FONT_STAGE_SAVE, stage);
     elm_config_text_classes_list_free(text_classes);
     text_classes = NULL;
+
+    SYSTEM_SETTING_TRACE(font_config_set_return);
 }
 
 static void font_size_set()
@@ -454,15 +316,32 @@ static void font_size_set()
     Eina_List *text_classes = NULL;
     Elm_Text_Class *etc = NULL;
     const Eina_List *l = NULL;
-    int font_size = __font_size_get();
-    char *font_name = _get_cur_font();
+    system_settings_snapshot_h snapshot = NULL;
+    int font_size = -1;
+    const char *font_name = NULL;
+    unsigned long long stage;
+
+    SYSTEM_SETTING_TRACE(font_size_set_entry);
+
+    /* the size and the font are read from one snapshot, so that they are not of two different changes */
+    stage = font_stage_begin();
+    if (system_settings_snapshot_acquire(&snapshot) == SYSTEM_SETTINGS_ERROR_NONE
+        && system_settings_snapshot_get_value_int(snapshot, SYSTEM_SETTINGS_KEY_FONT_SIZE, &font_size) == SYSTEM_SETTINGS_ERROR_NONE) {
+        font_size = __font_size_dpi(font_size);
+        system_settings_snapshot_get_value_string(snapshot, SYSTEM_SETTINGS_KEY_FONT_TYPE, &font_name);
+    } else {
+        font_size = -1;
+    }
+    stage = font_stage_end(SYSTEM_SETTING_FONT_STAGE_PARSE, stage);
 
     if (font_size == -1) {
         //SETTING_TRACE_DEBUG("failed to call font_size_get");
+        if (snapshot != NULL) {
+            system_settings_snapshot_release(snapshot);
+        }
+        SYSTEM_SETTING_TRACE1(font_size_set_return, font_size);
         return;
-    } else {
-		printf(">> font name = %s, font size = %d \n", font_name, font_size);
-	}
+    }
 
     text_classes = elm_config_text_classes_list_get();
 
@@ -470,28 +349,27 @@ static void font_size_set()
     {
         elm_config_font_overlay_set(etc->name, font_name, font_size);
     }
+    stage = font_stage_end(SYSTEM_SETTING_FONT_STAGE_OVERLAY_SET, stage);
 
 	elm_config_font_overlay_apply();
+    stage = font_stage_end(SYSTEM_SETTING_FONT_STAGE_APPLY, stage);
     elm_config_all_flush();
+    stage = font_stage_end(SYSTEM_SETTING_FONT_STAGE_FLUSH, stage);
+    SYSTEM_SETTING_TRACE(elm_config_save_entry);
     elm_config_save();
+    SYSTEM_SETTING_TRACE(elm_config_save_return);
+    font_stage_end(SYSTEM_SETTING_FONT_STAGE_SAVE, stage);
     elm_config_text_classes_list_free(text_classes);
     text_classes = NULL;
-    //G_FREE(font_name);
-    g_free(font_name);
-	printf(">>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>. font_size_set called \n");
+    system_settings_snapshot_release(snapshot);
+    SYSTEM_SETTING_TRACE1(font_size_set_return, font_size);
 }
 
-static int __font_size_get()
+static int __font_size_dpi(int font_size_value)
 {
     int font_size = -1;
-    int err = -1;
-
-	int vconf_value = -1;
-	if (system_setting_vconf_get_value_int(VCONFKEY_SETAPPL_ACCESSIBILITY_FONT_SIZE, &vconf_value)) {
-		return -1;
-	}
 
-    switch(vconf_value) {
+    switch(font_size_value) {
     case SYSTEM_SETTINGS_FONT_SIZE_SMALL:
         font_size = SMALL_FONT_DPI;
         break;
@@ -513,3 +391,14 @@ static int __font_size_get()
     }
     return font_size;
 }
+
+static int __font_size_get()
+{
+    int vconf_value = -1;
+
+    if (system_setting_vconf_get_font_size(&vconf_value)) {
+        return -1;
+    }
+
+    return __font_size_dpi(vconf_value);
+}
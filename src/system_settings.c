@@ -23,6 +23,10 @@
 
 #include <system_settings.h>
 #include <system_settings_private.h>
+#include <system_settings_backend_private.h>
+#include <system_settings_vendor_private.h>
+#include <system_settings_trace_private.h>
+#include <system_settings_record_private.h>
 
 #include <glib.h>
 
@@ -33,98 +37,40 @@
 
 #define LOG_TAG "TIZEN_N_SYSTEM_SETTINGS"
 
-#define SYSTEM_SETTINGS_MAX -1
-
-
-
-system_setting_s system_setting_table[] = {
-
-	{
-		SYSTEM_SETTINGS_KEY_INCOMING_CALL_RINGTONE,
-		SYSTEM_SETTING_DATA_TYPE_STRING,
-		system_setting_get_incoming_call_ringtone,
-		system_setting_set_incoming_call_ringtone,
-		system_setting_set_changed_callback_incoming_call_ringtone,
-		system_setting_unset_changed_callback_incoming_call_ringtone,
-		NULL
-	}, 
-
-	{
-		SYSTEM_SETTINGS_KEY_WALLPAPER_HOME_SCREEN,
-		SYSTEM_SETTING_DATA_TYPE_STRING,
-		system_setting_get_wallpaper_home_screen,
-		system_setting_set_wallpaper_home_screen,
-		system_setting_set_changed_callback_wallpaper_home_screen,
-		system_setting_unset_changed_callback_wallpaper_home_screen,
-		NULL
-	},
-
-	{
-		SYSTEM_SETTINGS_KEY_WALLPAPER_LOCK_SCREEN,
-		SYSTEM_SETTING_DATA_TYPE_STRING,
-		system_setting_get_wallpaper_lock_screen,
-		system_setting_set_wallpaper_lock_screen,
-		system_setting_set_changed_callback_wallpaper_lock_screen,
-		system_setting_unset_changed_callback_wallpaper_lock_screen,
-		NULL
+#define SYSTEM_SETTING_TABLE_ENTRY(name, key, type, vconf_key, min, max, get, check, apply, groups) \
+	[key] = { \
+		key, \
+		SYSTEM_SETTING_DATA_TYPE_##type, \
+		vconf_key, \
+		min, \
+		max, \
+		get, \
+		check, \
+		apply, \
+		groups, \
 	},
 
-	{
-		SYSTEM_SETTINGS_KEY_FONT_SIZE,
-		SYSTEM_SETTING_DATA_TYPE_INT,
-		system_setting_get_font_size,
-		system_setting_set_font_size,
-		system_setting_set_changed_callback_font_size,
-		system_setting_unset_changed_callback_font_size,
-		NULL
-	},
-
-	{
-		SYSTEM_SETTINGS_KEY_FONT_TYPE,
-		SYSTEM_SETTING_DATA_TYPE_STRING,
-		system_setting_get_font_type,
-		system_setting_set_font_type,
-		system_setting_set_changed_callback_font_type,
-		system_setting_unset_changed_callback_font_type,
-		NULL
-	},
-
-	{
-		SYSTEM_SETTINGS_KEY_MOTION_ACTIVATION,
-		SYSTEM_SETTING_DATA_TYPE_BOOL,
-		system_setting_get_motion_activation,
-		system_setting_set_motion_activation,
-		system_setting_set_changed_callback_motion_activation,
-		system_setting_unset_changed_callback_motion_activation,
-		NULL
-	},
-	{
-		SYSTEM_SETTINGS_MAX, -1, NULL, NULL, NULL, NULL, NULL
-	}
+/* indexed by system_settings_key_e */
+system_setting_s system_setting_table[SYSTEM_SETTINGS_KEY_COUNT] = {
+	SYSTEM_SETTING_SCHEMA(SYSTEM_SETTING_TABLE_ENTRY)
 };
 
 int system_settings_get_item(system_settings_key_e key, system_setting_h *item)
 {
-    int index = 0;
-
-    while (system_setting_table[index].key != SYSTEM_SETTINGS_MAX)
-    {   
-        if (system_setting_table[index].key == key)
-        {   
-            *item = &system_setting_table[index];
-            return 0;
-        }   
-
-        index++;
-    }   
+    if ((unsigned int)key >= SYSTEM_SETTINGS_KEY_COUNT)
+    {
+        return system_setting_vendor_get_item(key, item);
+    }
 
-    return -1; 
+    *item = &system_setting_table[key];
+    return 0;
 }
 
-int system_settings_get_value(system_settings_key_e key, system_setting_data_type_e data_type, void** value)
+static int system_settings_get_value_internal(system_settings_key_e key, system_setting_data_type_e data_type, void** value)
 {
     system_setting_h system_setting_item;
 	system_setting_get_value_cb	system_setting_getter;
+	int ret;
 
     if (system_settings_get_item(key, &system_setting_item))
     {
@@ -138,22 +84,42 @@ int system_settings_get_value(system_settings_key_e key, system_setting_data_typ
         return SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER;
     }
 
-	printf("assigned getter \n");
+    /* the key failed recently, the backend is not read again until the backoff expires */
+    ret = system_setting_backoff_check(key);
+
+    if (ret != SYSTEM_SETTINGS_ERROR_NONE)
+    {
+        return ret;
+    }
+
     system_setting_getter = system_setting_item->get_value_cb;
 
-    if (system_setting_getter == NULL)
+    if (system_setting_getter != NULL)
     {
-        LOGE("[%s] IO_ERROR(0x%08x) : failed to call getter for the system settings", __FUNCTION__, SYSTEM_SETTINGS_ERROR_IO_ERROR);
-        return SYSTEM_SETTINGS_ERROR_IO_ERROR;
+        ret = system_setting_getter(key, system_setting_item->data_type, value);
+    }
+    else if (system_setting_vconf_get_value(system_setting_item->vconf_key, system_setting_item->data_type, value))
+    {
+        LOGE("[%s] IO_ERROR(0x%08x) : failed to get the vconf value", __FUNCTION__, SYSTEM_SETTINGS_ERROR_IO_ERROR);
+        ret = SYSTEM_SETTINGS_ERROR_IO_ERROR;
     }
 
-    return system_setting_getter(key, system_setting_item->data_type, value);
+    if (ret == SYSTEM_SETTINGS_ERROR_IO_ERROR)
+    {
+        system_setting_backoff_failed(key, ret);
+    }
+    else if (ret == SYSTEM_SETTINGS_ERROR_NONE)
+    {
+        system_setting_backoff_reset(key);
+    }
+
+    return ret;
 }
 
-int system_settings_set_value(system_settings_key_e key, system_setting_data_type_e data_type, void* value)
+static int system_setting_check_value(system_settings_key_e key, system_setting_data_type_e data_type, void* value, system_setting_h *item)
 {
 	system_setting_h system_setting_item;
-	system_setting_set_value_cb	system_setting_setter;
+	int ret;
 
     if (system_settings_get_item(key, &system_setting_item))
     {
@@ -161,16 +127,249 @@ int system_settings_set_value(system_settings_key_e key, system_setting_data_typ
         return SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER;
     }
 
-	printf("assigned setter \n");
-    system_setting_setter = system_setting_item->set_value_cb;
+    if (system_setting_item->data_type != data_type)
+    {
+        LOGE("[%s] INVALID_PARAMETER(0x%08x) : invalid data type", __FUNCTION__, SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER);
+        return SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER;
+    }
+
+    if (data_type == SYSTEM_SETTING_DATA_TYPE_INT && system_setting_item->min < system_setting_item->max)
+    {
+        int int_value = *(int*)value;
+
+        if (int_value < system_setting_item->min || int_value > system_setting_item->max)
+        {
+            LOGE("[%s] INVALID_PARAMETER(0x%08x) : out of range", __FUNCTION__, SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER);
+            return SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER;
+        }
+    }
+
+    if (system_setting_item->check_value_cb != NULL)
+    {
+        ret = system_setting_item->check_value_cb(key, data_type, value);
+
+        if (ret != SYSTEM_SETTINGS_ERROR_NONE)
+        {
+            return ret;
+        }
+    }
+
+    *item = system_setting_item;
+    return SYSTEM_SETTINGS_ERROR_NONE;
+}
+
+/* called once the value is written */
+static int system_setting_value_written(system_setting_h system_setting_item, system_settings_key_e key, system_setting_data_type_e data_type, void* value)
+{
+    system_setting_snapshot_invalidate(key);
+    system_setting_backoff_reset(key);
+
+    if (system_setting_item->apply_value_cb != NULL)
+    {
+        return system_setting_item->apply_value_cb(key, data_type, value);
+    }
+
+    return SYSTEM_SETTINGS_ERROR_NONE;
+}
+
+/* value was checked with system_setting_check_value() */
+static int system_setting_write_value(system_setting_h system_setting_item, system_settings_key_e key, system_setting_data_type_e data_type, void* value)
+{
+    if (system_setting_vconf_set_value(system_setting_item->vconf_key, data_type, value))
+    {
+        LOGE("[%s] IO_ERROR(0x%08x) : failed to set the vconf value", __FUNCTION__, SYSTEM_SETTINGS_ERROR_IO_ERROR);
+        return SYSTEM_SETTINGS_ERROR_IO_ERROR;
+    }
+
+    return system_setting_value_written(system_setting_item, key, data_type, value);
+}
+
+int system_setting_set_value_unlimited(system_settings_key_e key, system_setting_data_type_e data_type, void* value)
+{
+	system_setting_h system_setting_item;
+	int ret = system_setting_check_value(key, data_type, value, &system_setting_item);
+
+    if (ret != SYSTEM_SETTINGS_ERROR_NONE)
+    {
+        return ret;
+    }
+
+    return system_setting_write_value(system_setting_item, key, data_type, value);
+}
+
+/*
+ * The getter of a key returns the value in use, which is not always the one of
+ * its vconf key: FONT_TYPE reads the font configuration. Such keys are compared
+ * with what the getter returns, and the write and its apply hook run under the
+ * compare-and-set lock, so that the next writer reads the applied value.
+ */
+static int system_setting_compare_and_set_by_getter(system_setting_h system_setting_item, system_settings_key_e key,
+    system_setting_data_type_e data_type, void* expected, void* value, void** current)
+{
+    system_setting_value_s expected_value;
+    system_setting_value_s stored;
+    int ret;
+
+    if (system_setting_value_init(&expected_value, data_type, expected))
+    {
+        return SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER;
+    }
 
-    if (system_setting_setter == NULL)
+    if (system_setting_vconf_cas_lock())
     {
-        LOGE("[%s] IO_ERROR(0x%08x) : failed to call getter for the system settings", __FUNCTION__, SYSTEM_SETTINGS_ERROR_IO_ERROR);
+        LOGE("[%s] IO_ERROR(0x%08x) : failed to take the compare-and-set lock", __FUNCTION__, SYSTEM_SETTINGS_ERROR_IO_ERROR);
         return SYSTEM_SETTINGS_ERROR_IO_ERROR;
     }
 
-    return system_setting_setter(key, system_setting_item->data_type, value);
+    memset(&stored, 0, sizeof(stored));
+    stored.data_type = data_type;
+
+    ret = system_setting_item->get_value_cb(key, data_type, (void**)&stored.value);
+
+    if (ret != SYSTEM_SETTINGS_ERROR_NONE)
+    {
+        system_setting_vconf_cas_unlock();
+        return ret;
+    }
+
+    if (!system_setting_value_equal(&stored, &expected_value))
+    {
+        system_setting_vconf_cas_unlock();
+        system_setting_stat_inc(SYSTEM_SETTINGS_STAT_WRITES_CONFLICTED);
+
+        if (current != NULL)
+        {
+            system_setting_value_output(&stored, current);
+        }
+        else
+        {
+            system_setting_value_clear(&stored);
+        }
+        return SYSTEM_SETTINGS_ERROR_TRY_AGAIN;
+    }
+
+    system_setting_value_clear(&stored);
+
+    if (system_setting_vconf_set_value(system_setting_item->vconf_key, data_type, value))
+    {
+        LOGE("[%s] IO_ERROR(0x%08x) : failed to set the vconf value", __FUNCTION__, SYSTEM_SETTINGS_ERROR_IO_ERROR);
+        ret = SYSTEM_SETTINGS_ERROR_IO_ERROR;
+    }
+    else
+    {
+        ret = system_setting_value_written(system_setting_item, key, data_type, value);
+    }
+
+    system_setting_vconf_cas_unlock();
+
+    return ret;
+}
+
+int system_settings_compare_and_set_value(system_settings_key_e key, system_setting_data_type_e data_type, void* expected, void* value, void** current)
+{
+	uint64_t begin = system_setting_record_begin();
+	system_setting_h system_setting_item;
+	int ret = system_setting_check_value(key, data_type, value, &system_setting_item);
+
+    if (ret == SYSTEM_SETTINGS_ERROR_NONE && data_type == SYSTEM_SETTING_DATA_TYPE_STRING && expected == NULL)
+    {
+        LOGE("[%s] INVALID_PARAMETER(0x%08x) : invalid argument", __FUNCTION__, SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER);
+        ret = SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER;
+    }
+
+    if (ret != SYSTEM_SETTINGS_ERROR_NONE)
+    {
+        system_setting_record_call(SYSTEM_SETTING_RECORD_COMPARE_AND_SET, key, data_type, value, ret, begin);
+        return ret;
+    }
+
+    SYSTEM_SETTING_TRACE2(set_value_entry, key, data_type);
+
+    /* a compare-and-set is never deferred, the value it compares with would be stale */
+    ret = system_setting_rate_limit_acquire(key, data_type, NULL);
+
+    if (ret == SYSTEM_SETTINGS_ERROR_NONE && system_setting_item->get_value_cb != NULL)
+    {
+        ret = system_setting_compare_and_set_by_getter(system_setting_item, key, data_type, expected, value, current);
+    }
+    else if (ret == SYSTEM_SETTINGS_ERROR_NONE)
+    {
+        ret = system_setting_vconf_compare_and_set_value(system_setting_item->vconf_key, data_type, expected, value, current);
+
+        if (ret == SYSTEM_SETTING_BACKEND_MISMATCH)
+        {
+            system_setting_stat_inc(SYSTEM_SETTINGS_STAT_WRITES_CONFLICTED);
+            ret = SYSTEM_SETTINGS_ERROR_TRY_AGAIN;
+        }
+        else if (ret != 0)
+        {
+            LOGE("[%s] IO_ERROR(0x%08x) : failed to compare and set the vconf value", __FUNCTION__, SYSTEM_SETTINGS_ERROR_IO_ERROR);
+            ret = SYSTEM_SETTINGS_ERROR_IO_ERROR;
+        }
+        else
+        {
+            ret = system_setting_value_written(system_setting_item, key, data_type, value);
+        }
+    }
+
+    SYSTEM_SETTING_TRACE2(set_value_return, key, ret);
+
+    system_setting_record_call(SYSTEM_SETTING_RECORD_COMPARE_AND_SET, key, data_type, value, ret, begin);
+
+    return ret;
+}
+
+int system_settings_get_value(system_settings_key_e key, system_setting_data_type_e data_type, void** value)
+{
+	int ret;
+
+	SYSTEM_SETTING_TRACE2(get_value_entry, key, data_type);
+	ret = system_settings_get_value_internal(key, data_type, value);
+	SYSTEM_SETTING_TRACE2(get_value_return, key, ret);
+
+	return ret;
+}
+
+/* only the reads of the application are recorded, not those made by the library itself */
+static int system_setting_get_value_recorded(system_settings_key_e key, system_setting_data_type_e data_type, void** value)
+{
+	uint64_t begin = system_setting_record_begin();
+	int ret = system_settings_get_value(key, data_type, value);
+
+	system_setting_record_call(SYSTEM_SETTING_RECORD_GET, key, data_type, value, ret, begin);
+
+	return ret;
+}
+
+int system_settings_set_value(system_settings_key_e key, system_setting_data_type_e data_type, void* value)
+{
+	uint64_t begin = system_setting_record_begin();
+	system_setting_h system_setting_item;
+	int ret;
+
+	SYSTEM_SETTING_TRACE2(set_value_entry, key, data_type);
+
+	/* only a valid value is deferred, the error of an invalid one is returned at once */
+	ret = system_setting_check_value(key, data_type, value, &system_setting_item);
+
+	if (ret == SYSTEM_SETTINGS_ERROR_NONE)
+	{
+		ret = system_setting_rate_limit_acquire(key, data_type, value);
+	}
+
+	if (ret == SYSTEM_SETTINGS_ERROR_NONE)
+	{
+		ret = system_setting_write_value(system_setting_item, key, data_type, value);
+	}
+	else if (ret == SYSTEM_SETTING_RATE_LIMIT_DEFERRED)
+	{
+		ret = SYSTEM_SETTINGS_ERROR_NONE;
+	}
+	SYSTEM_SETTING_TRACE2(set_value_return, key, ret);
+
+	system_setting_record_call(SYSTEM_SETTING_RECORD_SET, key, data_type, value, ret, begin);
+
+	return ret;
 }
 
 // typedef int (*system_setting_set_value_cb) (system_settings_key_e key, system_setting_data_type_e data_type, void* value);
@@ -185,7 +384,7 @@ int system_settings_set_value_int(system_settings_key_e key, int value)
 
 int system_settings_get_value_int(system_settings_key_e key, int *value)
 {
-	return system_settings_get_value(key, SYSTEM_SETTING_DATA_TYPE_INT, (void**)value);
+	return system_setting_get_value_recorded(key, SYSTEM_SETTING_DATA_TYPE_INT, (void**)value);
 }
 
 int system_settings_set_value_bool(system_settings_key_e key, bool value)
@@ -197,7 +396,7 @@ int system_settings_set_value_bool(system_settings_key_e key, bool value)
 
 int system_settings_get_value_bool(system_settings_key_e key, bool *value)
 {
-	return system_settings_get_value(key, SYSTEM_SETTING_DATA_TYPE_BOOL, (void**)value);
+	return system_setting_get_value_recorded(key, SYSTEM_SETTING_DATA_TYPE_BOOL, (void**)value);
 }
 
 int system_settings_set_value_double(system_settings_key_e key, double value)
@@ -209,7 +408,7 @@ int system_settings_set_value_double(system_settings_key_e key, double value)
 
 int system_settings_get_value_double(system_settings_key_e key, double *value)
 {
-	return system_settings_get_value(key, SYSTEM_SETTING_DATA_TYPE_DOUBLE, (void**)value);
+	return system_setting_get_value_recorded(key, SYSTEM_SETTING_DATA_TYPE_DOUBLE, (void**)value);
 }
 
 int system_settings_set_value_string(system_settings_key_e key, const char *value)
@@ -220,15 +419,188 @@ int system_settings_set_value_string(system_settings_key_e key, const char *valu
 
 int system_settings_get_value_string(system_settings_key_e key, char **value)
 {
-	return system_settings_get_value(key, SYSTEM_SETTING_DATA_TYPE_STRING, (void**)value);
+	return system_setting_get_value_recorded(key, SYSTEM_SETTING_DATA_TYPE_STRING, (void**)value);
 }
 
+int system_settings_compare_and_set_value_int(system_settings_key_e key, int expected, int value, int *current)
+{
+	return system_settings_compare_and_set_value(key, SYSTEM_SETTING_DATA_TYPE_INT, &expected, &value, (void**)current);
+}
 
-/*
-	- START
-		- system_settings_set_changed_cb
-			-> int (*system_setting_set_changed_callback_cb)(key, callback, user_data)
-*/
+int system_settings_compare_and_set_value_bool(system_settings_key_e key, bool expected, bool value, bool *current)
+{
+	return system_settings_compare_and_set_value(key, SYSTEM_SETTING_DATA_TYPE_BOOL, &expected, &value, (void**)current);
+}
+
+int system_settings_compare_and_set_value_double(system_settings_key_e key, double expected, double value, double *current)
+{
+	return system_settings_compare_and_set_value(key, SYSTEM_SETTING_DATA_TYPE_DOUBLE, &expected, &value, (void**)current);
+}
+
+int system_settings_compare_and_set_value_string(system_settings_key_e key, const char *expected, const char *value, char **current)
+{
+	return system_settings_compare_and_set_value(key, SYSTEM_SETTING_DATA_TYPE_STRING, (void*)expected, (void*)value, (void**)current);
+}
+
+
+G_LOCK_DEFINE_STATIC(system_setting_notify);
+
+int system_setting_notify_ref(system_setting_h item)
+{
+	int ret = SYSTEM_SETTINGS_ERROR_NONE;
+
+	G_LOCK(system_setting_notify);
+
+	if (item->notify_refcount == 0)
+	{
+		ret = system_setting_vconf_set_changed_cb(item->vconf_key, item->key);
+	}
+
+	if (ret == SYSTEM_SETTINGS_ERROR_NONE)
+	{
+		item->notify_refcount++;
+	}
+
+	G_UNLOCK(system_setting_notify);
+
+	return ret;
+}
+
+void system_setting_notify_unref(system_setting_h item)
+{
+	G_LOCK(system_setting_notify);
+
+	if (item->notify_refcount > 0 && --item->notify_refcount == 0)
+	{
+		system_setting_vconf_unset_changed_cb(item->vconf_key);
+	}
+
+	G_UNLOCK(system_setting_notify);
+}
+
+void *system_setting_notify_context_ref(system_setting_h item)
+{
+	GMainContext *context = NULL;
+
+	G_LOCK(system_setting_notify);
+
+	if (item->context != NULL)
+	{
+		context = g_main_context_ref(item->context);
+	}
+
+	G_UNLOCK(system_setting_notify);
+
+	return context;
+}
+
+void system_setting_notify_changed(system_settings_key_e key, const system_setting_value_s *value)
+{
+	system_setting_h system_setting_item;
+
+	if (system_settings_get_item(key, &system_setting_item))
+	{
+		LOGE("[%s] INVALID_PARAMETER(0x%08x) : invalid key", __FUNCTION__, SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER);
+		return;
+	}
+
+	system_setting_record_notify(key, value);
+	system_setting_snapshot_invalidate(key);
+	system_setting_group_notify(key);
+
+	if (!system_setting_dispatch(system_setting_item, value))
+	{
+		system_setting_notify_deliver(key, value);
+	}
+}
+
+typedef struct {
+	system_settings_value_changed_cb callback;
+	void *user_data;
+} system_setting_value_listener_s;
+
+#define SYSTEM_SETTING_VALUE_LISTENERS_INLINE 8
+
+static void system_setting_notify_deliver_value(system_setting_h item, const system_setting_value_s *value)
+{
+	system_setting_value_listener_s inline_listeners[SYSTEM_SETTING_VALUE_LISTENERS_INLINE];
+	system_setting_value_listener_s *listeners = inline_listeners;
+	system_setting_value_s read_value;
+	GList *l;
+	int count;
+	int i;
+
+	if (value == NULL)
+	{
+		/* the notification did not carry a usable value */
+		if (system_setting_value_get(item->key, &read_value) != SYSTEM_SETTINGS_ERROR_NONE)
+		{
+			return;
+		}
+	}
+
+	/* callbacks are invoked without the lock so that they can (un)register */
+	G_LOCK(system_setting_notify);
+
+	count = g_list_length(item->value_listeners);
+
+	if (count > SYSTEM_SETTING_VALUE_LISTENERS_INLINE)
+	{
+		listeners = g_new(system_setting_value_listener_s, count);
+	}
+
+	for (l = item->value_listeners, i = 0; l != NULL; l = l->next, i++)
+	{
+		listeners[i] = *(system_setting_value_listener_s*)l->data;
+	}
+
+	G_UNLOCK(system_setting_notify);
+
+	for (i = 0; i < count; i++)
+	{
+		listeners[i].callback(item->key, (system_settings_value_h)(value != NULL ? value : &read_value), listeners[i].user_data);
+	}
+
+	if (listeners != inline_listeners)
+	{
+		g_free(listeners);
+	}
+
+	if (value == NULL)
+	{
+		system_setting_value_clear(&read_value);
+	}
+}
+
+void system_setting_notify_deliver(system_settings_key_e key, const system_setting_value_s *value)
+{
+	system_setting_h system_setting_item;
+	system_settings_changed_cb changed_cb;
+	void *user_data;
+	bool has_value_listeners;
+
+	if (system_settings_get_item(key, &system_setting_item))
+	{
+		return;
+	}
+
+	/* read together, the callback is never called with the user data of another registration */
+	G_LOCK(system_setting_notify);
+	changed_cb = system_setting_item->changed_cb;
+	user_data = system_setting_item->user_data;
+	has_value_listeners = system_setting_item->value_listeners != NULL;
+	G_UNLOCK(system_setting_notify);
+
+	if (changed_cb != NULL)
+	{
+		changed_cb(key, user_data);
+	}
+
+	if (has_value_listeners)
+	{
+		system_setting_notify_deliver_value(system_setting_item, value);
+	}
+}
 
 /*PUBLIC*/
 int system_settings_set_changed_cb(system_settings_key_e key, system_settings_changed_cb callback, void *user_data)
@@ -236,27 +608,51 @@ int system_settings_set_changed_cb(system_settings_key_e key, system_settings_ch
 	printf("system_settings_set_changed_cb \n");
 
     system_setting_h system_setting_item;
-	system_setting_set_changed_callback_cb system_setting_set_changed_cb;
+	uint64_t begin = system_setting_record_begin();
+	GMainContext *previous_context;
+	bool replaced;
+	int ret;
 
-    if (system_settings_get_item(key, &system_setting_item))
+    if (system_settings_get_item(key, &system_setting_item) || callback == NULL)
     {
-        LOGE("[%s] INVALID_PARAMETER(0x%08x) : invalid key", __FUNCTION__, SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER);
+        LOGE("[%s] INVALID_PARAMETER(0x%08x) : invalid argument", __FUNCTION__, SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER);
         return SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER;
     }
 
-	system_setting_set_changed_cb = system_setting_item->set_changed_cb;
+	/* every registered callback holds a reference, the one of a replaced callback is dropped below */
+	ret = system_setting_notify_ref(system_setting_item);
+
+	if (ret != SYSTEM_SETTINGS_ERROR_NONE)
+	{
+		return ret;
+	}
+
+	system_setting_record_call(SYSTEM_SETTING_RECORD_SUBSCRIBE, key, system_setting_item->data_type, NULL, SYSTEM_SETTINGS_ERROR_NONE, begin);
 
 	// Store the callback function from application side
-	if (callback)
-		system_setting_item->changed_cb = callback;
+	G_LOCK(system_setting_notify);
 
-    if (system_setting_set_changed_cb == NULL)
-    {
-        LOGE("[%s] IO_ERROR(0x%08x) : failed to call getter for the system settings", __FUNCTION__, SYSTEM_SETTINGS_ERROR_IO_ERROR);
-        return SYSTEM_SETTINGS_ERROR_IO_ERROR;
-    }
+	replaced = system_setting_item->changed_cb != NULL;
+	system_setting_item->changed_cb = callback;
+	system_setting_item->user_data = user_data;
+
+	// the main loop dispatcher delivers on the loop of the registering thread
+	previous_context = system_setting_item->context;
+	system_setting_item->context = g_main_context_ref_thread_default();
+
+	G_UNLOCK(system_setting_notify);
+
+	if (previous_context != NULL)
+	{
+		g_main_context_unref(previous_context);
+	}
+
+	if (replaced)
+	{
+		system_setting_notify_unref(system_setting_item);
+	}
 
-	return system_setting_set_changed_cb(key, callback, user_data);
+	return SYSTEM_SETTINGS_ERROR_NONE;
 }
 
 
@@ -265,7 +661,8 @@ int system_settings_unset_changed_cb(system_settings_key_e key)
 	printf("system_settings_unset_changed_cb \n");
 
     system_setting_h system_setting_item;
-	system_setting_unset_changed_callback_cb system_setting_unset_changed_cb;
+	GMainContext *context = NULL;
+	bool unset = false;
 
     if (system_settings_get_item(key, &system_setting_item))
     {
@@ -273,19 +670,128 @@ int system_settings_unset_changed_cb(system_settings_key_e key)
         return SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER;
     }
 
-	system_setting_unset_changed_cb = system_setting_item->unset_changed_cb;
-
 	// free the callback function from application side
-	if (system_setting_item->changed_cb)
+	G_LOCK(system_setting_notify);
+
+	if (system_setting_item->changed_cb != NULL)
+	{
 		system_setting_item->changed_cb = NULL;
-	//-----------------------------------------------------
+		system_setting_item->user_data = NULL;
+		unset = true;
+
+		if (system_setting_item->value_listeners == NULL)
+		{
+			context = system_setting_item->context;
+			system_setting_item->context = NULL;
+		}
+	}
 
-    if (system_setting_unset_changed_cb == NULL)
-    {
-        LOGE("[%s] IO_ERROR(0x%08x) : failed to call getter for the system settings", __FUNCTION__, SYSTEM_SETTINGS_ERROR_IO_ERROR);
-        return SYSTEM_SETTINGS_ERROR_IO_ERROR;
-    }
+	G_UNLOCK(system_setting_notify);
+
+	if (context != NULL)
+	{
+		g_main_context_unref(context);
+	}
 
-	return system_setting_unset_changed_cb(key);
+	if (unset)
+	{
+		system_setting_notify_unref(system_setting_item);
+
+		system_setting_record_call(SYSTEM_SETTING_RECORD_UNSUBSCRIBE, key, system_setting_item->data_type, NULL, SYSTEM_SETTINGS_ERROR_NONE, system_setting_record_begin());
+	}
+
+	return SYSTEM_SETTINGS_ERROR_NONE;
 }
 
+int system_settings_add_value_changed_cb(system_settings_key_e key, system_settings_value_changed_cb callback, void *user_data)
+{
+	system_setting_h system_setting_item;
+	system_setting_value_listener_s *listener;
+	uint64_t begin = system_setting_record_begin();
+	int ret;
+
+	if (system_settings_get_item(key, &system_setting_item) || callback == NULL)
+	{
+		LOGE("[%s] INVALID_PARAMETER(0x%08x) : invalid argument", __FUNCTION__, SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER);
+		return SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER;
+	}
+
+	ret = system_setting_notify_ref(system_setting_item);
+
+	if (ret != SYSTEM_SETTINGS_ERROR_NONE)
+	{
+		return ret;
+	}
+
+	listener = g_new(system_setting_value_listener_s, 1);
+	listener->callback = callback;
+	listener->user_data = user_data;
+
+	G_LOCK(system_setting_notify);
+
+	system_setting_item->value_listeners = g_list_append(system_setting_item->value_listeners, listener);
+
+	if (system_setting_item->context == NULL)
+	{
+		system_setting_item->context = g_main_context_ref_thread_default();
+	}
+
+	G_UNLOCK(system_setting_notify);
+
+	system_setting_record_call(SYSTEM_SETTING_RECORD_SUBSCRIBE, key, system_setting_item->data_type, NULL, SYSTEM_SETTINGS_ERROR_NONE, begin);
+
+	return SYSTEM_SETTINGS_ERROR_NONE;
+}
+
+int system_settings_remove_value_changed_cb(system_settings_key_e key, system_settings_value_changed_cb callback)
+{
+	system_setting_h system_setting_item;
+	system_setting_value_listener_s *listener = NULL;
+	GMainContext *context = NULL;
+	GList *l;
+
+	if (system_settings_get_item(key, &system_setting_item) || callback == NULL)
+	{
+		LOGE("[%s] INVALID_PARAMETER(0x%08x) : invalid argument", __FUNCTION__, SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER);
+		return SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER;
+	}
+
+	G_LOCK(system_setting_notify);
+
+	for (l = system_setting_item->value_listeners; l != NULL; l = l->next)
+	{
+		if (((system_setting_value_listener_s*)l->data)->callback == callback)
+		{
+			listener = l->data;
+			system_setting_item->value_listeners = g_list_delete_link(system_setting_item->value_listeners, l);
+			break;
+		}
+	}
+
+	/* the reference taken by the first listener is dropped with the last one */
+	if (listener != NULL && system_setting_item->value_listeners == NULL && system_setting_item->changed_cb == NULL)
+	{
+		context = system_setting_item->context;
+		system_setting_item->context = NULL;
+	}
+
+	G_UNLOCK(system_setting_notify);
+
+	if (listener == NULL)
+	{
+		LOGE("[%s] INVALID_PARAMETER(0x%08x) : callback is not registered", __FUNCTION__, SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER);
+		return SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER;
+	}
+
+	if (context != NULL)
+	{
+		g_main_context_unref(context);
+	}
+
+	g_free(listener);
+	system_setting_notify_unref(system_setting_item);
+
+	system_setting_record_call(SYSTEM_SETTING_RECORD_UNSUBSCRIBE, key, system_setting_item->data_type, NULL, SYSTEM_SETTINGS_ERROR_NONE, system_setting_record_begin());
+
+	return SYSTEM_SETTINGS_ERROR_NONE;
+}
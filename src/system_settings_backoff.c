@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <dlog.h>
+#include <glib.h>
+
+#include <system_settings.h>
+#include <system_settings_private.h>
+
+#ifdef LOG_TAG
+#undef LOG_TAG
+#endif
+
+#define LOG_TAG "TIZEN_N_SYSTEM_SETTINGS"
+
+/* the first failure is cached this long, each further one doubles it */
+#define BACKOFF_MIN_US (20 * 1000)
+#define BACKOFF_MAX_US (2 * G_USEC_PER_SEC)
+
+
+/*
+ * Negative cache of the reads of a key. While a read failed recently, reads
+ * return the same error without going to the backend, until the backoff
+ * expires, the key is written or a change of the key is notified.
+ */
+typedef struct {
+	volatile gint failures;		/* consecutive failures, 0 while the key is healthy */
+	int error;
+	gint64 retry_at;			/* g_get_monotonic_time() after which the backend is read again */
+} system_setting_backoff_s;
+
+G_LOCK_DEFINE_STATIC(system_setting_backoff);
+
+static system_setting_backoff_s key_backoffs[SYSTEM_SETTINGS_KEY_COUNT];
+
+
+int system_setting_backoff_check(system_settings_key_e key)
+{
+	system_setting_backoff_s *backoff;
+	int ret = SYSTEM_SETTINGS_ERROR_NONE;
+
+	/* vendor keys are not cached */
+	if ((unsigned int)key >= SYSTEM_SETTINGS_KEY_COUNT)
+	{
+		return SYSTEM_SETTINGS_ERROR_NONE;
+	}
+
+	backoff = &key_backoffs[key];
+
+	if (!g_atomic_int_get(&backoff->failures))
+	{
+		return SYSTEM_SETTINGS_ERROR_NONE;
+	}
+
+	G_LOCK(system_setting_backoff);
+
+	if (backoff->failures && g_get_monotonic_time() < backoff->retry_at)
+	{
+		ret = backoff->error;
+	}
+
+	G_UNLOCK(system_setting_backoff);
+
+	if (ret != SYSTEM_SETTINGS_ERROR_NONE)
+	{
+		system_setting_stat_inc(SYSTEM_SETTINGS_STAT_READS_NEGATIVE_CACHED);
+	}
+
+	return ret;
+}
+
+void system_setting_backoff_failed(system_settings_key_e key, int error)
+{
+	system_setting_backoff_s *backoff;
+	gint64 delay;
+	int failures;
+
+	if ((unsigned int)key >= SYSTEM_SETTINGS_KEY_COUNT)
+	{
+		return;
+	}
+
+	backoff = &key_backoffs[key];
+
+	G_LOCK(system_setting_backoff);
+
+	failures = backoff->failures + 1;
+	delay = failures > 16 ? BACKOFF_MAX_US : MIN((gint64)BACKOFF_MIN_US << (failures - 1), BACKOFF_MAX_US);
+
+	backoff->error = error;
+	backoff->retry_at = g_get_monotonic_time() + delay;
+	g_atomic_int_set(&backoff->failures, failures);
+
+	G_UNLOCK(system_setting_backoff);
+}
+
+void system_setting_backoff_reset(system_settings_key_e key)
+{
+	if ((unsigned int)key >= SYSTEM_SETTINGS_KEY_COUNT || !g_atomic_int_get(&key_backoffs[key].failures))
+	{
+		return;
+	}
+
+	G_LOCK(system_setting_backoff);
+	g_atomic_int_set(&key_backoffs[key].failures, 0);
+	G_UNLOCK(system_setting_backoff);
+}
@@ -0,0 +1,551 @@
+/*
+ * Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <dlog.h>
+#include <glib.h>
+
+#include <system_settings.h>
+#include <system_settings_private.h>
+
+#ifdef LOG_TAG
+#undef LOG_TAG
+#endif
+
+#define LOG_TAG "TIZEN_N_SYSTEM_SETTINGS"
+
+
+/*
+ * A context stores the schema keys under its own vconf keys: the name of the
+ * context is inserted after the layer of the global key, so that
+ * "db/setting/font_size" is "db/<name>/setting/font_size" in the context.
+ *
+ * Each context caches the values it has read. A key is watched from its first
+ * read until the context is destroyed, and its notifications update the cache
+ * and invoke the callback of the key in this context only. The watches are
+ * reported to system_setting_backend_changed() under a watch key which
+ * identifies the context, see SYSTEM_SETTING_CONTEXT_WATCH_KEY().
+ */
+struct system_settings_context_s {
+	int id;
+	int ref_count;
+	bool destroyed;
+	char *name;
+
+	char *vconf_keys[SYSTEM_SETTINGS_KEY_COUNT];
+	bool watched[SYSTEM_SETTINGS_KEY_COUNT];
+
+	bool cached[SYSTEM_SETTINGS_KEY_COUNT];
+	unsigned int generation[SYSTEM_SETTINGS_KEY_COUNT];	/* incremented when the cached value becomes stale */
+	system_setting_value_s values[SYSTEM_SETTINGS_KEY_COUNT];
+
+	system_settings_context_changed_cb changed_cb[SYSTEM_SETTINGS_KEY_COUNT];
+	void *user_data[SYSTEM_SETTINGS_KEY_COUNT];
+};
+
+G_LOCK_DEFINE_STATIC(system_setting_context);
+
+/* live contexts by id */
+static GHashTable *contexts;
+static int next_context_id = 1;
+
+
+/* the name is inserted as path components, so it must be one */
+static bool system_setting_context_name_valid(const char *name)
+{
+	const char *p;
+
+	if (name == NULL || name[0] == '\0' || name[0] == '/' || name[strlen(name) - 1] == '/'
+		|| strstr(name, "//") != NULL || strstr(name, "..") != NULL)
+	{
+		return false;
+	}
+
+	for (p = name; *p != '\0'; p++)
+	{
+		if (!g_ascii_isalnum(*p) && strchr("_-./", *p) == NULL)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+static char *system_setting_context_vconf_key(const char *name, const char *vconf_key)
+{
+	const char *path = strchr(vconf_key, '/');
+
+	if (path == NULL)
+	{
+		return g_strdup_printf("%s/%s", name, vconf_key);
+	}
+
+	return g_strdup_printf("%.*s/%s%s", (int)(path - vconf_key), vconf_key, name, path);
+}
+
+static gboolean system_setting_context_name_equal(gpointer id, gpointer context, gpointer name)
+{
+	return !strcmp(((system_settings_context_h)context)->name, name);
+}
+
+/* called with the lock held */
+static void system_setting_context_unref(system_settings_context_h context)
+{
+	int key;
+
+	if (--context->ref_count > 0)
+	{
+		return;
+	}
+
+	for (key = 0; key < SYSTEM_SETTINGS_KEY_COUNT; key++)
+	{
+		system_setting_value_clear(&context->values[key]);
+		g_free(context->vconf_keys[key]);
+	}
+
+	g_free(context->name);
+	g_free(context);
+}
+
+/*PUBLIC*/
+int system_settings_context_create(const char *name, system_settings_context_h *context)
+{
+	system_settings_context_h new_context;
+	system_setting_h system_setting_item;
+	int key;
+
+	if (!system_setting_context_name_valid(name) || context == NULL)
+	{
+		LOGE("[%s] INVALID_PARAMETER(0x%08x) : invalid argument", __FUNCTION__, SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER);
+		return SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER;
+	}
+
+	new_context = g_try_new0(struct system_settings_context_s, 1);
+
+	if (new_context == NULL)
+	{
+		LOGE("[%s] OUT_OF_MEMORY(0x%08x)", __FUNCTION__, SYSTEM_SETTINGS_ERROR_OUT_OF_MEMORY);
+		return SYSTEM_SETTINGS_ERROR_OUT_OF_MEMORY;
+	}
+
+	new_context->ref_count = 1;
+	new_context->name = g_strdup(name);
+
+	for (key = 0; key < SYSTEM_SETTINGS_KEY_COUNT; key++)
+	{
+		system_settings_get_item(key, &system_setting_item);
+		new_context->vconf_keys[key] = system_setting_context_vconf_key(name, system_setting_item->vconf_key);
+	}
+
+	G_LOCK(system_setting_context);
+
+	if (next_context_id > SYSTEM_SETTING_CONTEXT_ID_MAX)
+	{
+		G_UNLOCK(system_setting_context);
+		system_setting_context_unref(new_context);
+		LOGE("[%s] OUT_OF_MEMORY(0x%08x) : no context id left", __FUNCTION__, SYSTEM_SETTINGS_ERROR_OUT_OF_MEMORY);
+		return SYSTEM_SETTINGS_ERROR_OUT_OF_MEMORY;
+	}
+
+	if (contexts == NULL)
+	{
+		contexts = g_hash_table_new(g_direct_hash, g_direct_equal);
+	}
+
+	/* the watches of two contexts of the same name would replace each other */
+	if (g_hash_table_find(contexts, system_setting_context_name_equal, (gpointer)name) != NULL)
+	{
+		G_UNLOCK(system_setting_context);
+		system_setting_context_unref(new_context);
+		LOGE("[%s] INVALID_PARAMETER(0x%08x) : context %s exists", __FUNCTION__, SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER, name);
+		return SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER;
+	}
+
+	new_context->id = next_context_id++;
+	g_hash_table_insert(contexts, GINT_TO_POINTER(new_context->id), new_context);
+
+	G_UNLOCK(system_setting_context);
+
+	*context = new_context;
+
+	return SYSTEM_SETTINGS_ERROR_NONE;
+}
+
+int system_settings_context_destroy(system_settings_context_h context)
+{
+	int key;
+
+	if (context == NULL)
+	{
+		LOGE("[%s] INVALID_PARAMETER(0x%08x) : invalid context", __FUNCTION__, SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER);
+		return SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER;
+	}
+
+	G_LOCK(system_setting_context);
+
+	g_hash_table_remove(contexts, GINT_TO_POINTER(context->id));
+	context->destroyed = true;
+
+	for (key = 0; key < SYSTEM_SETTINGS_KEY_COUNT; key++)
+	{
+		if (context->watched[key])
+		{
+			system_setting_vconf_unset_changed_cb(context->vconf_keys[key]);
+			context->watched[key] = false;
+		}
+	}
+
+	/* callbacks being invoked hold their own reference */
+	system_setting_context_unref(context);
+
+	G_UNLOCK(system_setting_context);
+
+	return SYSTEM_SETTINGS_ERROR_NONE;
+}
+
+void system_setting_context_changed(system_settings_key_e watch_key, const system_setting_value_s *value)
+{
+	system_settings_context_h context;
+	system_settings_context_changed_cb changed_cb = NULL;
+	void *user_data = NULL;
+	int key = SYSTEM_SETTING_CONTEXT_WATCH_ITEM(watch_key);
+
+	if (key >= SYSTEM_SETTINGS_KEY_COUNT)
+	{
+		return;
+	}
+
+	G_LOCK(system_setting_context);
+
+	context = contexts != NULL ? g_hash_table_lookup(contexts, GINT_TO_POINTER(SYSTEM_SETTING_CONTEXT_WATCH_ID(watch_key))) : NULL;
+
+	if (context == NULL)
+	{
+		G_UNLOCK(system_setting_context);
+		return;
+	}
+
+	context->generation[key]++;
+	system_setting_value_clear(&context->values[key]);
+	context->cached[key] = false;
+
+	if (value != NULL)
+	{
+		system_setting_value_copy(&context->values[key], value);
+		context->cached[key] = true;
+	}
+
+	changed_cb = context->changed_cb[key];
+	user_data = context->user_data[key];
+	context->ref_count++;
+
+	G_UNLOCK(system_setting_context);
+
+	if (changed_cb != NULL)
+	{
+		changed_cb(context, key, user_data);
+	}
+
+	G_LOCK(system_setting_context);
+	system_setting_context_unref(context);
+	G_UNLOCK(system_setting_context);
+}
+
+/* called with the lock held, the cache of a key is only trusted while it is watched */
+static int system_setting_context_watch(system_settings_context_h context, system_settings_key_e key)
+{
+	int ret;
+
+	if (context->watched[key])
+	{
+		return SYSTEM_SETTINGS_ERROR_NONE;
+	}
+
+	ret = system_setting_vconf_set_changed_cb(context->vconf_keys[key], SYSTEM_SETTING_CONTEXT_WATCH_KEY(context->id, key));
+
+	if (ret == SYSTEM_SETTINGS_ERROR_NONE)
+	{
+		context->watched[key] = true;
+	}
+
+	return ret;
+}
+
+static int system_setting_context_check(system_settings_context_h context, system_settings_key_e key,
+		system_setting_data_type_e data_type, system_setting_h *item)
+{
+	if (context == NULL || (unsigned int)key >= SYSTEM_SETTINGS_KEY_COUNT)
+	{
+		LOGE("[%s] INVALID_PARAMETER(0x%08x) : invalid argument", __FUNCTION__, SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER);
+		return SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER;
+	}
+
+	system_settings_get_item(key, item);
+
+	if ((*item)->data_type != data_type)
+	{
+		LOGE("[%s] INVALID_PARAMETER(0x%08x) : invalid data type", __FUNCTION__, SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER);
+		return SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER;
+	}
+
+	return SYSTEM_SETTINGS_ERROR_NONE;
+}
+
+/* a STRING value is returned as a copy to be freed */
+static int system_setting_context_get_value(system_settings_context_h context, system_settings_key_e key,
+		system_setting_data_type_e data_type, system_setting_value_s *value)
+{
+	system_setting_h system_setting_item;
+	system_setting_value_s read_value;
+	unsigned int generation;
+	bool cache;
+	int ret;
+
+	ret = system_setting_context_check(context, key, data_type, &system_setting_item);
+
+	if (ret != SYSTEM_SETTINGS_ERROR_NONE)
+	{
+		return ret;
+	}
+
+	G_LOCK(system_setting_context);
+
+	if (context->cached[key])
+	{
+		system_setting_value_copy(value, &context->values[key]);
+		G_UNLOCK(system_setting_context);
+		return SYSTEM_SETTINGS_ERROR_NONE;
+	}
+
+	cache = system_setting_context_watch(context, key) == SYSTEM_SETTINGS_ERROR_NONE;
+	generation = context->generation[key];
+
+	G_UNLOCK(system_setting_context);
+
+	memset(&read_value, 0, sizeof(read_value));
+	read_value.data_type = data_type;
+
+	if (system_setting_vconf_get_value(context->vconf_keys[key], data_type, (void**)&read_value.value))
+	{
+		LOGE("[%s] IO_ERROR(0x%08x) : failed to get the vconf value", __FUNCTION__, SYSTEM_SETTINGS_ERROR_IO_ERROR);
+		return SYSTEM_SETTINGS_ERROR_IO_ERROR;
+	}
+
+	G_LOCK(system_setting_context);
+
+	/* a change notified during the read has its own value */
+	if (cache && context->generation[key] == generation && !context->cached[key])
+	{
+		system_setting_value_copy(&context->values[key], &read_value);
+		context->cached[key] = true;
+	}
+
+	G_UNLOCK(system_setting_context);
+
+	*value = read_value;
+
+	return SYSTEM_SETTINGS_ERROR_NONE;
+}
+
+static int system_setting_context_set_value(system_settings_context_h context, system_settings_key_e key,
+		system_setting_data_type_e data_type, void *value)
+{
+	system_setting_h system_setting_item;
+	int ret;
+
+	ret = system_setting_context_check(context, key, data_type, &system_setting_item);
+
+	if (ret != SYSTEM_SETTINGS_ERROR_NONE)
+	{
+		return ret;
+	}
+
+	if (data_type == SYSTEM_SETTING_DATA_TYPE_INT && system_setting_item->min < system_setting_item->max
+		&& (*(int*)value < system_setting_item->min || *(int*)value > system_setting_item->max))
+	{
+		LOGE("[%s] INVALID_PARAMETER(0x%08x) : out of range", __FUNCTION__, SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER);
+		return SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER;
+	}
+
+	/* the check and apply hooks of the global keys are not run, a context only stores values */
+	if (system_setting_vconf_set_value(context->vconf_keys[key], data_type, value))
+	{
+		LOGE("[%s] IO_ERROR(0x%08x) : failed to set the vconf value", __FUNCTION__, SYSTEM_SETTINGS_ERROR_IO_ERROR);
+		return SYSTEM_SETTINGS_ERROR_IO_ERROR;
+	}
+
+	G_LOCK(system_setting_context);
+	context->generation[key]++;
+	system_setting_value_clear(&context->values[key]);
+	context->cached[key] = false;
+	G_UNLOCK(system_setting_context);
+
+	return SYSTEM_SETTINGS_ERROR_NONE;
+}
+
+int system_settings_context_get_value_int(system_settings_context_h context, system_settings_key_e key, int *value)
+{
+	system_setting_value_s context_value;
+	int ret;
+
+	if (value == NULL)
+	{
+		LOGE("[%s] INVALID_PARAMETER(0x%08x) : invalid value", __FUNCTION__, SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER);
+		return SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER;
+	}
+
+	ret = system_setting_context_get_value(context, key, SYSTEM_SETTING_DATA_TYPE_INT, &context_value);
+
+	if (ret == SYSTEM_SETTINGS_ERROR_NONE)
+	{
+		*value = context_value.value.i;
+	}
+	return ret;
+}
+
+int system_settings_context_get_value_bool(system_settings_context_h context, system_settings_key_e key, bool *value)
+{
+	system_setting_value_s context_value;
+	int ret;
+
+	if (value == NULL)
+	{
+		LOGE("[%s] INVALID_PARAMETER(0x%08x) : invalid value", __FUNCTION__, SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER);
+		return SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER;
+	}
+
+	ret = system_setting_context_get_value(context, key, SYSTEM_SETTING_DATA_TYPE_BOOL, &context_value);
+
+	if (ret == SYSTEM_SETTINGS_ERROR_NONE)
+	{
+		*value = context_value.value.b;
+	}
+	return ret;
+}
+
+int system_settings_context_get_value_double(system_settings_context_h context, system_settings_key_e key, double *value)
+{
+	system_setting_value_s context_value;
+	int ret;
+
+	if (value == NULL)
+	{
+		LOGE("[%s] INVALID_PARAMETER(0x%08x) : invalid value", __FUNCTION__, SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER);
+		return SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER;
+	}
+
+	ret = system_setting_context_get_value(context, key, SYSTEM_SETTING_DATA_TYPE_DOUBLE, &context_value);
+
+	if (ret == SYSTEM_SETTINGS_ERROR_NONE)
+	{
+		*value = context_value.value.d;
+	}
+	return ret;
+}
+
+int system_settings_context_get_value_string(system_settings_context_h context, system_settings_key_e key, char **value)
+{
+	system_setting_value_s context_value;
+	int ret;
+
+	if (value == NULL)
+	{
+		LOGE("[%s] INVALID_PARAMETER(0x%08x) : invalid value", __FUNCTION__, SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER);
+		return SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER;
+	}
+
+	ret = system_setting_context_get_value(context, key, SYSTEM_SETTING_DATA_TYPE_STRING, &context_value);
+
+	if (ret == SYSTEM_SETTINGS_ERROR_NONE)
+	{
+		*value = context_value.value.s;
+	}
+	return ret;
+}
+
+int system_settings_context_set_value_int(system_settings_context_h context, system_settings_key_e key, int value)
+{
+	return system_setting_context_set_value(context, key, SYSTEM_SETTING_DATA_TYPE_INT, &value);
+}
+
+int system_settings_context_set_value_bool(system_settings_context_h context, system_settings_key_e key, bool value)
+{
+	return system_setting_context_set_value(context, key, SYSTEM_SETTING_DATA_TYPE_BOOL, &value);
+}
+
+int system_settings_context_set_value_double(system_settings_context_h context, system_settings_key_e key, double value)
+{
+	return system_setting_context_set_value(context, key, SYSTEM_SETTING_DATA_TYPE_DOUBLE, &value);
+}
+
+int system_settings_context_set_value_string(system_settings_context_h context, system_settings_key_e key, const char *value)
+{
+	if (value == NULL)
+	{
+		LOGE("[%s] INVALID_PARAMETER(0x%08x) : invalid value", __FUNCTION__, SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER);
+		return SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER;
+	}
+
+	return system_setting_context_set_value(context, key, SYSTEM_SETTING_DATA_TYPE_STRING, (void*)value);
+}
+
+int system_settings_context_set_changed_cb(system_settings_context_h context, system_settings_key_e key,
+		system_settings_context_changed_cb callback, void *user_data)
+{
+	int ret;
+
+	if (context == NULL || (unsigned int)key >= SYSTEM_SETTINGS_KEY_COUNT || callback == NULL)
+	{
+		LOGE("[%s] INVALID_PARAMETER(0x%08x) : invalid argument", __FUNCTION__, SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER);
+		return SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER;
+	}
+
+	G_LOCK(system_setting_context);
+
+	ret = system_setting_context_watch(context, key);
+
+	if (ret == SYSTEM_SETTINGS_ERROR_NONE)
+	{
+		context->changed_cb[key] = callback;
+		context->user_data[key] = user_data;
+	}
+
+	G_UNLOCK(system_setting_context);
+
+	return ret;
+}
+
+int system_settings_context_unset_changed_cb(system_settings_context_h context, system_settings_key_e key)
+{
+	if (context == NULL || (unsigned int)key >= SYSTEM_SETTINGS_KEY_COUNT)
+	{
+		LOGE("[%s] INVALID_PARAMETER(0x%08x) : invalid argument", __FUNCTION__, SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER);
+		return SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER;
+	}
+
+	/* the key stays watched for the cache */
+	G_LOCK(system_setting_context);
+	context->changed_cb[key] = NULL;
+	context->user_data[key] = NULL;
+	G_UNLOCK(system_setting_context);
+
+	return SYSTEM_SETTINGS_ERROR_NONE;
+}
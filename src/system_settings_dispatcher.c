@@ -0,0 +1,372 @@
+/*
+ * Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <semaphore.h>
+
+#include <dlog.h>
+#include <glib.h>
+
+#include <system_settings.h>
+#include <system_settings_private.h>
+
+#ifdef LOG_TAG
+#undef LOG_TAG
+#endif
+
+#define LOG_TAG "TIZEN_N_SYSTEM_SETTINGS"
+
+#define SYSTEM_SETTING_DISPATCH_WORKERS 2
+
+/* events of a key delivered before its drain goes back to a worker, so that a hot key does not hold one */
+#define SYSTEM_SETTING_DISPATCH_BATCH 64
+
+
+/*
+ * Intrusive multi-producer single-consumer queue (D. Vyukov).
+ * Producers never block; the consumer may briefly see a push in progress.
+ */
+typedef struct system_setting_mpsc_node_s {
+	struct system_setting_mpsc_node_s *volatile next;
+} system_setting_mpsc_node_s;
+
+typedef struct {
+	system_setting_mpsc_node_s *volatile head;		/* last pushed */
+	system_setting_mpsc_node_s *tail;				/* next to pop, consumer only */
+	system_setting_mpsc_node_s stub;
+} system_setting_mpsc_queue_s;
+
+/* notification of one key, queued until it is delivered */
+typedef struct {
+	system_setting_mpsc_node_s node;
+	system_settings_key_e key;
+	bool has_value;
+	system_setting_value_s value;					/* owned copy */
+} system_setting_dispatch_event_s;
+
+/*
+ * Pending notifications of one key. At most one drain of a key runs at a
+ * time, which keeps the delivery of a key in order. A key is bound to a
+ * worker only while a drain of it is scheduled, each drain goes to the worker
+ * with the fewest drains.
+ */
+struct system_setting_dispatch_queue_s {
+	system_setting_mpsc_node_s job;					/* queued on a worker while scheduled */
+	system_setting_mpsc_queue_s events;
+	volatile gint scheduled;
+	system_setting_h item;
+};
+
+typedef struct {
+	system_setting_mpsc_queue_s jobs;
+	sem_t wakeup;
+	volatile gint load;								/* drains queued or running */
+} system_setting_dispatch_worker_s;
+
+
+static volatile gint dispatch_mode = SYSTEM_SETTINGS_DISPATCH_SYNC;
+static system_setting_dispatch_worker_s dispatch_workers[SYSTEM_SETTING_DISPATCH_WORKERS];
+
+
+static void system_setting_mpsc_init(system_setting_mpsc_queue_s *queue)
+{
+	queue->stub.next = NULL;
+	queue->head = &queue->stub;
+	queue->tail = &queue->stub;
+}
+
+static void system_setting_mpsc_push(system_setting_mpsc_queue_s *queue, system_setting_mpsc_node_s *node)
+{
+	system_setting_mpsc_node_s *prev;
+
+	node->next = NULL;
+
+	do {
+		prev = g_atomic_pointer_get(&queue->head);
+	} while (!g_atomic_pointer_compare_and_exchange(&queue->head, prev, node));
+
+	g_atomic_pointer_set(&prev->next, node);
+}
+
+static system_setting_mpsc_node_s *system_setting_mpsc_pop(system_setting_mpsc_queue_s *queue)
+{
+	system_setting_mpsc_node_s *tail = queue->tail;
+	system_setting_mpsc_node_s *next = g_atomic_pointer_get(&tail->next);
+
+	if (tail == &queue->stub)
+	{
+		if (next == NULL)
+		{
+			return NULL;
+		}
+		queue->tail = next;
+		tail = next;
+		next = g_atomic_pointer_get(&next->next);
+	}
+
+	if (next != NULL)
+	{
+		queue->tail = next;
+		return tail;
+	}
+
+	if (tail != g_atomic_pointer_get(&queue->head))
+	{
+		/* a push is in progress */
+		return NULL;
+	}
+
+	system_setting_mpsc_push(queue, &queue->stub);
+
+	next = g_atomic_pointer_get(&tail->next);
+
+	if (next != NULL)
+	{
+		queue->tail = next;
+		return tail;
+	}
+
+	return NULL;
+}
+
+/*
+ * Consumer only. Once the stub is passed, tail is a node not popped yet even
+ * when it is also the head, so the queue is empty only while both are the stub.
+ */
+static gboolean system_setting_mpsc_empty(system_setting_mpsc_queue_s *queue)
+{
+	return queue->tail == &queue->stub && g_atomic_pointer_get(&queue->head) == &queue->stub;
+}
+
+
+/* returns TRUE when the batch ran out with events left, the drain is then still scheduled */
+static gboolean system_setting_dispatch_drain(struct system_setting_dispatch_queue_s *queue)
+{
+	system_setting_dispatch_event_s *event;
+	int delivered = 0;
+
+	do {
+		while (1)
+		{
+			if (delivered == SYSTEM_SETTING_DISPATCH_BATCH)
+			{
+				return TRUE;
+			}
+
+			event = (system_setting_dispatch_event_s*)system_setting_mpsc_pop(&queue->events);
+
+			if (event == NULL)
+			{
+				if (system_setting_mpsc_empty(&queue->events))
+				{
+					break;
+				}
+
+				/* a push is in progress */
+				g_thread_yield();
+				continue;
+			}
+
+			system_setting_notify_deliver(event->key, event->has_value ? &event->value : NULL);
+			system_setting_value_clear(&event->value);
+			g_free(event);
+			delivered++;
+		}
+
+		g_atomic_int_set(&queue->scheduled, 0);
+
+		/* an event pushed after the last pop but before the flag was cleared is ours */
+	} while (!system_setting_mpsc_empty(&queue->events)
+			&& g_atomic_int_compare_and_exchange(&queue->scheduled, 0, 1));
+
+	return FALSE;
+}
+
+/* the idle source stays while the key has events left, other sources run between its batches */
+static gboolean system_setting_dispatch_idle_cb(gpointer data)
+{
+	return system_setting_dispatch_drain(data);
+}
+
+static void system_setting_dispatch_to_worker(struct system_setting_dispatch_queue_s *queue)
+{
+	system_setting_dispatch_worker_s *worker = &dispatch_workers[0];
+	int i;
+
+	for (i = 1; i < SYSTEM_SETTING_DISPATCH_WORKERS; i++)
+	{
+		if (g_atomic_int_get(&dispatch_workers[i].load) < g_atomic_int_get(&worker->load))
+		{
+			worker = &dispatch_workers[i];
+		}
+	}
+
+	g_atomic_int_inc(&worker->load);
+	system_setting_mpsc_push(&worker->jobs, &queue->job);
+	sem_post(&worker->wakeup);
+}
+
+static gpointer system_setting_dispatch_worker_main(gpointer data)
+{
+	system_setting_dispatch_worker_s *worker = data;
+	system_setting_mpsc_node_s *job;
+	gboolean more;
+
+	while (1)
+	{
+		if (sem_wait(&worker->wakeup))
+		{
+			continue;
+		}
+
+		while ((job = system_setting_mpsc_pop(&worker->jobs)) == NULL)
+		{
+			g_thread_yield();
+		}
+
+		more = system_setting_dispatch_drain((struct system_setting_dispatch_queue_s*)job);
+		g_atomic_int_add(&worker->load, -1);
+
+		/* the rest of a hot key goes to the least loaded worker, which may be another one */
+		if (more)
+		{
+			system_setting_dispatch_to_worker((struct system_setting_dispatch_queue_s*)job);
+		}
+	}
+
+	return NULL;
+}
+
+static void system_setting_dispatch_start_workers(void)
+{
+	static gsize workers_started = 0;
+	int i;
+
+	if (g_once_init_enter(&workers_started))
+	{
+		for (i = 0; i < SYSTEM_SETTING_DISPATCH_WORKERS; i++)
+		{
+			system_setting_mpsc_init(&dispatch_workers[i].jobs);
+			sem_init(&dispatch_workers[i].wakeup, 0, 0);
+			g_thread_unref(g_thread_new("system-settings", system_setting_dispatch_worker_main, &dispatch_workers[i]));
+		}
+		g_once_init_leave(&workers_started, 1);
+	}
+}
+
+static struct system_setting_dispatch_queue_s *system_setting_dispatch_get_queue(system_setting_h item)
+{
+	struct system_setting_dispatch_queue_s *queue = g_atomic_pointer_get(&item->dispatch_queue);
+
+	if (queue != NULL)
+	{
+		return queue;
+	}
+
+	queue = g_new0(struct system_setting_dispatch_queue_s, 1);
+	system_setting_mpsc_init(&queue->events);
+	queue->item = item;
+
+	if (!g_atomic_pointer_compare_and_exchange(&item->dispatch_queue, NULL, queue))
+	{
+		g_free(queue);
+		queue = g_atomic_pointer_get(&item->dispatch_queue);
+	}
+
+	return queue;
+}
+
+static void system_setting_dispatch_schedule(struct system_setting_dispatch_queue_s *queue, int mode)
+{
+	GMainContext *context;
+	GSource *source;
+
+	if (mode == SYSTEM_SETTINGS_DISPATCH_MAIN_LOOP)
+	{
+		/* the context of the item is replaced when a callback is set from another thread */
+		context = system_setting_notify_context_ref(queue->item);
+
+		source = g_idle_source_new();
+		g_source_set_callback(source, system_setting_dispatch_idle_cb, queue, NULL);
+		g_source_attach(source, context);
+		g_source_unref(source);
+
+		if (context != NULL)
+		{
+			g_main_context_unref(context);
+		}
+		return;
+	}
+
+	system_setting_dispatch_to_worker(queue);
+}
+
+int system_setting_dispatch(system_setting_h item, const system_setting_value_s *value)
+{
+	struct system_setting_dispatch_queue_s *queue;
+	system_setting_dispatch_event_s *event;
+	int mode = g_atomic_int_get(&dispatch_mode);
+
+	if (mode == SYSTEM_SETTINGS_DISPATCH_SYNC)
+	{
+		return FALSE;
+	}
+
+	queue = system_setting_dispatch_get_queue(item);
+
+	event = g_new0(system_setting_dispatch_event_s, 1);
+	event->key = item->key;
+
+	if (value != NULL)
+	{
+		system_setting_value_copy(&event->value, value);
+		event->has_value = true;
+	}
+
+	system_setting_mpsc_push(&queue->events, &event->node);
+
+	if (g_atomic_int_compare_and_exchange(&queue->scheduled, 0, 1))
+	{
+		system_setting_dispatch_schedule(queue, mode);
+	}
+
+	return TRUE;
+}
+
+/*PUBLIC*/
+int system_settings_set_dispatch_mode(system_settings_dispatch_mode_e mode)
+{
+	switch (mode)
+	{
+	case SYSTEM_SETTINGS_DISPATCH_WORKER:
+		system_setting_dispatch_start_workers();
+		break;
+
+	case SYSTEM_SETTINGS_DISPATCH_SYNC:
+	case SYSTEM_SETTINGS_DISPATCH_MAIN_LOOP:
+		break;
+
+	default:
+		LOGE("[%s] INVALID_PARAMETER(0x%08x) : invalid mode", __FUNCTION__, SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER);
+		return SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER;
+	}
+
+	g_atomic_int_set(&dispatch_mode, mode);
+
+	return SYSTEM_SETTINGS_ERROR_NONE;
+}
@@ -0,0 +1,325 @@
+/*
+ * Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include <dlog.h>
+#include <glib.h>
+
+#include <system_settings.h>
+#include <system_settings_private.h>
+#include <system_settings_backend_private.h>
+
+#ifdef LOG_TAG
+#undef LOG_TAG
+#endif
+
+#define LOG_TAG "TIZEN_N_SYSTEM_SETTINGS"
+
+
+/* notification waiting for its injected delay */
+typedef struct {
+	system_settings_key_e key;
+	bool has_value;
+	system_setting_value_s value;			/* owned copy */
+} system_setting_fault_notification_s;
+
+G_LOCK_DEFINE_STATIC(system_setting_fault);
+
+static GHashTable *fault_keys;				/* vconf key -> system_setting_fault_s */
+static system_setting_fault_s fault_default;
+static bool has_fault_default;
+
+static GMainContext *fault_notify_context;
+
+/* notify hook of the memory backend replaced while faults are set, restored when none is left */
+static system_setting_backend_notify_cb fault_previous_notify;
+static bool fault_notify_installed;
+
+
+/* returns false when the key has no fault */
+static bool system_setting_fault_get(const char *vconf_key, system_setting_fault_s *fault)
+{
+	system_setting_fault_s *key_fault = NULL;
+	bool found;
+
+	G_LOCK(system_setting_fault);
+
+	if (fault_keys != NULL && vconf_key != NULL)
+	{
+		key_fault = g_hash_table_lookup(fault_keys, vconf_key);
+	}
+
+	found = key_fault != NULL || has_fault_default;
+
+	if (found)
+	{
+		*fault = key_fault != NULL ? *key_fault : fault_default;
+	}
+
+	G_UNLOCK(system_setting_fault);
+
+	return found;
+}
+
+static void system_setting_fault_delay(const system_setting_fault_s *fault)
+{
+	double latency_us;
+
+	switch (fault->latency_distribution)
+	{
+	case SYSTEM_SETTING_FAULT_LATENCY_UNIFORM:
+		latency_us = g_random_double() * fault->latency_us;
+		break;
+
+	case SYSTEM_SETTING_FAULT_LATENCY_EXPONENTIAL:
+		latency_us = -log(1.0 - g_random_double()) * fault->latency_us;
+		break;
+
+	case SYSTEM_SETTING_FAULT_LATENCY_CONSTANT:
+	default:
+		latency_us = fault->latency_us;
+		break;
+	}
+
+	if (fault->stall_rate > 0 && g_random_double() < fault->stall_rate)
+	{
+		latency_us += fault->stall_us;
+	}
+
+	if (latency_us >= 1)
+	{
+		g_usleep((gulong)latency_us);
+	}
+}
+
+static int system_setting_fault_get_value(const char *vconf_key, system_setting_data_type_e data_type, system_setting_value_s *value)
+{
+	system_setting_fault_s fault;
+
+	if (system_setting_fault_get(vconf_key, &fault))
+	{
+		system_setting_fault_delay(&fault);
+
+		if (fault.read_error_rate > 0 && g_random_double() < fault.read_error_rate)
+		{
+			memset(value, 0, sizeof(*value));
+			return -1;
+		}
+	}
+
+	return system_setting_backend_memory.get_value(vconf_key, data_type, value);
+}
+
+static int system_setting_fault_set_value(const char *vconf_key, const system_setting_value_s *value)
+{
+	system_setting_fault_s fault;
+
+	if (system_setting_fault_get(vconf_key, &fault))
+	{
+		system_setting_fault_delay(&fault);
+
+		if (fault.write_error_rate > 0 && g_random_double() < fault.write_error_rate)
+		{
+			return -1;
+		}
+	}
+
+	return system_setting_backend_memory.set_value(vconf_key, value);
+}
+
+static int system_setting_fault_compare_and_set(const char *vconf_key, const system_setting_value_s *expected, const system_setting_value_s *value,
+	system_setting_value_s *current)
+{
+	system_setting_fault_s fault;
+
+	if (system_setting_fault_get(vconf_key, &fault))
+	{
+		system_setting_fault_delay(&fault);
+
+		if (fault.write_error_rate > 0 && g_random_double() < fault.write_error_rate)
+		{
+			return -1;
+		}
+	}
+
+	return system_setting_backend_memory.compare_and_set(vconf_key, expected, value, current);
+}
+
+static gpointer system_setting_fault_notify_main(gpointer data)
+{
+	GMainLoop *loop = g_main_loop_new(fault_notify_context, FALSE);
+
+	g_main_loop_run(loop);
+	g_main_loop_unref(loop);
+
+	return NULL;
+}
+
+static gboolean system_setting_fault_notify_cb(gpointer data)
+{
+	system_setting_fault_notification_s *notification = data;
+
+	system_setting_backend_notify_cb notify = (system_setting_backend_notify_cb)g_atomic_pointer_get(&fault_previous_notify);
+
+	notify(notification->key, notification->has_value ? &notification->value : NULL);
+
+	return FALSE;
+}
+
+static void system_setting_fault_notification_free(gpointer data)
+{
+	system_setting_fault_notification_s *notification = data;
+
+	system_setting_value_clear(&notification->value);
+	g_free(notification);
+}
+
+/*
+ * Delayed notifications are delivered from a thread of their own. Notifications
+ * of a key keep their order as long as the delay of the key does not change.
+ */
+static void system_setting_fault_notify(system_settings_key_e key, const system_setting_value_s *value)
+{
+	static gsize notify_thread_started = 0;
+	system_setting_fault_notification_s *notification;
+	system_setting_fault_s fault;
+	system_setting_h system_setting_item;
+	GSource *source;
+
+	if (system_settings_get_item(key, &system_setting_item)
+		|| !system_setting_fault_get(system_setting_item->vconf_key, &fault)
+		|| fault.notify_delay_us == 0)
+	{
+		((system_setting_backend_notify_cb)g_atomic_pointer_get(&fault_previous_notify))(key, value);
+		return;
+	}
+
+	if (g_once_init_enter(&notify_thread_started))
+	{
+		fault_notify_context = g_main_context_new();
+		g_thread_unref(g_thread_new("system-settings-fault", system_setting_fault_notify_main, NULL));
+		g_once_init_leave(&notify_thread_started, 1);
+	}
+
+	notification = g_new0(system_setting_fault_notification_s, 1);
+	notification->key = key;
+
+	if (value != NULL)
+	{
+		system_setting_value_copy(&notification->value, value);
+		notification->has_value = true;
+	}
+
+	source = g_timeout_source_new((fault.notify_delay_us + 999) / 1000);
+	g_source_set_callback(source, system_setting_fault_notify_cb, notification, system_setting_fault_notification_free);
+	g_source_attach(source, fault_notify_context);
+	g_source_unref(source);
+}
+
+static int system_setting_fault_watch(const char *vconf_key, system_settings_key_e key)
+{
+	return system_setting_backend_memory.watch(vconf_key, key);
+}
+
+static int system_setting_fault_unwatch(const char *vconf_key)
+{
+	return system_setting_backend_memory.unwatch(vconf_key);
+}
+
+/* called with the lock held */
+static void system_setting_fault_update_notify(void)
+{
+	bool active = has_fault_default || (fault_keys != NULL && g_hash_table_size(fault_keys) > 0);
+
+	if (active && !fault_notify_installed)
+	{
+		g_atomic_pointer_set(&fault_previous_notify, system_setting_backend_memory_get_notify());
+		system_setting_backend_memory_set_notify(system_setting_fault_notify);
+		fault_notify_installed = true;
+	}
+	else if (!active && fault_notify_installed)
+	{
+		/* delayed notifications still pending go to the previous hook as well */
+		system_setting_backend_memory_set_notify(g_atomic_pointer_get(&fault_previous_notify));
+		fault_notify_installed = false;
+	}
+}
+
+void system_setting_backend_fault_set(const char *vconf_key, const system_setting_fault_s *fault)
+{
+	system_setting_fault_s *copy;
+
+	G_LOCK(system_setting_fault);
+
+	if (vconf_key == NULL)
+	{
+		if (fault != NULL)
+		{
+			fault_default = *fault;
+		}
+		has_fault_default = fault != NULL;
+	}
+	else
+	{
+		if (fault_keys == NULL)
+		{
+			fault_keys = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, g_free);
+		}
+
+		if (fault != NULL)
+		{
+			copy = g_new(system_setting_fault_s, 1);
+			memcpy(copy, fault, sizeof(*copy));
+			g_hash_table_insert(fault_keys, g_strdup(vconf_key), copy);
+		}
+		else
+		{
+			g_hash_table_remove(fault_keys, vconf_key);
+		}
+	}
+
+	system_setting_fault_update_notify();
+
+	G_UNLOCK(system_setting_fault);
+}
+
+void system_setting_backend_fault_reset(void)
+{
+	G_LOCK(system_setting_fault);
+
+	if (fault_keys != NULL)
+	{
+		g_hash_table_remove_all(fault_keys);
+	}
+	has_fault_default = false;
+
+	system_setting_fault_update_notify();
+
+	G_UNLOCK(system_setting_fault);
+}
+
+const system_setting_backend_s system_setting_backend_fault = {
+	.name = "fault",
+	.get_value = system_setting_fault_get_value,
+	.set_value = system_setting_fault_set_value,
+	.compare_and_set = system_setting_fault_compare_and_set,
+	.watch = system_setting_fault_watch,
+	.unwatch = system_setting_fault_unwatch,
+};
@@ -0,0 +1,618 @@
+/*
+ * Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include <dlog.h>
+#include <glib.h>
+#include <fontconfig/fontconfig.h>
+#include <libxml/parser.h>
+
+#include <system_settings.h>
+#include <system_settings_private.h>
+#include <system_settings_font_index_private.h>
+
+#ifdef LOG_TAG
+#undef LOG_TAG
+#endif
+
+#define LOG_TAG "TIZEN_N_SYSTEM_SETTINGS"
+
+#define FONT_INDEX_DIR "/opt/var/cache/system-settings"
+
+/* the font directories are stat-ed at most once per interval */
+#define FONT_INDEX_CHECK_INTERVAL_US G_USEC_PER_SEC
+
+
+/* the index in use, replaced when it becomes stale while readers still hold it */
+typedef struct {
+	const system_setting_font_index_header_s *header;
+	size_t size;
+	bool mapped;
+	int ref_count;
+} system_setting_font_index_s;
+
+G_LOCK_DEFINE_STATIC(system_setting_font_index);
+
+static system_setting_font_index_s *font_index;
+static gint64 font_index_checked;						/* monotonic time of the last staleness check */
+
+
+#define FONT_INDEX_STAMPS(header) \
+	((const system_setting_font_index_stamp_s*)((header) + 1))
+#define FONT_INDEX_FAMILIES(header) \
+	((const system_setting_font_index_family_s*)(FONT_INDEX_STAMPS(header) + (header)->stamp_count))
+#define FONT_INDEX_BUCKETS(header) \
+	((const uint32_t*)(FONT_INDEX_FAMILIES(header) + (header)->family_count))
+#define FONT_INDEX_STRINGS(header) \
+	((const char*)(header) + (header)->strings_offset)
+
+
+/* next character of a family name, folded to lower case with blanks skipped */
+static inline unsigned char system_setting_font_index_next(const char **name)
+{
+	while (**name == ' ')
+	{
+		(*name)++;
+	}
+
+	return **name ? g_ascii_tolower(*(*name)++) : '\0';
+}
+
+static uint32_t system_setting_font_index_hash(const char *name)
+{
+	uint32_t hash = 2166136261u;
+	unsigned char c;
+
+	while ((c = system_setting_font_index_next(&name)) != '\0')
+	{
+		hash = (hash ^ c) * 16777619u;
+	}
+
+	return hash;
+}
+
+static bool system_setting_font_index_equal(const char *a, const char *b)
+{
+	unsigned char c;
+
+	do
+	{
+		c = system_setting_font_index_next(&a);
+
+		if (c != system_setting_font_index_next(&b))
+		{
+			return false;
+		}
+	} while (c != '\0');
+
+	return true;
+}
+
+static bool system_setting_font_index_valid(const system_setting_font_index_header_s *header, size_t size)
+{
+	const system_setting_font_index_stamp_s *stamps;
+	const system_setting_font_index_family_s *families;
+	size_t tables_end;
+	uint32_t i;
+
+	if (size < sizeof(*header)
+		|| header->magic != SYSTEM_SETTING_FONT_INDEX_MAGIC
+		|| header->version != SYSTEM_SETTING_FONT_INDEX_VERSION
+		|| header->bucket_count <= header->family_count
+		|| (header->bucket_count & (header->bucket_count - 1)))
+	{
+		return false;
+	}
+
+	tables_end = sizeof(*header)
+		+ (size_t)header->stamp_count * sizeof(system_setting_font_index_stamp_s)
+		+ (size_t)header->family_count * sizeof(system_setting_font_index_family_s)
+		+ (size_t)header->bucket_count * sizeof(uint32_t);
+
+	if (header->strings_size == 0
+		|| header->strings_offset < tables_end
+		|| header->strings_offset > size
+		|| header->strings_size > size - header->strings_offset
+		|| FONT_INDEX_STRINGS(header)[header->strings_size - 1] != '\0')
+	{
+		return false;
+	}
+
+	stamps = FONT_INDEX_STAMPS(header);
+	families = FONT_INDEX_FAMILIES(header);
+
+	for (i = 0; i < header->stamp_count; i++)
+	{
+		if (stamps[i].path >= header->strings_size)
+		{
+			return false;
+		}
+	}
+
+	for (i = 0; i < header->family_count; i++)
+	{
+		if (families[i].name >= header->strings_size)
+		{
+			return false;
+		}
+	}
+
+	for (i = 0; i < header->bucket_count; i++)
+	{
+		if (FONT_INDEX_BUCKETS(header)[i] > header->family_count)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+static void system_setting_font_index_stat(const char *path, int64_t *sec, int64_t *nsec)
+{
+	struct stat st;
+
+	if (stat(path, &st))
+	{
+		*sec = -1;
+		*nsec = -1;
+		return;
+	}
+
+	*sec = st.st_mtim.tv_sec;
+	*nsec = st.st_mtim.tv_nsec;
+}
+
+/* a font directory or a configuration file changed since the index was built */
+static bool system_setting_font_index_stale(const system_setting_font_index_header_s *header)
+{
+	const system_setting_font_index_stamp_s *stamps = FONT_INDEX_STAMPS(header);
+	int64_t sec, nsec;
+	uint32_t i;
+
+	for (i = 0; i < header->stamp_count; i++)
+	{
+		system_setting_font_index_stat(FONT_INDEX_STRINGS(header) + stamps[i].path, &sec, &nsec);
+
+		if (sec != stamps[i].mtime_sec || nsec != stamps[i].mtime_nsec)
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+static system_setting_font_index_s *system_setting_font_index_map(void)
+{
+	system_setting_font_index_s *index;
+	struct stat st;
+	void *map;
+	int fd;
+
+	fd = open(SYSTEM_SETTING_FONT_INDEX_FILE, O_RDONLY | O_CLOEXEC);
+
+	if (fd < 0)
+	{
+		return NULL;
+	}
+
+	if (fstat(fd, &st) || st.st_size <= 0)
+	{
+		close(fd);
+		return NULL;
+	}
+
+	map = mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+	close(fd);
+
+	if (map == MAP_FAILED)
+	{
+		return NULL;
+	}
+
+	if (!system_setting_font_index_valid(map, st.st_size) || system_setting_font_index_stale(map))
+	{
+		munmap(map, st.st_size);
+		return NULL;
+	}
+
+	index = g_new0(system_setting_font_index_s, 1);
+	index->header = map;
+	index->size = st.st_size;
+	index->mapped = true;
+	index->ref_count = 1;
+
+	return index;
+}
+
+/* families declared by <alias> elements, e.g. "Sans", are valid font types but are not listed by fontconfig */
+static void system_setting_font_index_add_aliases(GHashTable *flags, GPtrArray *aliases, const char *path)
+{
+	xmlDocPtr doc;
+	xmlNodePtr cur;
+	xmlNodePtr family;
+	xmlChar *name;
+	char *alias;
+	struct stat st;
+
+	/* the list also holds configuration directories */
+	if (stat(path, &st) || !S_ISREG(st.st_mode))
+	{
+		return;
+	}
+
+	doc = xmlReadFile(path, NULL, XML_PARSE_NONET | XML_PARSE_NOERROR | XML_PARSE_NOWARNING);
+
+	if (doc == NULL)
+	{
+		return;
+	}
+
+	cur = xmlDocGetRootElement(doc);
+
+	for (cur = cur != NULL ? cur->xmlChildrenNode : NULL; cur != NULL; cur = cur->next)
+	{
+		if (xmlStrcmp(cur->name, (const xmlChar *)"alias"))
+		{
+			continue;
+		}
+
+		for (family = cur->xmlChildrenNode; family != NULL; family = family->next)
+		{
+			if (!xmlStrcmp(family->name, (const xmlChar *)"family"))
+			{
+				break;
+			}
+		}
+
+		name = family != NULL ? xmlNodeListGetString(doc, family->xmlChildrenNode, 1) : NULL;
+
+		if (name != NULL && *name != '\0' && g_hash_table_lookup(flags, name) == NULL)
+		{
+			alias = g_strdup((const char *)name);
+			g_ptr_array_add(aliases, alias);
+			g_hash_table_insert(flags, alias, GUINT_TO_POINTER(SYSTEM_SETTING_FONT_INDEX_ALIAS));
+		}
+
+		xmlFree(name);
+	}
+
+	xmlFreeDoc(doc);
+}
+
+static void system_setting_font_index_add_stamps(GArray *stamps, GByteArray *strings, FcStrList *paths,
+	GHashTable *flags, GPtrArray *aliases)
+{
+	system_setting_font_index_stamp_s stamp;
+	FcChar8 *path;
+
+	if (paths == NULL)
+	{
+		return;
+	}
+
+	while ((path = FcStrListNext(paths)) != NULL)
+	{
+		memset(&stamp, 0, sizeof(stamp));
+		stamp.path = strings->len;
+		system_setting_font_index_stat((const char*)path, &stamp.mtime_sec, &stamp.mtime_nsec);
+		g_byte_array_append(strings, path, strlen((const char*)path) + 1);
+		g_array_append_val(stamps, stamp);
+
+		if (flags != NULL)
+		{
+			system_setting_font_index_add_aliases(flags, aliases, (const char*)path);
+		}
+	}
+
+	FcStrListDone(paths);
+}
+
+static void system_setting_font_index_collect(gpointer name, gpointer flags, gpointer names)
+{
+	g_ptr_array_add(names, name);
+}
+
+static gint system_setting_font_index_compare(gconstpointer a, gconstpointer b)
+{
+	return g_ascii_strcasecmp(*(const char* const*)a, *(const char* const*)b);
+}
+
+/* scans the installed fonts, the index is returned even if it cannot be saved */
+static system_setting_font_index_s *system_setting_font_index_build(void)
+{
+	system_setting_font_index_header_s header;
+	system_setting_font_index_family_s family;
+	system_setting_font_index_s *index;
+	GArray *stamps;
+	GByteArray *strings;
+	GByteArray *file;
+	GHashTable *flags;
+	GPtrArray *aliases;
+	GPtrArray *names;
+	FcPattern *pattern;
+	FcObjectSet *objects;
+	FcFontSet *fonts;
+	FcChar8 *name;
+	uint32_t *buckets;
+	uint32_t mask;
+	uint32_t slot;
+	int i, n;
+
+	if (!FcInit())
+	{
+		return NULL;
+	}
+
+	FcInitBringUptoDate();
+
+	stamps = g_array_new(FALSE, FALSE, sizeof(system_setting_font_index_stamp_s));
+	strings = g_byte_array_new();
+	g_byte_array_append(strings, (const guint8*)"", 1);
+
+	/* family name -> flags, the keys are owned by fontconfig until the set is destroyed, or by aliases */
+	flags = g_hash_table_new(g_str_hash, g_str_equal);
+	aliases = g_ptr_array_new_with_free_func(g_free);
+
+	system_setting_font_index_add_stamps(stamps, strings, FcConfigGetFontDirs(NULL), NULL, NULL);
+	system_setting_font_index_add_stamps(stamps, strings, FcConfigGetConfigFiles(NULL), flags, aliases);
+
+	pattern = FcPatternCreate();
+	objects = FcObjectSetBuild(FC_FAMILY, (char *)NULL);
+	fonts = FcFontList(NULL, pattern, objects);
+
+	for (i = 0; fonts != NULL && i < fonts->nfont; i++)
+	{
+		for (n = 0; FcPatternGetString(fonts->fonts[i], FC_FAMILY, n, &name) == FcResultMatch; n++)
+		{
+			g_hash_table_insert(flags, name, GUINT_TO_POINTER(GPOINTER_TO_UINT(g_hash_table_lookup(flags, name))
+				| (n == 0 ? SYSTEM_SETTING_FONT_INDEX_PRIMARY : SYSTEM_SETTING_FONT_INDEX_LOCALIZED)));
+		}
+	}
+
+	names = g_ptr_array_new();
+	g_hash_table_foreach(flags, system_setting_font_index_collect, names);
+	g_ptr_array_sort(names, system_setting_font_index_compare);
+
+	memset(&header, 0, sizeof(header));
+	header.magic = SYSTEM_SETTING_FONT_INDEX_MAGIC;
+	header.version = SYSTEM_SETTING_FONT_INDEX_VERSION;
+	header.stamp_count = stamps->len;
+	header.family_count = names->len;
+
+	for (header.bucket_count = 16; header.bucket_count < 2 * header.family_count; header.bucket_count <<= 1)
+		;
+
+	buckets = g_new0(uint32_t, header.bucket_count);
+	mask = header.bucket_count - 1;
+
+	file = g_byte_array_new();
+	g_byte_array_append(file, (const guint8*)&header, sizeof(header));
+	g_byte_array_append(file, (const guint8*)stamps->data, stamps->len * sizeof(system_setting_font_index_stamp_s));
+
+	for (i = 0; i < (int)names->len; i++)
+	{
+		memset(&family, 0, sizeof(family));
+		family.name = strings->len;
+		family.hash = system_setting_font_index_hash(names->pdata[i]);
+		family.flags = GPOINTER_TO_UINT(g_hash_table_lookup(flags, names->pdata[i]));
+		g_byte_array_append(strings, names->pdata[i], strlen(names->pdata[i]) + 1);
+		g_byte_array_append(file, (const guint8*)&family, sizeof(family));
+
+		for (slot = family.hash & mask; buckets[slot] != 0; slot = (slot + 1) & mask)
+			;
+		buckets[slot] = i + 1;
+	}
+
+	g_byte_array_append(file, (const guint8*)buckets, header.bucket_count * sizeof(uint32_t));
+
+	((system_setting_font_index_header_s*)file->data)->strings_offset = file->len;
+	((system_setting_font_index_header_s*)file->data)->strings_size = strings->len;
+	g_byte_array_append(file, strings->data, strings->len);
+
+	/* written to a temporary file and renamed, readers never see a partial index */
+	if (g_mkdir_with_parents(FONT_INDEX_DIR, 0755)
+		|| !g_file_set_contents(SYSTEM_SETTING_FONT_INDEX_FILE, (const gchar*)file->data, file->len, NULL))
+	{
+		LOGE("[%s] IO_ERROR(0x%08x) : failed to save %s", __FUNCTION__, SYSTEM_SETTINGS_ERROR_IO_ERROR, SYSTEM_SETTING_FONT_INDEX_FILE);
+	}
+
+	index = g_new0(system_setting_font_index_s, 1);
+	index->size = file->len;
+	index->header = (const system_setting_font_index_header_s*)g_byte_array_free(file, FALSE);
+	index->ref_count = 1;
+
+	g_free(buckets);
+	g_ptr_array_free(names, TRUE);
+	g_hash_table_destroy(flags);
+	g_ptr_array_free(aliases, TRUE);
+	if (fonts != NULL)
+	{
+		FcFontSetDestroy(fonts);
+	}
+	FcObjectSetDestroy(objects);
+	FcPatternDestroy(pattern);
+	g_byte_array_free(strings, TRUE);
+	g_array_free(stamps, TRUE);
+
+	return index;
+}
+
+/* called with the lock held */
+static void system_setting_font_index_unref(system_setting_font_index_s *index)
+{
+	if (--index->ref_count > 0)
+	{
+		return;
+	}
+
+	if (index->mapped)
+	{
+		munmap((void*)index->header, index->size);
+	}
+	else
+	{
+		g_free((void*)index->header);
+	}
+
+	g_free(index);
+}
+
+static system_setting_font_index_s *system_setting_font_index_acquire(void)
+{
+	system_setting_font_index_s *index;
+	gint64 now = g_get_monotonic_time();
+
+	G_LOCK(system_setting_font_index);
+
+	if (font_index != NULL && now - font_index_checked >= FONT_INDEX_CHECK_INTERVAL_US)
+	{
+		font_index_checked = now;
+
+		if (system_setting_font_index_stale(font_index->header))
+		{
+			system_setting_font_index_unref(font_index);
+			font_index = NULL;
+		}
+	}
+
+	/* a mapped index was checked when mapped, a built one is current */
+	if (font_index == NULL)
+	{
+		font_index = system_setting_font_index_map();
+		font_index_checked = now;
+	}
+
+	if (font_index == NULL)
+	{
+		font_index = system_setting_font_index_build();
+	}
+
+	index = font_index;
+
+	if (index != NULL)
+	{
+		index->ref_count++;
+	}
+
+	G_UNLOCK(system_setting_font_index);
+
+	return index;
+}
+
+static void system_setting_font_index_release(system_setting_font_index_s *index)
+{
+	G_LOCK(system_setting_font_index);
+	system_setting_font_index_unref(index);
+	G_UNLOCK(system_setting_font_index);
+}
+
+static bool system_setting_font_index_contains(const system_setting_font_index_header_s *header, const char *font_name)
+{
+	const system_setting_font_index_family_s *families = FONT_INDEX_FAMILIES(header);
+	const uint32_t *buckets = FONT_INDEX_BUCKETS(header);
+	uint32_t hash = system_setting_font_index_hash(font_name);
+	uint32_t mask = header->bucket_count - 1;
+	uint32_t slot;
+
+	for (slot = hash & mask; buckets[slot] != 0; slot = (slot + 1) & mask)
+	{
+		if (families[buckets[slot] - 1].hash == hash
+			&& system_setting_font_index_equal(FONT_INDEX_STRINGS(header) + families[buckets[slot] - 1].name, font_name))
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+// [string] rejects families that are not installed before the overlays are changed
+int system_setting_check_font_type(system_settings_key_e key, system_setting_data_type_e data_type, void* value)
+{
+	system_setting_font_index_s *index;
+	bool found;
+
+	if (value == NULL)
+	{
+		LOGE("[%s] INVALID_PARAMETER(0x%08x) : invalid argument", __FUNCTION__, SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER);
+		return SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER;
+	}
+
+	index = system_setting_font_index_acquire();
+
+	/* without fontconfig the name cannot be checked, it is accepted as before */
+	if (index == NULL)
+	{
+		return SYSTEM_SETTINGS_ERROR_NONE;
+	}
+
+	found = system_setting_font_index_contains(index->header, value);
+	system_setting_font_index_release(index);
+
+	if (!found)
+	{
+		LOGE("[%s] INVALID_PARAMETER(0x%08x) : font %s is not installed", __FUNCTION__, SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER, (const char*)value);
+		return SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER;
+	}
+
+	return SYSTEM_SETTINGS_ERROR_NONE;
+}
+
+/*PUBLIC*/
+int system_settings_foreach_font(system_settings_font_cb callback, void *user_data)
+{
+	const system_setting_font_index_family_s *families;
+	system_setting_font_index_s *index;
+	uint32_t i;
+
+	if (callback == NULL)
+	{
+		LOGE("[%s] INVALID_PARAMETER(0x%08x) : invalid argument", __FUNCTION__, SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER);
+		return SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER;
+	}
+
+	index = system_setting_font_index_acquire();
+
+	if (index == NULL)
+	{
+		LOGE("[%s] IO_ERROR(0x%08x) : no font index", __FUNCTION__, SYSTEM_SETTINGS_ERROR_IO_ERROR);
+		return SYSTEM_SETTINGS_ERROR_IO_ERROR;
+	}
+
+	families = FONT_INDEX_FAMILIES(index->header);
+
+	for (i = 0; i < index->header->family_count; i++)
+	{
+		if ((families[i].flags & SYSTEM_SETTING_FONT_INDEX_PRIMARY)
+			&& !callback(FONT_INDEX_STRINGS(index->header) + families[i].name, user_data))
+		{
+			break;
+		}
+	}
+
+	system_setting_font_index_release(index);
+
+	return SYSTEM_SETTINGS_ERROR_NONE;
+}
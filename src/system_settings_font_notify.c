@@ -0,0 +1,278 @@
+/*
+ * Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <semaphore.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+#include <dlog.h>
+#include <glib.h>
+
+#include <Ecore.h>
+#include <Ecore_X.h>
+
+#include <system_settings.h>
+#include <system_settings_private.h>
+#include <system_settings_trace_private.h>
+
+#ifdef LOG_TAG
+#undef LOG_TAG
+#endif
+
+#define LOG_TAG "TIZEN_N_SYSTEM_SETTINGS"
+
+/* font changes posted within this window after a broadcast are sent together at its end */
+#define FONT_NOTIFY_COALESCE_US (50 * 1000)
+
+
+typedef struct {
+	const char *name;
+	system_setting_font_transport_e transport;
+	void (*broadcast)(void);
+} system_setting_font_transport_s;
+
+static volatile gint font_transports = -1;
+static sem_t font_notify_wakeup;
+
+G_LOCK_DEFINE_STATIC(font_notify);
+static gint64 font_notify_window_end;
+static gboolean font_notify_pending;
+
+
+static void system_setting_font_transport_x_set(void *data)
+{
+	static gsize x_resolved = 0;
+	static Ecore_X_Window root;
+	static Ecore_X_Atom atom;
+
+	/* resolved once, every later change costs a single property write */
+	if (g_once_init_enter(&x_resolved))
+	{
+		root = ecore_x_window_root_first_get();
+		atom = ecore_x_atom_get(SYSTEM_SETTING_FONT_NOTIFY_MESSAGE);
+		g_once_init_leave(&x_resolved, 1);
+	}
+
+	ecore_x_window_prop_string_set(root, atom, "slp");
+}
+
+/*
+ * Ecore X may only be used from the main loop thread. The call runs at once
+ * when made from it, and is queued to it from the notify thread.
+ */
+static void system_setting_font_transport_x(void)
+{
+	ecore_main_loop_thread_safe_call_async(system_setting_font_transport_x_set, NULL);
+}
+
+static void system_setting_font_transport_vconf(void)
+{
+	int count = 0;
+
+	system_setting_vconf_get_value_int(VCONFKEY_SETAPPL_FONT_CHANGED_INT, &count);
+	system_setting_vconf_set_value_int(VCONFKEY_SETAPPL_FONT_CHANGED_INT, count + 1);
+}
+
+static void system_setting_font_transport_socket(void)
+{
+	static gsize socket_created = 0;
+	static int fd = -1;
+	struct sockaddr_un addr;
+	struct dirent *entry;
+	DIR *dir;
+
+	if (g_once_init_enter(&socket_created))
+	{
+		fd = socket(AF_UNIX, SOCK_DGRAM | SOCK_CLOEXEC | SOCK_NONBLOCK, 0);
+		g_once_init_leave(&socket_created, 1);
+	}
+
+	dir = opendir(SYSTEM_SETTING_FONT_NOTIFY_SOCKET_DIR);
+
+	if (fd < 0 || dir == NULL)
+	{
+		if (dir != NULL)
+		{
+			closedir(dir);
+		}
+		return;
+	}
+
+	memset(&addr, 0, sizeof(addr));
+	addr.sun_family = AF_UNIX;
+
+	while ((entry = readdir(dir)) != NULL)
+	{
+		if (entry->d_name[0] == '.'
+			|| snprintf(addr.sun_path, sizeof(addr.sun_path), "%s/%s", SYSTEM_SETTING_FONT_NOTIFY_SOCKET_DIR, entry->d_name) >= (int)sizeof(addr.sun_path))
+		{
+			continue;
+		}
+
+		/* a socket that refuses it is skipped, it belongs to its listener and is left for it to remove */
+		sendto(fd, SYSTEM_SETTING_FONT_NOTIFY_MESSAGE, sizeof(SYSTEM_SETTING_FONT_NOTIFY_MESSAGE) - 1, MSG_NOSIGNAL,
+			(struct sockaddr*)&addr, sizeof(addr));
+	}
+
+	closedir(dir);
+}
+
+static const system_setting_font_transport_s font_transport_table[] = {
+	{ "x", SYSTEM_SETTING_FONT_TRANSPORT_X, system_setting_font_transport_x },
+	{ "vconf", SYSTEM_SETTING_FONT_TRANSPORT_VCONF, system_setting_font_transport_vconf },
+	{ "socket", SYSTEM_SETTING_FONT_TRANSPORT_SOCKET, system_setting_font_transport_socket },
+};
+
+static unsigned int system_setting_font_transports_from_env(void)
+{
+	const char *env = getenv(SYSTEM_SETTING_FONT_NOTIFY_ENV);
+	unsigned int transports = 0;
+	char **names;
+	int i, j;
+
+	if (env == NULL)
+	{
+		return SYSTEM_SETTING_FONT_TRANSPORT_X;
+	}
+
+	names = g_strsplit(env, ",", -1);
+
+	for (i = 0; names[i] != NULL; i++)
+	{
+		for (j = 0; j < (int)G_N_ELEMENTS(font_transport_table); j++)
+		{
+			if (!strcmp(g_strstrip(names[i]), font_transport_table[j].name))
+			{
+				transports |= font_transport_table[j].transport;
+			}
+		}
+	}
+
+	g_strfreev(names);
+
+	return transports;
+}
+
+static void system_setting_font_notify_broadcast(void)
+{
+	unsigned int transports = g_atomic_int_get(&font_transports);
+	int i;
+
+	SYSTEM_SETTING_TRACE(font_notify_entry);
+
+	for (i = 0; i < (int)G_N_ELEMENTS(font_transport_table); i++)
+	{
+		if (transports & font_transport_table[i].transport)
+		{
+			font_transport_table[i].broadcast();
+		}
+	}
+
+	SYSTEM_SETTING_TRACE(font_notify_return);
+}
+
+/*
+ * Sends the changes that arrived within the coalescing window as one
+ * broadcast when the window ends, which opens the next window.
+ */
+static gpointer system_setting_font_notify_main(gpointer data)
+{
+	gint64 window_end;
+	gint64 now;
+
+	while (1)
+	{
+		if (sem_wait(&font_notify_wakeup))
+		{
+			continue;
+		}
+
+		G_LOCK(font_notify);
+		window_end = font_notify_window_end;
+		G_UNLOCK(font_notify);
+
+		now = g_get_monotonic_time();
+
+		if (window_end > now)
+		{
+			g_usleep(window_end - now);
+		}
+
+		G_LOCK(font_notify);
+		font_notify_pending = FALSE;
+		font_notify_window_end = g_get_monotonic_time() + FONT_NOTIFY_COALESCE_US;
+		G_UNLOCK(font_notify);
+
+		system_setting_font_notify_broadcast();
+	}
+
+	return NULL;
+}
+
+void system_setting_font_set_transports(unsigned int transports)
+{
+	g_atomic_int_set(&font_transports, transports);
+}
+
+/*
+ * The first change of a burst is broadcast by the caller before it returns,
+ * so a process that exits right after the change still sends it. The changes
+ * that follow within the coalescing window are left to the notify thread.
+ */
+void system_setting_font_notify(void)
+{
+	static gsize notify_started = 0;
+	gboolean broadcast_now = FALSE;
+	gboolean wakeup = FALSE;
+	gint64 now;
+
+	if (g_once_init_enter(&notify_started))
+	{
+		g_atomic_int_compare_and_exchange(&font_transports, -1, system_setting_font_transports_from_env());
+		sem_init(&font_notify_wakeup, 0, 0);
+		g_thread_unref(g_thread_new("system-settings-notify", system_setting_font_notify_main, NULL));
+		g_once_init_leave(&notify_started, 1);
+	}
+
+	G_LOCK(font_notify);
+	now = g_get_monotonic_time();
+
+	if (now >= font_notify_window_end)
+	{
+		font_notify_window_end = now + FONT_NOTIFY_COALESCE_US;
+		broadcast_now = TRUE;
+	}
+	else if (!font_notify_pending)
+	{
+		font_notify_pending = TRUE;
+		wakeup = TRUE;
+	}
+	G_UNLOCK(font_notify);
+
+	if (broadcast_now)
+	{
+		system_setting_font_notify_broadcast();
+	}
+	else if (wakeup)
+	{
+		sem_post(&font_notify_wakeup);
+	}
+}
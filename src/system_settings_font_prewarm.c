@@ -0,0 +1,172 @@
+/*
+ * Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <semaphore.h>
+
+#include <dlog.h>
+#include <glib.h>
+#include <fontconfig/fontconfig.h>
+
+#include <system_settings.h>
+#include <system_settings_private.h>
+#include <system_settings_trace_private.h>
+
+#ifdef LOG_TAG
+#undef LOG_TAG
+#endif
+
+#define LOG_TAG "TIZEN_N_SYSTEM_SETTINGS"
+
+/* fonts of the fallback chain, after the family itself, that are touched */
+#define FONT_PREWARM_FALLBACKS 8
+
+
+/*
+ * Every application resolves the new family through fontconfig as soon as the
+ * font type change is notified. The prewarm thread does the same resolution
+ * first, so that the fontconfig caches and the font files are in the page
+ * cache by then. Requests are coalesced, only the latest font is prewarmed.
+ */
+G_LOCK_DEFINE_STATIC(system_setting_font_prewarm);
+
+static char *prewarm_pending;
+static sem_t prewarm_wakeup;
+
+
+/* starts an asynchronous read ahead of the whole file */
+static void system_setting_font_prewarm_file(FcPattern *font)
+{
+	FcChar8 *file;
+	int fd;
+
+	if (FcPatternGetString(font, FC_FILE, 0, &file) != FcResultMatch)
+	{
+		return;
+	}
+
+	fd = open((const char *)file, O_RDONLY);
+
+	if (fd >= 0)
+	{
+		posix_fadvise(fd, 0, 0, POSIX_FADV_WILLNEED);
+		close(fd);
+	}
+}
+
+static void system_setting_font_prewarm_family(const char *font_name)
+{
+	FcPattern *pattern;
+	FcObjectSet *objects;
+	FcFontSet *fonts;
+	FcResult result;
+	int i;
+
+	SYSTEM_SETTING_TRACE1(font_prewarm_entry, font_name);
+
+	/* reloads the configuration if it changed and maps the caches, as applications will */
+	FcInitBringUptoDate();
+
+	pattern = FcPatternCreate();
+	FcPatternAddString(pattern, FC_FAMILY, (const FcChar8 *)font_name);
+
+	/* every style of the family, the slp text classes use several of them */
+	objects = FcObjectSetBuild(FC_FILE, (char *)NULL);
+	fonts = FcFontList(NULL, pattern, objects);
+
+	if (fonts != NULL)
+	{
+		for (i = 0; i < fonts->nfont; i++)
+		{
+			system_setting_font_prewarm_file(fonts->fonts[i]);
+		}
+		FcFontSetDestroy(fonts);
+	}
+
+	FcObjectSetDestroy(objects);
+
+	/* the fonts applications fall back to for the glyphs the family lacks */
+	FcConfigSubstitute(NULL, pattern, FcMatchPattern);
+	FcDefaultSubstitute(pattern);
+	fonts = FcFontSort(NULL, pattern, FcTrue, NULL, &result);
+
+	if (fonts != NULL)
+	{
+		for (i = 0; i < fonts->nfont && i <= FONT_PREWARM_FALLBACKS; i++)
+		{
+			system_setting_font_prewarm_file(fonts->fonts[i]);
+		}
+		FcFontSetDestroy(fonts);
+	}
+
+	FcPatternDestroy(pattern);
+
+	SYSTEM_SETTING_TRACE(font_prewarm_return);
+}
+
+static gpointer system_setting_font_prewarm_main(gpointer data)
+{
+	char *font_name;
+
+	while (1)
+	{
+		if (sem_wait(&prewarm_wakeup))
+		{
+			continue;
+		}
+
+		G_LOCK(system_setting_font_prewarm);
+		font_name = prewarm_pending;
+		prewarm_pending = NULL;
+		G_UNLOCK(system_setting_font_prewarm);
+
+		if (font_name != NULL)
+		{
+			system_setting_font_prewarm_family(font_name);
+			g_free(font_name);
+		}
+	}
+
+	return NULL;
+}
+
+void system_setting_font_prewarm(const char *font_name)
+{
+	static gsize prewarm_started = 0;
+
+	if (font_name == NULL)
+	{
+		return;
+	}
+
+	if (g_once_init_enter(&prewarm_started))
+	{
+		sem_init(&prewarm_wakeup, 0, 0);
+		g_thread_unref(g_thread_new("system-settings-font", system_setting_font_prewarm_main, NULL));
+		g_once_init_leave(&prewarm_started, 1);
+	}
+
+	G_LOCK(system_setting_font_prewarm);
+	g_free(prewarm_pending);
+	prewarm_pending = g_strdup(font_name);
+	G_UNLOCK(system_setting_font_prewarm);
+
+	sem_post(&prewarm_wakeup);
+}
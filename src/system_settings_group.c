@@ -0,0 +1,253 @@
+/*
+ * Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <dlog.h>
+#include <glib.h>
+
+#include <system_settings.h>
+#include <system_settings_private.h>
+
+#ifdef LOG_TAG
+#undef LOG_TAG
+#endif
+
+#define LOG_TAG "TIZEN_N_SYSTEM_SETTINGS"
+
+
+/*
+ * A group listener holds one reference on the vconf subscription of each key
+ * of its group. Changes are collected in pending[] and delivered by a single
+ * idle callback, so a burst of changes in a group costs one invocation.
+ */
+typedef struct {
+	system_settings_group_e group;
+	system_settings_group_changed_cb callback;
+	void *user_data;
+	GMainContext *context;
+
+	int ref_count;
+	bool removed;
+	bool scheduled;
+	bool pending[SYSTEM_SETTINGS_KEY_COUNT];
+} system_setting_group_listener_s;
+
+G_LOCK_DEFINE_STATIC(system_setting_group);
+
+static GList *group_listeners;
+
+
+static bool system_setting_group_has_key(system_settings_group_e group, system_settings_key_e key)
+{
+	system_setting_h system_setting_item;
+
+	if (system_settings_get_item(key, &system_setting_item) || (unsigned int)key >= SYSTEM_SETTINGS_KEY_COUNT)
+	{
+		return false;
+	}
+
+	return group == SYSTEM_SETTINGS_GROUP_ALL || (system_setting_item->groups & SYSTEM_SETTING_GROUP_MASK(group));
+}
+
+/* called with the lock held */
+static void system_setting_group_listener_unref(system_setting_group_listener_s *listener)
+{
+	if (--listener->ref_count == 0)
+	{
+		g_main_context_unref(listener->context);
+		g_free(listener);
+	}
+}
+
+static gboolean system_setting_group_idle_cb(gpointer data)
+{
+	system_setting_group_listener_s *listener = data;
+	system_settings_key_e keys[SYSTEM_SETTINGS_KEY_COUNT];
+	int count = 0;
+	bool removed;
+	int key;
+
+	G_LOCK(system_setting_group);
+
+	for (key = 0; key < SYSTEM_SETTINGS_KEY_COUNT; key++)
+	{
+		if (listener->pending[key])
+		{
+			listener->pending[key] = false;
+			keys[count++] = key;
+		}
+	}
+
+	listener->scheduled = false;
+	removed = listener->removed;
+	listener->ref_count++;
+
+	G_UNLOCK(system_setting_group);
+
+	if (!removed && count > 0)
+	{
+		listener->callback(listener->group, keys, count, listener->user_data);
+	}
+
+	G_LOCK(system_setting_group);
+	system_setting_group_listener_unref(listener);	/* callback */
+	system_setting_group_listener_unref(listener);	/* idle source */
+	G_UNLOCK(system_setting_group);
+
+	return FALSE;
+}
+
+void system_setting_group_notify(system_settings_key_e key)
+{
+	system_setting_group_listener_s *listener;
+	GSource *source;
+	GList *l;
+
+	if ((unsigned int)key >= SYSTEM_SETTINGS_KEY_COUNT)
+	{
+		return;
+	}
+
+	G_LOCK(system_setting_group);
+
+	for (l = group_listeners; l != NULL; l = l->next)
+	{
+		listener = l->data;
+
+		if (!system_setting_group_has_key(listener->group, key))
+		{
+			continue;
+		}
+
+		listener->pending[key] = true;
+
+		if (!listener->scheduled)
+		{
+			listener->scheduled = true;
+			listener->ref_count++;
+
+			source = g_idle_source_new();
+			g_source_set_callback(source, system_setting_group_idle_cb, listener, NULL);
+			g_source_attach(source, listener->context);
+			g_source_unref(source);
+		}
+	}
+
+	G_UNLOCK(system_setting_group);
+}
+
+static void system_setting_group_unref_keys(system_settings_group_e group, int last_key)
+{
+	system_setting_h system_setting_item;
+	int key;
+
+	for (key = 0; key < last_key; key++)
+	{
+		if (system_setting_group_has_key(group, key))
+		{
+			system_settings_get_item(key, &system_setting_item);
+			system_setting_notify_unref(system_setting_item);
+		}
+	}
+}
+
+/*PUBLIC*/
+int system_settings_add_group_changed_cb(system_settings_group_e group, system_settings_group_changed_cb callback, void *user_data)
+{
+	system_setting_group_listener_s *listener;
+	system_setting_h system_setting_item;
+	int ret;
+	int key;
+
+	if ((unsigned int)group > SYSTEM_SETTINGS_GROUP_ALL || callback == NULL)
+	{
+		LOGE("[%s] INVALID_PARAMETER(0x%08x) : invalid argument", __FUNCTION__, SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER);
+		return SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER;
+	}
+
+	for (key = 0; key < SYSTEM_SETTINGS_KEY_COUNT; key++)
+	{
+		if (!system_setting_group_has_key(group, key))
+		{
+			continue;
+		}
+
+		system_settings_get_item(key, &system_setting_item);
+		ret = system_setting_notify_ref(system_setting_item);
+
+		if (ret != SYSTEM_SETTINGS_ERROR_NONE)
+		{
+			system_setting_group_unref_keys(group, key);
+			return ret;
+		}
+	}
+
+	listener = g_new0(system_setting_group_listener_s, 1);
+	listener->group = group;
+	listener->callback = callback;
+	listener->user_data = user_data;
+	listener->context = g_main_context_ref_thread_default();
+	listener->ref_count = 1;
+
+	G_LOCK(system_setting_group);
+	group_listeners = g_list_append(group_listeners, listener);
+	G_UNLOCK(system_setting_group);
+
+	return SYSTEM_SETTINGS_ERROR_NONE;
+}
+
+int system_settings_remove_group_changed_cb(system_settings_group_e group, system_settings_group_changed_cb callback)
+{
+	system_setting_group_listener_s *listener = NULL;
+	GList *l;
+
+	if ((unsigned int)group > SYSTEM_SETTINGS_GROUP_ALL || callback == NULL)
+	{
+		LOGE("[%s] INVALID_PARAMETER(0x%08x) : invalid argument", __FUNCTION__, SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER);
+		return SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER;
+	}
+
+	G_LOCK(system_setting_group);
+
+	for (l = group_listeners; l != NULL; l = l->next)
+	{
+		listener = l->data;
+
+		if (listener->group == group && listener->callback == callback)
+		{
+			group_listeners = g_list_delete_link(group_listeners, l);
+			listener->removed = true;
+			system_setting_group_listener_unref(listener);
+			break;
+		}
+		listener = NULL;
+	}
+
+	G_UNLOCK(system_setting_group);
+
+	if (listener == NULL)
+	{
+		LOGE("[%s] INVALID_PARAMETER(0x%08x) : callback is not registered", __FUNCTION__, SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER);
+		return SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER;
+	}
+
+	system_setting_group_unref_keys(group, SYSTEM_SETTINGS_KEY_COUNT);
+
+	return SYSTEM_SETTINGS_ERROR_NONE;
+}
@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <dlog.h>
+
+#include <system_settings.h>
+#include <system_settings_private.h>
+#include <system_settings_key_name_private.h>
+
+#include SYSTEM_SETTING_KEY_NAME_TABLE_FILE
+
+#ifdef LOG_TAG
+#undef LOG_TAG
+#endif
+
+#define LOG_TAG "TIZEN_N_SYSTEM_SETTINGS"
+
+
+/*PUBLIC*/
+int system_settings_key_from_name(const char *name, system_settings_key_e *key)
+{
+	unsigned int slot;
+	size_t length;
+
+	if (name == NULL || key == NULL)
+	{
+		LOGE("[%s] INVALID_PARAMETER(0x%08x) : invalid argument", __FUNCTION__, SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER);
+		return SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER;
+	}
+
+	slot = system_setting_key_name_hash(name, SYSTEM_SETTING_KEY_NAME_SEED, &length) & (SYSTEM_SETTING_KEY_NAME_SLOTS - 1);
+
+	if (length == 0 || system_setting_key_name_slots[slot].length != length
+		|| memcmp(system_setting_key_name_slots[slot].name, name, length))
+	{
+		return SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER;
+	}
+
+	*key = (system_settings_key_e)system_setting_key_name_slots[slot].key;
+
+	return SYSTEM_SETTINGS_ERROR_NONE;
+}
+
+static int system_setting_key_name_resolve(const char *name, system_settings_key_e *key)
+{
+	if (system_settings_key_from_name(name, key) != SYSTEM_SETTINGS_ERROR_NONE)
+	{
+		LOGE("[%s] INVALID_PARAMETER(0x%08x) : invalid key name %s", __FUNCTION__, SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER, name != NULL ? name : "(null)");
+		return SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER;
+	}
+
+	return SYSTEM_SETTINGS_ERROR_NONE;
+}
+
+int system_settings_get_value_int_by_name(const char *name, int *value)
+{
+	system_settings_key_e key;
+	int ret = system_setting_key_name_resolve(name, &key);
+
+	return ret != SYSTEM_SETTINGS_ERROR_NONE ? ret : system_settings_get_value_int(key, value);
+}
+
+int system_settings_get_value_bool_by_name(const char *name, bool *value)
+{
+	system_settings_key_e key;
+	int ret = system_setting_key_name_resolve(name, &key);
+
+	return ret != SYSTEM_SETTINGS_ERROR_NONE ? ret : system_settings_get_value_bool(key, value);
+}
+
+int system_settings_get_value_double_by_name(const char *name, double *value)
+{
+	system_settings_key_e key;
+	int ret = system_setting_key_name_resolve(name, &key);
+
+	return ret != SYSTEM_SETTINGS_ERROR_NONE ? ret : system_settings_get_value_double(key, value);
+}
+
+int system_settings_get_value_string_by_name(const char *name, char **value)
+{
+	system_settings_key_e key;
+	int ret = system_setting_key_name_resolve(name, &key);
+
+	return ret != SYSTEM_SETTINGS_ERROR_NONE ? ret : system_settings_get_value_string(key, value);
+}
+
+int system_settings_set_value_int_by_name(const char *name, int value)
+{
+	system_settings_key_e key;
+	int ret = system_setting_key_name_resolve(name, &key);
+
+	return ret != SYSTEM_SETTINGS_ERROR_NONE ? ret : system_settings_set_value_int(key, value);
+}
+
+int system_settings_set_value_bool_by_name(const char *name, bool value)
+{
+	system_settings_key_e key;
+	int ret = system_setting_key_name_resolve(name, &key);
+
+	return ret != SYSTEM_SETTINGS_ERROR_NONE ? ret : system_settings_set_value_bool(key, value);
+}
+
+int system_settings_set_value_double_by_name(const char *name, double value)
+{
+	system_settings_key_e key;
+	int ret = system_setting_key_name_resolve(name, &key);
+
+	return ret != SYSTEM_SETTINGS_ERROR_NONE ? ret : system_settings_set_value_double(key, value);
+}
+
+int system_settings_set_value_string_by_name(const char *name, const char *value)
+{
+	system_settings_key_e key;
+	int ret = system_setting_key_name_resolve(name, &key);
+
+	return ret != SYSTEM_SETTINGS_ERROR_NONE ? ret : system_settings_set_value_string(key, value);
+}
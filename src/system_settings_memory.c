@@ -0,0 +1,267 @@
+/*
+ * Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <dlog.h>
+#include <glib.h>
+
+#include <system_settings.h>
+#include <system_settings_private.h>
+#include <system_settings_backend_private.h>
+
+#ifdef LOG_TAG
+#undef LOG_TAG
+#endif
+
+#define LOG_TAG "TIZEN_N_SYSTEM_SETTINGS"
+
+
+/*
+ * In-memory stand-in for vconf. Keys are created by their first write and a
+ * write to a watched key is notified synchronously on the writing thread.
+ * Compare-and-set is atomic, the store has a single lock.
+ */
+typedef struct {
+	system_setting_value_s value;
+	bool has_value;
+	bool watched;
+	system_settings_key_e key;			/* key notified when watched */
+} system_setting_memory_entry_s;
+
+G_LOCK_DEFINE_STATIC(system_setting_memory);
+
+static GHashTable *memory_entries;
+static system_setting_backend_notify_cb memory_notify = system_setting_backend_changed;
+
+
+static void system_setting_memory_entry_free(gpointer data)
+{
+	system_setting_memory_entry_s *entry = data;
+
+	system_setting_value_clear(&entry->value);
+	g_free(entry);
+}
+
+/* called with the lock held */
+static system_setting_memory_entry_s *system_setting_memory_entry_get(const char *vconf_key, bool create)
+{
+	system_setting_memory_entry_s *entry;
+
+	if (memory_entries == NULL)
+	{
+		if (!create)
+		{
+			return NULL;
+		}
+		memory_entries = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, system_setting_memory_entry_free);
+	}
+
+	entry = g_hash_table_lookup(memory_entries, vconf_key);
+
+	if (entry == NULL && create)
+	{
+		entry = g_new0(system_setting_memory_entry_s, 1);
+		g_hash_table_insert(memory_entries, g_strdup(vconf_key), entry);
+	}
+
+	return entry;
+}
+
+static int system_setting_memory_get_value(const char *vconf_key, system_setting_data_type_e data_type, system_setting_value_s *value)
+{
+	system_setting_memory_entry_s *entry;
+	int ret = -1;
+
+	memset(value, 0, sizeof(*value));
+
+	G_LOCK(system_setting_memory);
+
+	entry = system_setting_memory_entry_get(vconf_key, false);
+
+	if (entry != NULL && entry->has_value && entry->value.data_type == data_type)
+	{
+		system_setting_value_copy(value, &entry->value);
+		ret = 0;
+	}
+
+	G_UNLOCK(system_setting_memory);
+
+	return ret;
+}
+
+/* writes value if expected is NULL or held by the key, the comparison and the write are done under the lock */
+static int system_setting_memory_store(const char *vconf_key, const system_setting_value_s *expected, const system_setting_value_s *value,
+	system_setting_value_s *current)
+{
+	system_setting_memory_entry_s *entry;
+	system_setting_value_s notify_value;
+	system_setting_backend_notify_cb notify;
+	system_settings_key_e key;
+	bool watched;
+
+	if (value->data_type == SYSTEM_SETTING_DATA_TYPE_STRING && value->value.s == NULL)
+	{
+		return -1;
+	}
+
+	G_LOCK(system_setting_memory);
+
+	entry = system_setting_memory_entry_get(vconf_key, expected == NULL);
+
+	/* a key never written holds no value, which is not the expected one */
+	if (expected != NULL && (entry == NULL || !entry->has_value))
+	{
+		G_UNLOCK(system_setting_memory);
+
+		if (current != NULL)
+		{
+			memset(current, 0, sizeof(*current));
+			current->data_type = expected->data_type;
+		}
+		return SYSTEM_SETTING_BACKEND_MISMATCH;
+	}
+
+	if (entry->has_value && entry->value.data_type != value->data_type)
+	{
+		G_UNLOCK(system_setting_memory);
+		return -1;
+	}
+
+	if (expected != NULL && !system_setting_value_equal(&entry->value, expected))
+	{
+		if (current != NULL)
+		{
+			system_setting_value_copy(current, &entry->value);
+		}
+
+		G_UNLOCK(system_setting_memory);
+		return SYSTEM_SETTING_BACKEND_MISMATCH;
+	}
+
+	system_setting_value_clear(&entry->value);
+	system_setting_value_copy(&entry->value, value);
+	entry->has_value = true;
+
+	watched = entry->watched;
+	key = entry->key;
+
+	if (watched)
+	{
+		system_setting_value_copy(&notify_value, value);
+	}
+
+	G_UNLOCK(system_setting_memory);
+
+	/* notified without the lock so that callbacks can use the store */
+	if (watched)
+	{
+		notify = (system_setting_backend_notify_cb)g_atomic_pointer_get(&memory_notify);
+		notify(key, &notify_value);
+		system_setting_value_clear(&notify_value);
+	}
+
+	return 0;
+}
+
+static int system_setting_memory_set_value(const char *vconf_key, const system_setting_value_s *value)
+{
+	return system_setting_memory_store(vconf_key, NULL, value, NULL);
+}
+
+static int system_setting_memory_compare_and_set(const char *vconf_key, const system_setting_value_s *expected, const system_setting_value_s *value,
+	system_setting_value_s *current)
+{
+	return system_setting_memory_store(vconf_key, expected, value, current);
+}
+
+static int system_setting_memory_watch(const char *vconf_key, system_settings_key_e key)
+{
+	system_setting_memory_entry_s *entry;
+
+	G_LOCK(system_setting_memory);
+
+	entry = system_setting_memory_entry_get(vconf_key, true);
+	entry->watched = true;
+	entry->key = key;
+
+	G_UNLOCK(system_setting_memory);
+
+	return 0;
+}
+
+static int system_setting_memory_unwatch(const char *vconf_key)
+{
+	system_setting_memory_entry_s *entry;
+
+	G_LOCK(system_setting_memory);
+
+	entry = system_setting_memory_entry_get(vconf_key, false);
+
+	if (entry != NULL)
+	{
+		entry->watched = false;
+	}
+
+	G_UNLOCK(system_setting_memory);
+
+	return 0;
+}
+
+void system_setting_backend_memory_set_notify(system_setting_backend_notify_cb notify)
+{
+	g_atomic_pointer_set(&memory_notify, notify != NULL ? notify : system_setting_backend_changed);
+}
+
+system_setting_backend_notify_cb system_setting_backend_memory_get_notify(void)
+{
+	return (system_setting_backend_notify_cb)g_atomic_pointer_get(&memory_notify);
+}
+
+/* drops every stored value, watches are kept */
+void system_setting_backend_memory_reset(void)
+{
+	GHashTableIter iter;
+	gpointer data;
+	system_setting_memory_entry_s *entry;
+
+	G_LOCK(system_setting_memory);
+
+	if (memory_entries != NULL)
+	{
+		g_hash_table_iter_init(&iter, memory_entries);
+
+		while (g_hash_table_iter_next(&iter, NULL, &data))
+		{
+			entry = data;
+			system_setting_value_clear(&entry->value);
+			entry->has_value = false;
+		}
+	}
+
+	G_UNLOCK(system_setting_memory);
+}
+
+const system_setting_backend_s system_setting_backend_memory = {
+	.name = "memory",
+	.get_value = system_setting_memory_get_value,
+	.set_value = system_setting_memory_set_value,
+	.compare_and_set = system_setting_memory_compare_and_set,
+	.watch = system_setting_memory_watch,
+	.unwatch = system_setting_memory_unwatch,
+};
@@ -0,0 +1,189 @@
+/*
+ * Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <glib.h>
+
+#include <system_settings.h>
+#include <system_settings_private.h>
+
+
+/* 4 bits per channel */
+#define PALETTE_BINS 4096
+
+/* accents closer than this (squared RGB distance) to a picked colour are skipped */
+#define PALETTE_MIN_DISTANCE (40 * 40)
+
+typedef struct {
+	uint32_t count[PALETTE_BINS];
+	uint32_t sum[PALETTE_BINS][3];
+} system_setting_palette_histogram_s;
+
+#if defined(__GNUC__)
+typedef uint32_t system_setting_palette_v4u __attribute__((vector_size(16)));
+#endif
+
+
+static inline void system_setting_palette_add(system_setting_palette_histogram_s *histogram, uint32_t pixel, uint32_t bin)
+{
+	histogram->count[bin]++;
+	histogram->sum[bin][0] += (pixel >> 16) & 0xff;
+	histogram->sum[bin][1] += (pixel >> 8) & 0xff;
+	histogram->sum[bin][2] += pixel & 0xff;
+}
+
+static inline uint32_t system_setting_palette_bin(uint32_t pixel)
+{
+	return ((pixel >> 12) & 0xf00) | ((pixel >> 8) & 0xf0) | ((pixel >> 4) & 0xf);
+}
+
+/* counts the opaque pixels of a row, translucent ones are mostly edges and shadows */
+static void system_setting_palette_add_row(system_setting_palette_histogram_s *histogram, const uint32_t *row, int width)
+{
+	int x = 0;
+
+#if defined(__GNUC__)
+	/* bins and the opacity mask of 4 pixels at once, NEON or SSE2 depending on the target */
+	for (; x + 4 <= width; x += 4)
+	{
+		system_setting_palette_v4u pixels;
+		system_setting_palette_v4u bins;
+		system_setting_palette_v4u opaque;
+		int i;
+
+		memcpy(&pixels, row + x, sizeof(pixels));
+
+		bins = ((pixels >> 12) & 0xf00) | ((pixels >> 8) & 0xf0) | ((pixels >> 4) & 0xf);
+		opaque = (pixels >> 24) == 0xff;
+
+		for (i = 0; i < 4; i++)
+		{
+			if (opaque[i])
+			{
+				system_setting_palette_add(histogram, pixels[i], bins[i]);
+			}
+		}
+	}
+#endif
+
+	for (; x < width; x++)
+	{
+		if ((row[x] >> 24) == 0xff)
+		{
+			system_setting_palette_add(histogram, row[x], system_setting_palette_bin(row[x]));
+		}
+	}
+}
+
+static unsigned int system_setting_palette_color(const system_setting_palette_histogram_s *histogram, int bin)
+{
+	uint32_t count = histogram->count[bin];
+
+	return ((histogram->sum[bin][0] / count) << 16) | ((histogram->sum[bin][1] / count) << 8) | (histogram->sum[bin][2] / count);
+}
+
+static int system_setting_palette_distance(unsigned int a, unsigned int b)
+{
+	int r = (int)((a >> 16) & 0xff) - (int)((b >> 16) & 0xff);
+	int g = (int)((a >> 8) & 0xff) - (int)((b >> 8) & 0xff);
+	int bl = (int)(a & 0xff) - (int)(b & 0xff);
+
+	return r * r + g * g + bl * bl;
+}
+
+/*
+ * The dominant colour is the mean of the most populated bin. Accents are the
+ * next most populated bins, with at least 1% of the pixels, whose colour is
+ * distinct from every colour already picked.
+ */
+int system_setting_palette_compute(const unsigned int *pixels, int width, int height, int stride, system_settings_palette_s *palette)
+{
+	system_setting_palette_histogram_s *histogram;
+	unsigned int picked[1 + SYSTEM_SETTINGS_PALETTE_ACCENT_MAX];
+	uint32_t total = 0;
+	uint32_t best_count;
+	int best;
+	int count = 0;
+	int bin;
+	int y;
+	int i;
+
+	memset(palette, 0, sizeof(*palette));
+
+	histogram = g_try_new0(system_setting_palette_histogram_s, 1);
+
+	if (histogram == NULL)
+	{
+		return SYSTEM_SETTINGS_ERROR_OUT_OF_MEMORY;
+	}
+
+	for (y = 0; y < height; y++)
+	{
+		system_setting_palette_add_row(histogram, (const uint32_t *)((const char *)pixels + (size_t)y * stride), width);
+	}
+
+	for (bin = 0; bin < PALETTE_BINS; bin++)
+	{
+		total += histogram->count[bin];
+	}
+
+	while (total > 0 && count < 1 + SYSTEM_SETTINGS_PALETTE_ACCENT_MAX)
+	{
+		best = -1;
+		best_count = count == 0 ? 0 : total / 100;
+
+		for (bin = 0; bin < PALETTE_BINS; bin++)
+		{
+			if (histogram->count[bin] > best_count)
+			{
+				best = bin;
+				best_count = histogram->count[bin];
+			}
+		}
+
+		if (best < 0)
+		{
+			break;
+		}
+
+		picked[count] = system_setting_palette_color(histogram, best);
+		histogram->count[best] = 0;
+
+		for (i = 0; i < count && system_setting_palette_distance(picked[i], picked[count]) >= PALETTE_MIN_DISTANCE; i++)
+			;
+
+		if (i == count)
+		{
+			count++;
+		}
+	}
+
+	g_free(histogram);
+
+	if (count == 0)
+	{
+		return SYSTEM_SETTINGS_ERROR_IO_ERROR;
+	}
+
+	palette->dominant = picked[0];
+	palette->accent_count = count - 1;
+	memcpy(palette->accents, picked + 1, (count - 1) * sizeof(picked[0]));
+
+	return SYSTEM_SETTINGS_ERROR_NONE;
+}
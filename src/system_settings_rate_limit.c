@@ -0,0 +1,422 @@
+/*
+ * Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <dlog.h>
+#include <glib.h>
+
+#include <Ecore.h>
+
+#include <system_settings.h>
+#include <system_settings_private.h>
+
+#ifdef LOG_TAG
+#undef LOG_TAG
+#endif
+
+#define LOG_TAG "TIZEN_N_SYSTEM_SETTINGS"
+
+
+/* tokens are added at rate per second up to burst, a write takes one */
+typedef struct {
+	unsigned int rate;				/* 0 for no limit */
+	unsigned int burst;
+	system_settings_rate_limit_policy_e policy;
+	double tokens;
+	gint64 refilled;				/* g_get_monotonic_time() of the last refill */
+} system_setting_bucket_s;
+
+/* the latest value written over the limit of a key, waiting for a token */
+typedef struct {
+	system_setting_bucket_s bucket;
+	system_setting_value_s pending;
+	bool has_pending;
+	GSource *source;
+} system_setting_rate_limit_s;
+
+G_LOCK_DEFINE_STATIC(system_setting_rate_limit);
+
+static system_setting_rate_limit_s key_limits[SYSTEM_SETTINGS_KEY_COUNT];
+static system_setting_bucket_s process_bucket;
+
+/*
+ * The flush timeouts run on a thread of their own, whatever main context the
+ * writer iterates. The write itself is made from the Ecore main loop, as the
+ * apply hooks use elementary and evas.
+ */
+static GMainContext *rate_limit_flush_context;
+
+typedef struct {
+	system_settings_key_e key;
+	system_setting_value_s value;
+} system_setting_rate_limit_flush_s;
+
+/* fast path, no lock is taken while nothing is limited */
+static volatile gint rate_limits_enabled;
+
+
+static void system_setting_bucket_set(system_setting_bucket_s *bucket, unsigned int rate, unsigned int burst, system_settings_rate_limit_policy_e policy)
+{
+	bucket->rate = rate;
+	bucket->burst = burst;
+	bucket->policy = policy;
+	bucket->tokens = burst;
+	bucket->refilled = g_get_monotonic_time();
+}
+
+static void system_setting_bucket_refill(system_setting_bucket_s *bucket, gint64 now)
+{
+	if (bucket->rate == 0)
+	{
+		return;
+	}
+
+	bucket->tokens += (double)(now - bucket->refilled) * bucket->rate / G_USEC_PER_SEC;
+	bucket->refilled = now;
+
+	if (bucket->tokens > bucket->burst)
+	{
+		bucket->tokens = bucket->burst;
+	}
+}
+
+static bool system_setting_bucket_ready(const system_setting_bucket_s *bucket)
+{
+	return bucket->rate == 0 || bucket->tokens >= 1.0;
+}
+
+/* milliseconds until the bucket holds a token */
+static guint system_setting_bucket_wait(const system_setting_bucket_s *bucket)
+{
+	if (system_setting_bucket_ready(bucket))
+	{
+		return 0;
+	}
+
+	return (guint)((1.0 - bucket->tokens) * 1000 / bucket->rate) + 1;
+}
+
+static void system_setting_rate_limit_update_enabled(void)
+{
+	bool enabled = process_bucket.rate != 0;
+	int key;
+
+	for (key = 0; key < SYSTEM_SETTINGS_KEY_COUNT && !enabled; key++)
+	{
+		enabled = key_limits[key].bucket.rate != 0;
+	}
+
+	g_atomic_int_set(&rate_limits_enabled, enabled);
+}
+
+/*
+ * SYSTEM_SETTINGS_RATE_LIMIT holds comma separated limits, e.g.
+ * "font_type=1/3/coalesce,process=20/40": the key name of the schema or
+ * "process", the rate per second, the burst and optionally the policy,
+ * "reject" by default.
+ */
+static void system_setting_rate_limit_load_env(void)
+{
+	const char *env = getenv(SYSTEM_SETTING_RATE_LIMIT_ENV);
+	system_settings_rate_limit_policy_e policy;
+	system_setting_bucket_s *bucket;
+	char name[64];
+	char policy_name[16];
+	unsigned int rate, burst;
+	char **limits;
+	system_settings_key_e key;
+	int fields;
+	int i;
+
+	if (env == NULL)
+	{
+		return;
+	}
+
+	limits = g_strsplit(env, ",", -1);
+
+	for (i = 0; limits[i] != NULL; i++)
+	{
+		policy_name[0] = '\0';
+		fields = sscanf(limits[i], " %63[^=]=%u/%u/%15s", name, &rate, &burst, policy_name);
+
+		if (fields < 3)
+		{
+			LOGE("[%s] INVALID_PARAMETER(0x%08x) : invalid rate limit %s", __FUNCTION__, SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER, limits[i]);
+			continue;
+		}
+
+		policy = !strcmp(policy_name, "coalesce") ? SYSTEM_SETTINGS_RATE_LIMIT_COALESCE : SYSTEM_SETTINGS_RATE_LIMIT_REJECT;
+		bucket = NULL;
+
+		if (!strcmp(g_strstrip(name), "process"))
+		{
+			bucket = &process_bucket;
+		}
+		else if (!system_settings_key_from_name(name, &key))
+		{
+			bucket = &key_limits[key].bucket;
+		}
+
+		if (bucket != NULL && burst > 0)
+		{
+			system_setting_bucket_set(bucket, rate, burst, policy);
+		}
+	}
+
+	g_strfreev(limits);
+
+	system_setting_rate_limit_update_enabled();
+}
+
+static void system_setting_rate_limit_init(void)
+{
+	static gsize rate_limit_loaded = 0;
+
+	if (g_once_init_enter(&rate_limit_loaded))
+	{
+		G_LOCK(system_setting_rate_limit);
+		system_setting_rate_limit_load_env();
+		G_UNLOCK(system_setting_rate_limit);
+		g_once_init_leave(&rate_limit_loaded, 1);
+	}
+}
+
+static void system_setting_rate_limit_value(system_setting_value_s *out, system_setting_data_type_e data_type, void *value)
+{
+	system_setting_value_s in;
+
+	memset(&in, 0, sizeof(in));
+	in.data_type = data_type;
+
+	switch (data_type)
+	{
+	case SYSTEM_SETTING_DATA_TYPE_STRING:
+		in.value.s = value;
+		break;
+
+	case SYSTEM_SETTING_DATA_TYPE_INT:
+		in.value.i = *(int*)value;
+		break;
+
+	case SYSTEM_SETTING_DATA_TYPE_DOUBLE:
+		in.value.d = *(double*)value;
+		break;
+
+	case SYSTEM_SETTING_DATA_TYPE_BOOL:
+		in.value.b = *(bool*)value;
+		break;
+
+	default:
+		break;
+	}
+
+	system_setting_value_copy(out, &in);
+}
+
+static gpointer system_setting_rate_limit_flush_main(gpointer data)
+{
+	GMainLoop *loop = g_main_loop_new(rate_limit_flush_context, FALSE);
+
+	g_main_loop_run(loop);
+	g_main_loop_unref(loop);
+
+	return NULL;
+}
+
+static GMainContext *system_setting_rate_limit_flush_context(void)
+{
+	static gsize flush_thread_started = 0;
+
+	if (g_once_init_enter(&flush_thread_started))
+	{
+		rate_limit_flush_context = g_main_context_new();
+		g_thread_unref(g_thread_new("system-settings-limit", system_setting_rate_limit_flush_main, NULL));
+		g_once_init_leave(&flush_thread_started, 1);
+	}
+
+	return rate_limit_flush_context;
+}
+
+static void system_setting_rate_limit_write(void *data)
+{
+	system_setting_rate_limit_flush_s *flush = data;
+	void *value;
+	int ret;
+
+	value = flush->value.data_type == SYSTEM_SETTING_DATA_TYPE_STRING ? (void*)flush->value.value.s : (void*)&flush->value.value;
+	ret = system_setting_set_value_unlimited(flush->key, flush->value.data_type, value);
+
+	/* nobody waits for the result any more */
+	if (ret != SYSTEM_SETTINGS_ERROR_NONE)
+	{
+		LOGE("[%s] failed to write the deferred value of key %d (0x%08x)", __FUNCTION__, flush->key, ret);
+	}
+
+	system_setting_value_clear(&flush->value);
+	g_free(flush);
+}
+
+static gboolean system_setting_rate_limit_flush_cb(gpointer data)
+{
+	system_settings_key_e key = GPOINTER_TO_INT(data);
+	system_setting_rate_limit_s *limit = &key_limits[key];
+	system_setting_rate_limit_flush_s *flush;
+	gint64 now = g_get_monotonic_time();
+
+	flush = g_new0(system_setting_rate_limit_flush_s, 1);
+	flush->key = key;
+
+	G_LOCK(system_setting_rate_limit);
+
+	system_setting_bucket_refill(&limit->bucket, now);
+	system_setting_bucket_refill(&process_bucket, now);
+
+	/* the token may have been taken meanwhile, the bucket then goes into debt */
+	limit->bucket.tokens -= limit->bucket.rate != 0 ? 1.0 : 0.0;
+	process_bucket.tokens -= process_bucket.rate != 0 ? 1.0 : 0.0;
+
+	flush->value = limit->pending;
+	limit->has_pending = false;
+	g_source_unref(limit->source);
+	limit->source = NULL;
+
+	G_UNLOCK(system_setting_rate_limit);
+
+	ecore_main_loop_thread_safe_call_async(system_setting_rate_limit_write, flush);
+
+	return FALSE;
+}
+
+int system_setting_rate_limit_acquire(system_settings_key_e key, system_setting_data_type_e data_type, void *value)
+{
+	system_setting_rate_limit_s *limit = NULL;
+	system_setting_bucket_s *exhausted;
+	gint64 now;
+	guint wait;
+
+	system_setting_rate_limit_init();
+
+	if (!g_atomic_int_get(&rate_limits_enabled))
+	{
+		return SYSTEM_SETTINGS_ERROR_NONE;
+	}
+
+	now = g_get_monotonic_time();
+
+	G_LOCK(system_setting_rate_limit);
+
+	if ((unsigned int)key < SYSTEM_SETTINGS_KEY_COUNT)
+	{
+		limit = &key_limits[key];
+		system_setting_bucket_refill(&limit->bucket, now);
+	}
+
+	system_setting_bucket_refill(&process_bucket, now);
+
+	if ((limit == NULL || system_setting_bucket_ready(&limit->bucket)) && system_setting_bucket_ready(&process_bucket)
+		&& (limit == NULL || !limit->has_pending))
+	{
+		if (limit != NULL && limit->bucket.rate != 0)
+		{
+			limit->bucket.tokens -= 1.0;
+		}
+		if (process_bucket.rate != 0)
+		{
+			process_bucket.tokens -= 1.0;
+		}
+
+		G_UNLOCK(system_setting_rate_limit);
+		return SYSTEM_SETTINGS_ERROR_NONE;
+	}
+
+	exhausted = limit != NULL && !system_setting_bucket_ready(&limit->bucket) ? &limit->bucket : &process_bucket;
+
+	/* keys outside the schema have no slot to hold a pending value, and writes without a value cannot be deferred */
+	if (limit == NULL || value == NULL || (exhausted->policy == SYSTEM_SETTINGS_RATE_LIMIT_REJECT && !limit->has_pending))
+	{
+		G_UNLOCK(system_setting_rate_limit);
+
+		system_setting_stat_inc(SYSTEM_SETTINGS_STAT_WRITES_REJECTED);
+		LOGE("[%s] RESOURCE_BUSY(0x%08x) : rate limit of key %d exceeded", __FUNCTION__, SYSTEM_SETTINGS_ERROR_RESOURCE_BUSY, key);
+		return SYSTEM_SETTINGS_ERROR_RESOURCE_BUSY;
+	}
+
+	/* only the latest value is kept, it is written as soon as both buckets hold a token */
+	if (limit->has_pending)
+	{
+		system_setting_value_clear(&limit->pending);
+	}
+
+	system_setting_rate_limit_value(&limit->pending, data_type, value);
+	limit->has_pending = true;
+
+	if (limit->source == NULL)
+	{
+		wait = MAX(system_setting_bucket_wait(&limit->bucket), system_setting_bucket_wait(&process_bucket));
+
+		limit->source = g_timeout_source_new(wait);
+		g_source_set_callback(limit->source, system_setting_rate_limit_flush_cb, GINT_TO_POINTER(key), NULL);
+		g_source_attach(limit->source, system_setting_rate_limit_flush_context());
+	}
+
+	G_UNLOCK(system_setting_rate_limit);
+
+	system_setting_stat_inc(SYSTEM_SETTINGS_STAT_WRITES_COALESCED);
+
+	return SYSTEM_SETTING_RATE_LIMIT_DEFERRED;
+}
+
+/*PUBLIC*/
+int system_settings_set_rate_limit(system_settings_key_e key, unsigned int rate, unsigned int burst, system_settings_rate_limit_policy_e policy)
+{
+	if ((unsigned int)key >= SYSTEM_SETTINGS_KEY_COUNT || (rate != 0 && burst == 0)
+		|| (unsigned int)policy > SYSTEM_SETTINGS_RATE_LIMIT_COALESCE)
+	{
+		LOGE("[%s] INVALID_PARAMETER(0x%08x) : invalid argument", __FUNCTION__, SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER);
+		return SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER;
+	}
+
+	system_setting_rate_limit_init();
+
+	G_LOCK(system_setting_rate_limit);
+	system_setting_bucket_set(&key_limits[key].bucket, rate, burst, policy);
+	system_setting_rate_limit_update_enabled();
+	G_UNLOCK(system_setting_rate_limit);
+
+	return SYSTEM_SETTINGS_ERROR_NONE;
+}
+
+int system_settings_set_process_rate_limit(unsigned int rate, unsigned int burst, system_settings_rate_limit_policy_e policy)
+{
+	if ((rate != 0 && burst == 0) || (unsigned int)policy > SYSTEM_SETTINGS_RATE_LIMIT_COALESCE)
+	{
+		LOGE("[%s] INVALID_PARAMETER(0x%08x) : invalid argument", __FUNCTION__, SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER);
+		return SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER;
+	}
+
+	system_setting_rate_limit_init();
+
+	G_LOCK(system_setting_rate_limit);
+	system_setting_bucket_set(&process_bucket, rate, burst, policy);
+	system_setting_rate_limit_update_enabled();
+	G_UNLOCK(system_setting_rate_limit);
+
+	return SYSTEM_SETTINGS_ERROR_NONE;
+}
@@ -0,0 +1,237 @@
+/*
+ * Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <dlog.h>
+#include <glib.h>
+
+#include <system_settings.h>
+#include <system_settings_private.h>
+#include <system_settings_record_private.h>
+
+#ifdef LOG_TAG
+#undef LOG_TAG
+#endif
+
+#define LOG_TAG "TIZEN_N_SYSTEM_SETTINGS"
+
+#define SYSTEM_SETTING_RECORD_BUFFER_SIZE (64 * 1024)
+
+
+G_LOCK_DEFINE_STATIC(system_setting_record);
+
+static FILE *record_file;
+static uint64_t record_start;
+
+
+static uint64_t system_setting_record_now(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+static void system_setting_record_close(void)
+{
+	G_LOCK(system_setting_record);
+
+	if (record_file != NULL)
+	{
+		fclose(record_file);
+		record_file = NULL;
+	}
+
+	G_UNLOCK(system_setting_record);
+}
+
+static bool system_setting_record_enabled(void)
+{
+	static gsize record_initialized = 0;
+	system_setting_record_header_s header = { SYSTEM_SETTING_RECORD_MAGIC, SYSTEM_SETTING_RECORD_VERSION };
+	const char *path;
+	FILE *file;
+
+	if (g_once_init_enter(&record_initialized))
+	{
+		path = getenv(SYSTEM_SETTING_RECORD_ENV);
+
+		if (path != NULL && path[0] != '\0')
+		{
+			file = fopen(path, "wb");
+
+			if (file == NULL)
+			{
+				LOGE("[%s] IO_ERROR(0x%08x) : can not open %s", __FUNCTION__, SYSTEM_SETTINGS_ERROR_IO_ERROR, path);
+			}
+			else if (fwrite(&header, sizeof(header), 1, file) != 1)
+			{
+				LOGE("[%s] IO_ERROR(0x%08x) : can not write %s", __FUNCTION__, SYSTEM_SETTINGS_ERROR_IO_ERROR, path);
+				fclose(file);
+			}
+			else
+			{
+				setvbuf(file, NULL, _IOFBF, SYSTEM_SETTING_RECORD_BUFFER_SIZE);
+				record_start = system_setting_record_now();
+				record_file = file;
+				atexit(system_setting_record_close);
+			}
+		}
+
+		g_once_init_leave(&record_initialized, 1);
+	}
+
+	return record_file != NULL;
+}
+
+static void system_setting_record_write(system_setting_record_op_e op, system_settings_key_e key,
+		const system_setting_value_s *value, int result, uint64_t begin, uint64_t end)
+{
+	system_setting_record_s record;
+	const void *payload = NULL;
+	uint8_t bool_value;
+	size_t size;
+
+	memset(&record, 0, sizeof(record));
+	record.timestamp = begin - record_start;
+	record.duration = end - begin > UINT32_MAX ? UINT32_MAX : (uint32_t)(end - begin);
+	record.key = key;
+	record.result = result;
+	record.op = op;
+	record.data_type = SYSTEM_SETTING_RECORD_NO_VALUE;
+
+	if (value != NULL)
+	{
+		record.data_type = value->data_type;
+
+		switch (value->data_type)
+		{
+		case SYSTEM_SETTING_DATA_TYPE_STRING:
+			payload = value->value.s;
+			size = value->value.s != NULL ? strlen(value->value.s) : 0;
+			record.size = size > UINT16_MAX ? UINT16_MAX : size;
+			break;
+
+		case SYSTEM_SETTING_DATA_TYPE_INT:
+			payload = &value->value.i;
+			record.size = sizeof(int32_t);
+			break;
+
+		case SYSTEM_SETTING_DATA_TYPE_DOUBLE:
+			payload = &value->value.d;
+			record.size = sizeof(double);
+			break;
+
+		case SYSTEM_SETTING_DATA_TYPE_BOOL:
+			bool_value = value->value.b;
+			payload = &bool_value;
+			record.size = sizeof(uint8_t);
+			break;
+
+		default:
+			record.data_type = SYSTEM_SETTING_RECORD_NO_VALUE;
+			break;
+		}
+	}
+
+	G_LOCK(system_setting_record);
+
+	if (record_file != NULL)
+	{
+		fwrite(&record, sizeof(record), 1, record_file);
+
+		if (record.size > 0)
+		{
+			fwrite(payload, record.size, 1, record_file);
+		}
+	}
+
+	G_UNLOCK(system_setting_record);
+}
+
+uint64_t system_setting_record_begin(void)
+{
+	if (!system_setting_record_enabled())
+	{
+		return 0;
+	}
+
+	return system_setting_record_now();
+}
+
+void system_setting_record_call(system_setting_record_op_e op, system_settings_key_e key,
+		system_setting_data_type_e data_type, void *value, int result, uint64_t begin)
+{
+	system_setting_value_s record_value;
+	bool has_value = value != NULL;
+
+	if (begin == 0)
+	{
+		return;
+	}
+
+	record_value.data_type = data_type;
+
+	/* get passes a pointer to the result, set passes the value itself for strings */
+	if (op == SYSTEM_SETTING_RECORD_GET && result != SYSTEM_SETTINGS_ERROR_NONE)
+	{
+		has_value = false;
+	}
+	else if (has_value)
+	{
+		switch (data_type)
+		{
+		case SYSTEM_SETTING_DATA_TYPE_STRING:
+			record_value.value.s = op == SYSTEM_SETTING_RECORD_GET ? *(char**)value : (char*)value;
+			break;
+
+		case SYSTEM_SETTING_DATA_TYPE_INT:
+			record_value.value.i = *(int*)value;
+			break;
+
+		case SYSTEM_SETTING_DATA_TYPE_DOUBLE:
+			record_value.value.d = *(double*)value;
+			break;
+
+		case SYSTEM_SETTING_DATA_TYPE_BOOL:
+			record_value.value.b = *(bool*)value;
+			break;
+
+		default:
+			has_value = false;
+			break;
+		}
+	}
+
+	system_setting_record_write(op, key, has_value ? &record_value : NULL, result, begin, system_setting_record_now());
+}
+
+void system_setting_record_notify(system_settings_key_e key, const system_setting_value_s *value)
+{
+	uint64_t now;
+
+	if (!system_setting_record_enabled())
+	{
+		return;
+	}
+
+	now = system_setting_record_now();
+	system_setting_record_write(SYSTEM_SETTING_RECORD_NOTIFY, key, value, SYSTEM_SETTINGS_ERROR_NONE, now, now);
+}
@@ -0,0 +1,405 @@
+/*
+ * Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#include <dlog.h>
+#include <glib.h>
+
+#include <system_settings.h>
+#include <system_settings_private.h>
+
+#ifdef LOG_TAG
+#undef LOG_TAG
+#endif
+
+#define LOG_TAG "TIZEN_N_SYSTEM_SETTINGS"
+
+#define RINGTONE_HEADER_SIZE 4096
+#define RINGTONE_OGG_TAIL_SIZE (64 * 1024)
+#define RINGTONE_MP3_SYNC_SCAN (64 * 1024)
+#define RINGTONE_WARM_SIZE (512 * 1024)		/* bytes of the file brought into the page cache */
+
+
+static uint32_t le16(const unsigned char *p) { return p[0] | (p[1] << 8); }
+static uint32_t le32(const unsigned char *p) { return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24); }
+static uint32_t be32(const unsigned char *p) { return ((uint32_t)p[0] << 24) | (p[1] << 16) | (p[2] << 8) | p[3]; }
+
+static uint64_t le64(const unsigned char *p)
+{
+	return le32(p) | ((uint64_t)le32(p + 4) << 32);
+}
+
+static void system_setting_ringtone_metadata_init(system_settings_ringtone_metadata_s *metadata)
+{
+	metadata->format = SYSTEM_SETTINGS_AUDIO_FORMAT_UNKNOWN;
+	metadata->duration_ms = -1;
+	metadata->sample_rate = -1;
+	metadata->channels = -1;
+}
+
+static bool system_setting_ringtone_probe_wav(const unsigned char *buf, size_t len, off_t file_size,
+		system_settings_ringtone_metadata_s *metadata)
+{
+	uint32_t byte_rate = 0;
+	uint32_t chunk_size;
+	size_t offset = 12;
+
+	if (len < 12 || memcmp(buf, "RIFF", 4) || memcmp(buf + 8, "WAVE", 4))
+	{
+		return false;
+	}
+
+	metadata->format = SYSTEM_SETTINGS_AUDIO_FORMAT_WAV;
+
+	while (offset + 8 <= len)
+	{
+		chunk_size = le32(buf + offset + 4);
+
+		if (!memcmp(buf + offset, "fmt ", 4) && offset + 8 + 16 <= len)
+		{
+			metadata->channels = le16(buf + offset + 8 + 2);
+			metadata->sample_rate = le32(buf + offset + 8 + 4);
+			byte_rate = le32(buf + offset + 8 + 8);
+		}
+		else if (!memcmp(buf + offset, "data", 4))
+		{
+			/* streamed files leave the size unset */
+			if (chunk_size == 0 || chunk_size == 0xffffffff || offset + 8 + (off_t)chunk_size > file_size)
+			{
+				chunk_size = file_size - offset - 8;
+			}
+
+			if (byte_rate > 0)
+			{
+				metadata->duration_ms = (int)((uint64_t)chunk_size * 1000 / byte_rate);
+			}
+			break;
+		}
+
+		offset += 8 + chunk_size + (chunk_size & 1);
+	}
+
+	return true;
+}
+
+static bool system_setting_ringtone_probe_ogg(int fd, const unsigned char *buf, size_t len, off_t file_size,
+		system_settings_ringtone_metadata_s *metadata)
+{
+	unsigned char *tail;
+	const unsigned char *packet;
+	uint64_t granule = 0;
+	uint32_t granule_rate;
+	uint32_t pre_skip = 0;
+	off_t tail_offset;
+	ssize_t tail_len;
+	ssize_t i;
+
+	if (len < 28 || memcmp(buf, "OggS", 4) || (size_t)27 + buf[26] + 19 > len)
+	{
+		return false;
+	}
+
+	metadata->format = SYSTEM_SETTINGS_AUDIO_FORMAT_OGG;
+
+	/* first packet of the first page: the codec identification header */
+	packet = buf + 27 + buf[26];
+
+	if (!memcmp(packet, "\x01vorbis", 7))
+	{
+		metadata->channels = packet[11];
+		metadata->sample_rate = le32(packet + 12);
+		granule_rate = metadata->sample_rate;
+	}
+	else if (!memcmp(packet, "OpusHead", 8))
+	{
+		metadata->channels = packet[9];
+		pre_skip = le16(packet + 10);
+		metadata->sample_rate = le32(packet + 12);
+		granule_rate = 48000;	/* Opus granule positions always count 48 kHz samples */
+	}
+	else
+	{
+		return true;
+	}
+
+	/* the granule position of the last page is the length in samples */
+	tail_offset = file_size > RINGTONE_OGG_TAIL_SIZE ? file_size - RINGTONE_OGG_TAIL_SIZE : 0;
+	tail = malloc(RINGTONE_OGG_TAIL_SIZE);
+
+	if (tail == NULL)
+	{
+		return true;
+	}
+
+	tail_len = pread(fd, tail, RINGTONE_OGG_TAIL_SIZE, tail_offset);
+
+	for (i = tail_len - 27; i >= 0; i--)
+	{
+		if (!memcmp(tail + i, "OggS", 4) && tail[i + 4] == 0)
+		{
+			granule = le64(tail + i + 6);
+			break;
+		}
+	}
+
+	free(tail);
+
+	if (granule_rate > 0 && granule != 0 && granule != (uint64_t)-1 && granule > pre_skip)
+	{
+		metadata->duration_ms = (int)((granule - pre_skip) * 1000 / granule_rate);
+	}
+
+	return true;
+}
+
+static const int mp3_bitrates[2][15] = {
+	{ 0, 32, 40, 48, 56, 64, 80, 96, 112, 128, 160, 192, 224, 256, 320 },	/* MPEG 1 */
+	{ 0, 8, 16, 24, 32, 40, 48, 56, 64, 80, 96, 112, 128, 144, 160 },		/* MPEG 2 and 2.5 */
+};
+
+static const int mp3_sample_rates[4][3] = {
+	{ 11025, 12000, 8000 },		/* MPEG 2.5 */
+	{ 0, 0, 0 },				/* reserved */
+	{ 22050, 24000, 16000 },	/* MPEG 2 */
+	{ 44100, 48000, 32000 },	/* MPEG 1 */
+};
+
+static bool system_setting_ringtone_probe_mp3(int fd, const unsigned char *buf, size_t len, off_t file_size,
+		system_settings_ringtone_metadata_s *metadata)
+{
+	unsigned char *frames;
+	const unsigned char *frame = NULL;
+	off_t audio_start = 0;
+	ssize_t frames_len;
+	ssize_t i;
+	int version, bitrate_index, rate_index, mono;
+	int side_info, samples_per_frame, bitrate;
+	uint32_t frame_count = 0;
+	const unsigned char *tag;
+
+	/* an ID3v2 tag, possibly with a large picture, precedes the first frame */
+	if (len >= 10 && !memcmp(buf, "ID3", 3))
+	{
+		audio_start = 10 + (((buf[6] & 0x7f) << 21) | ((buf[7] & 0x7f) << 14) | ((buf[8] & 0x7f) << 7) | (buf[9] & 0x7f));
+		if (buf[5] & 0x10)
+		{
+			audio_start += 10;	/* footer */
+		}
+	}
+
+	frames = malloc(RINGTONE_MP3_SYNC_SCAN);
+
+	if (frames == NULL)
+	{
+		return false;
+	}
+
+	frames_len = pread(fd, frames, RINGTONE_MP3_SYNC_SCAN, audio_start);
+
+	for (i = 0; i + 4 <= frames_len; i++)
+	{
+		if (frames[i] == 0xff && (frames[i + 1] & 0xe0) == 0xe0
+			&& ((frames[i + 1] >> 3) & 3) != 1				/* version */
+			&& ((frames[i + 1] >> 1) & 3) == 1				/* layer III */
+			&& (frames[i + 2] >> 4) != 0 && (frames[i + 2] >> 4) != 15
+			&& ((frames[i + 2] >> 2) & 3) != 3)
+		{
+			frame = frames + i;
+			break;
+		}
+	}
+
+	if (frame == NULL)
+	{
+		free(frames);
+
+		/* an ID3 tagged file with an unusual first frame */
+		if (audio_start > 0)
+		{
+			metadata->format = SYSTEM_SETTINGS_AUDIO_FORMAT_MP3;
+			return true;
+		}
+		return false;
+	}
+
+	metadata->format = SYSTEM_SETTINGS_AUDIO_FORMAT_MP3;
+
+	version = (frame[1] >> 3) & 3;
+	bitrate_index = frame[2] >> 4;
+	rate_index = (frame[2] >> 2) & 3;
+	mono = (frame[3] >> 6) == 3;
+
+	metadata->sample_rate = mp3_sample_rates[version][rate_index];
+	metadata->channels = mono ? 1 : 2;
+
+	bitrate = mp3_bitrates[version == 3 ? 0 : 1][bitrate_index];
+	samples_per_frame = version == 3 ? 1152 : 576;
+	side_info = version == 3 ? (mono ? 17 : 32) : (mono ? 9 : 17);
+
+	/* VBR files carry the frame count in a Xing/Info or VBRI header in the first frame */
+	tag = frame + 4 + side_info;
+	if (tag + 12 <= frames + frames_len && (!memcmp(tag, "Xing", 4) || !memcmp(tag, "Info", 4)) && (be32(tag + 4) & 1))
+	{
+		frame_count = be32(tag + 8);
+	}
+
+	tag = frame + 4 + 32;
+	if (frame_count == 0 && tag + 18 <= frames + frames_len && !memcmp(tag, "VBRI", 4))
+	{
+		frame_count = be32(tag + 14);
+	}
+
+	if (frame_count > 0 && metadata->sample_rate > 0)
+	{
+		metadata->duration_ms = (int)((uint64_t)frame_count * samples_per_frame * 1000 / metadata->sample_rate);
+	}
+	else if (bitrate > 0)
+	{
+		/* constant bit rate */
+		metadata->duration_ms = (int)((uint64_t)(file_size - audio_start - (frame - frames)) * 8 / bitrate);
+	}
+
+	free(frames);
+	return true;
+}
+
+/*
+ * Probes the container of the file. With warm set, the start of the file is
+ * also brought into the page cache for the player.
+ */
+static int system_setting_ringtone_probe(const char *path, system_settings_ringtone_metadata_s *metadata, bool warm)
+{
+	unsigned char buf[RINGTONE_HEADER_SIZE];
+	struct stat st;
+	ssize_t len;
+	int fd;
+
+	system_setting_ringtone_metadata_init(metadata);
+
+	/* O_NONBLOCK so that a FIFO does not block the open, it is rejected by the S_ISREG check */
+	fd = open(path, O_RDONLY | O_NONBLOCK | O_CLOEXEC);
+
+	if (fd < 0)
+	{
+		return SYSTEM_SETTINGS_ERROR_IO_ERROR;
+	}
+
+	if (fstat(fd, &st) || !S_ISREG(st.st_mode) || (len = pread(fd, buf, sizeof(buf), 0)) < 0)
+	{
+		close(fd);
+		return SYSTEM_SETTINGS_ERROR_IO_ERROR;
+	}
+
+	if (!system_setting_ringtone_probe_wav(buf, len, st.st_size, metadata)
+		&& !system_setting_ringtone_probe_ogg(fd, buf, len, st.st_size, metadata))
+	{
+		system_setting_ringtone_probe_mp3(fd, buf, len, st.st_size, metadata);
+	}
+
+	if (warm)
+	{
+		posix_fadvise(fd, 0, st.st_size < RINGTONE_WARM_SIZE ? st.st_size : RINGTONE_WARM_SIZE, POSIX_FADV_WILLNEED);
+	}
+
+	close(fd);
+	return SYSTEM_SETTINGS_ERROR_NONE;
+}
+
+/* the metadata is stored with the path it describes: "<format> <duration> <rate> <channels> <path>" */
+static bool system_setting_ringtone_metadata_parse(const char *str, const char *path, system_settings_ringtone_metadata_s *metadata)
+{
+	int format;
+	int offset = 0;
+
+	if (str == NULL || sscanf(str, "%d %d %d %d %n", &format, &metadata->duration_ms,
+			&metadata->sample_rate, &metadata->channels, &offset) != 4 || offset == 0)
+	{
+		return false;
+	}
+
+	metadata->format = format;
+
+	return !strcmp(str + offset, path);
+}
+
+// [string] validates the ringtone file and stores its metadata before the path is written
+int system_setting_check_incoming_call_ringtone(system_settings_key_e key, system_setting_data_type_e data_type, void* value)
+{
+	system_settings_ringtone_metadata_s metadata;
+	const char *path = value;
+	char *str;
+
+	if (path == NULL || system_setting_ringtone_probe(path, &metadata, true) != SYSTEM_SETTINGS_ERROR_NONE)
+	{
+		LOGE("[%s] INVALID_PARAMETER(0x%08x) : %s is not a readable file", __FUNCTION__, SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER, path);
+		return SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER;
+	}
+
+	str = g_strdup_printf("%d %d %d %d %s", metadata.format, metadata.duration_ms,
+			metadata.sample_rate, metadata.channels, path);
+
+	/* readers fall back to probing the file when the metadata is missing */
+	if (system_setting_vconf_set_value_string(VCONFKEY_SETAPPL_CALL_RINGTONE_METADATA_STR, str))
+	{
+		LOGE("[%s] IO_ERROR(0x%08x) : can not store the ringtone metadata", __FUNCTION__, SYSTEM_SETTINGS_ERROR_IO_ERROR);
+	}
+
+	g_free(str);
+
+	return SYSTEM_SETTINGS_ERROR_NONE;
+}
+
+/*PUBLIC*/
+int system_settings_get_ringtone_metadata(system_settings_ringtone_metadata_s *metadata)
+{
+	char *path = NULL;
+	char *str = NULL;
+	int ret;
+
+	if (metadata == NULL)
+	{
+		LOGE("[%s] INVALID_PARAMETER(0x%08x) : invalid argument", __FUNCTION__, SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER);
+		return SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER;
+	}
+
+	ret = system_settings_get_value(SYSTEM_SETTINGS_KEY_INCOMING_CALL_RINGTONE, SYSTEM_SETTING_DATA_TYPE_STRING, (void**)&path);
+
+	if (ret != SYSTEM_SETTINGS_ERROR_NONE)
+	{
+		return ret;
+	}
+
+	system_setting_vconf_get_value_string(VCONFKEY_SETAPPL_CALL_RINGTONE_METADATA_STR, &str);
+
+	/* the path was written by an older library or without the metadata */
+	if (!system_setting_ringtone_metadata_parse(str, path, metadata))
+	{
+		ret = system_setting_ringtone_probe(path, metadata, false);
+	}
+
+	free(str);
+	free(path);
+
+	return ret;
+}
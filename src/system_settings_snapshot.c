@@ -0,0 +1,328 @@
+/*
+ * Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <dlog.h>
+#include <glib.h>
+
+#include <Ecore.h>
+
+#include <system_settings.h>
+#include <system_settings_private.h>
+#include <system_settings_backend_private.h>
+
+#ifdef LOG_TAG
+#undef LOG_TAG
+#endif
+
+#define LOG_TAG "TIZEN_N_SYSTEM_SETTINGS"
+
+/* a build chased by changes for longer is published as is, its keys stay dirty */
+#define SNAPSHOT_BUILD_TRIES 8
+
+
+/*
+ * A snapshot is never modified once published, so it can be read from any
+ * thread without locking. The latest snapshot is kept as a cache and handed
+ * out again until a key changes; the next snapshot then re-reads only the
+ * changed keys and copies the others from its predecessor.
+ *
+ * Every change bumps the generation. A build during which it moved reads the
+ * changed keys again, so that the values of a snapshot are those of a moment
+ * at which no notified change was in flight.
+ */
+struct system_settings_snapshot_s {
+	volatile gint ref_count;
+	int error[SYSTEM_SETTINGS_KEY_COUNT];
+	system_setting_value_s values[SYSTEM_SETTINGS_KEY_COUNT];
+};
+
+G_LOCK_DEFINE_STATIC(system_settings_snapshot);
+
+static system_settings_snapshot_h current_snapshot;
+static gboolean snapshot_subscribed;
+
+static volatile gint snapshot_dirty_any;
+static volatile gint snapshot_dirty[SYSTEM_SETTINGS_KEY_COUNT];
+static volatile gint snapshot_generation;
+
+
+void system_setting_snapshot_invalidate(system_settings_key_e key)
+{
+	if ((unsigned int)key >= SYSTEM_SETTINGS_KEY_COUNT)
+	{
+		return;
+	}
+
+	g_atomic_int_set(&snapshot_dirty[key], 1);
+	g_atomic_int_set(&snapshot_dirty_any, 1);
+	g_atomic_int_inc(&snapshot_generation);
+}
+
+/*
+ * Changes of other processes are notified by vconf from the default main
+ * context. The cache is only trusted while a thread iterates it, otherwise
+ * every acquire reads all the keys again. The backends of the process notify
+ * while the value is written.
+ */
+static gboolean system_setting_snapshot_notified(void)
+{
+	GMainContext *context = g_main_context_default();
+
+	if (system_setting_backend_get() != &system_setting_backend_vconf)
+	{
+		return TRUE;
+	}
+
+	/* the Ecore main loop iterates the default context between its own events */
+	if (ecore_main_loop_nested_get() > 0)
+	{
+		return TRUE;
+	}
+
+	if (g_main_context_is_owner(context))
+	{
+		return g_main_depth() > 0;
+	}
+
+	if (!g_main_context_acquire(context))
+	{
+		/* owned by the thread which runs the main loop */
+		return TRUE;
+	}
+
+	g_main_context_release(context);
+
+	return FALSE;
+}
+
+/* the cache is only trusted while every key is watched for changes */
+static gboolean system_setting_snapshot_subscribe(void)
+{
+	system_setting_h system_setting_item;
+	int key;
+
+	for (key = 0; key < SYSTEM_SETTINGS_KEY_COUNT; key++)
+	{
+		system_settings_get_item(key, &system_setting_item);
+
+		if (system_setting_notify_ref(system_setting_item) != SYSTEM_SETTINGS_ERROR_NONE)
+		{
+			while (--key >= 0)
+			{
+				system_settings_get_item(key, &system_setting_item);
+				system_setting_notify_unref(system_setting_item);
+			}
+			return FALSE;
+		}
+	}
+
+	return TRUE;
+}
+
+static void system_setting_snapshot_free(system_settings_snapshot_h snapshot)
+{
+	int key;
+
+	for (key = 0; key < SYSTEM_SETTINGS_KEY_COUNT; key++)
+	{
+		system_setting_value_clear(&snapshot->values[key]);
+	}
+
+	g_free(snapshot);
+}
+
+static system_settings_snapshot_h system_setting_snapshot_build(system_settings_snapshot_h base)
+{
+	system_settings_snapshot_h snapshot = g_new0(struct system_settings_snapshot_s, 1);
+	gint generation = g_atomic_int_get(&snapshot_generation);
+	int tries;
+	int key;
+
+	snapshot->ref_count = 1;
+
+	for (key = 0; key < SYSTEM_SETTINGS_KEY_COUNT; key++)
+	{
+		/* clear the flag before reading so that a change during the read is not lost */
+		if (g_atomic_int_compare_and_exchange(&snapshot_dirty[key], 1, 0) || base == NULL)
+		{
+			snapshot->error[key] = system_setting_value_get(key, &snapshot->values[key]);
+		}
+		else
+		{
+			snapshot->error[key] = base->error[key];
+			system_setting_value_copy(&snapshot->values[key], &base->values[key]);
+		}
+	}
+
+	/* the keys changed while the others were read are read again */
+	for (tries = 1; tries < SNAPSHOT_BUILD_TRIES && generation != g_atomic_int_get(&snapshot_generation); tries++)
+	{
+		generation = g_atomic_int_get(&snapshot_generation);
+
+		for (key = 0; key < SYSTEM_SETTINGS_KEY_COUNT; key++)
+		{
+			if (g_atomic_int_compare_and_exchange(&snapshot_dirty[key], 1, 0))
+			{
+				system_setting_value_clear(&snapshot->values[key]);
+				snapshot->error[key] = system_setting_value_get(key, &snapshot->values[key]);
+			}
+		}
+	}
+
+	if (generation != g_atomic_int_get(&snapshot_generation))
+	{
+		g_atomic_int_set(&snapshot_dirty_any, 1);
+	}
+
+	return snapshot;
+}
+
+int system_settings_snapshot_acquire(system_settings_snapshot_h *snapshot)
+{
+	system_settings_snapshot_h base;
+
+	if (snapshot == NULL)
+	{
+		LOGE("[%s] INVALID_PARAMETER(0x%08x) : invalid snapshot", __FUNCTION__, SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER);
+		return SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER;
+	}
+
+	G_LOCK(system_settings_snapshot);
+
+	if (!snapshot_subscribed)
+	{
+		snapshot_subscribed = system_setting_snapshot_subscribe();
+	}
+
+	base = current_snapshot;
+
+	if (base != NULL && (!snapshot_subscribed || !system_setting_snapshot_notified()))
+	{
+		/* changes can not be tracked, start over */
+		current_snapshot = NULL;
+		system_settings_snapshot_release(base);
+		base = NULL;
+	}
+
+	if (g_atomic_int_compare_and_exchange(&snapshot_dirty_any, 1, 0) || base == NULL)
+	{
+		current_snapshot = system_setting_snapshot_build(base);
+
+		if (base != NULL)
+		{
+			system_settings_snapshot_release(base);
+		}
+	}
+
+	g_atomic_int_inc(&current_snapshot->ref_count);
+	*snapshot = current_snapshot;
+
+	G_UNLOCK(system_settings_snapshot);
+
+	return SYSTEM_SETTINGS_ERROR_NONE;
+}
+
+int system_settings_snapshot_release(system_settings_snapshot_h snapshot)
+{
+	if (snapshot == NULL)
+	{
+		LOGE("[%s] INVALID_PARAMETER(0x%08x) : invalid snapshot", __FUNCTION__, SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER);
+		return SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER;
+	}
+
+	if (g_atomic_int_dec_and_test(&snapshot->ref_count))
+	{
+		system_setting_snapshot_free(snapshot);
+	}
+
+	return SYSTEM_SETTINGS_ERROR_NONE;
+}
+
+static int system_setting_snapshot_get_value(system_settings_snapshot_h snapshot, system_settings_key_e key,
+		system_setting_data_type_e data_type, const system_setting_value_s **value)
+{
+	if (snapshot == NULL || (unsigned int)key >= SYSTEM_SETTINGS_KEY_COUNT || value == NULL)
+	{
+		LOGE("[%s] INVALID_PARAMETER(0x%08x) : invalid argument", __FUNCTION__, SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER);
+		return SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER;
+	}
+
+	if (snapshot->values[key].data_type != data_type)
+	{
+		LOGE("[%s] INVALID_PARAMETER(0x%08x) : invalid data type", __FUNCTION__, SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER);
+		return SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER;
+	}
+
+	if (snapshot->error[key] != SYSTEM_SETTINGS_ERROR_NONE)
+	{
+		return snapshot->error[key];
+	}
+
+	*value = &snapshot->values[key];
+	return SYSTEM_SETTINGS_ERROR_NONE;
+}
+
+int system_settings_snapshot_get_value_int(system_settings_snapshot_h snapshot, system_settings_key_e key, int *value)
+{
+	const system_setting_value_s *snapshot_value;
+	int ret = system_setting_snapshot_get_value(snapshot, key, SYSTEM_SETTING_DATA_TYPE_INT, &snapshot_value);
+
+	if (ret == SYSTEM_SETTINGS_ERROR_NONE)
+	{
+		*value = snapshot_value->value.i;
+	}
+	return ret;
+}
+
+int system_settings_snapshot_get_value_bool(system_settings_snapshot_h snapshot, system_settings_key_e key, bool *value)
+{
+	const system_setting_value_s *snapshot_value;
+	int ret = system_setting_snapshot_get_value(snapshot, key, SYSTEM_SETTING_DATA_TYPE_BOOL, &snapshot_value);
+
+	if (ret == SYSTEM_SETTINGS_ERROR_NONE)
+	{
+		*value = snapshot_value->value.b;
+	}
+	return ret;
+}
+
+int system_settings_snapshot_get_value_double(system_settings_snapshot_h snapshot, system_settings_key_e key, double *value)
+{
+	const system_setting_value_s *snapshot_value;
+	int ret = system_setting_snapshot_get_value(snapshot, key, SYSTEM_SETTING_DATA_TYPE_DOUBLE, &snapshot_value);
+
+	if (ret == SYSTEM_SETTINGS_ERROR_NONE)
+	{
+		*value = snapshot_value->value.d;
+	}
+	return ret;
+}
+
+int system_settings_snapshot_get_value_string(system_settings_snapshot_h snapshot, system_settings_key_e key, const char **value)
+{
+	const system_setting_value_s *snapshot_value;
+	int ret = system_setting_snapshot_get_value(snapshot, key, SYSTEM_SETTING_DATA_TYPE_STRING, &snapshot_value);
+
+	if (ret == SYSTEM_SETTINGS_ERROR_NONE)
+	{
+		*value = snapshot_value->value.s;
+	}
+	return ret;
+}
@@ -0,0 +1,53 @@
+/*
+ * Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <dlog.h>
+#include <glib.h>
+
+#include <system_settings.h>
+#include <system_settings_private.h>
+
+#ifdef LOG_TAG
+#undef LOG_TAG
+#endif
+
+#define LOG_TAG "TIZEN_N_SYSTEM_SETTINGS"
+
+
+static volatile gint system_setting_stats[SYSTEM_SETTING_STAT_COUNT];
+
+
+void system_setting_stat_inc(system_settings_stat_e stat)
+{
+	g_atomic_int_inc(&system_setting_stats[stat]);
+}
+
+/*PUBLIC*/
+int system_settings_get_stat(system_settings_stat_e stat, unsigned int *value)
+{
+	if ((unsigned int)stat >= SYSTEM_SETTING_STAT_COUNT || value == NULL)
+	{
+		LOGE("[%s] INVALID_PARAMETER(0x%08x) : invalid argument", __FUNCTION__, SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER);
+		return SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER;
+	}
+
+	*value = (unsigned int)g_atomic_int_get(&system_setting_stats[stat]);
+
+	return SYSTEM_SETTINGS_ERROR_NONE;
+}
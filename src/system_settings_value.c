@@ -0,0 +1,211 @@
+/*
+ * Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <dlog.h>
+#include <glib.h>
+
+#include <system_settings.h>
+#include <system_settings_private.h>
+
+#ifdef LOG_TAG
+#undef LOG_TAG
+#endif
+
+#define LOG_TAG "TIZEN_N_SYSTEM_SETTINGS"
+
+
+int system_setting_value_get(system_settings_key_e key, system_setting_value_s *value)
+{
+	system_setting_h system_setting_item;
+
+	memset(value, 0, sizeof(*value));
+
+	if (system_settings_get_item(key, &system_setting_item))
+	{
+		return SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER;
+	}
+
+	value->data_type = system_setting_item->data_type;
+
+	return system_settings_get_value(key, system_setting_item->data_type, (void**)&value->value);
+}
+
+void system_setting_value_copy(system_setting_value_s *dst, const system_setting_value_s *src)
+{
+	*dst = *src;
+
+	if (src->data_type == SYSTEM_SETTING_DATA_TYPE_STRING && src->value.s != NULL)
+	{
+		dst->value.s = strdup(src->value.s);
+	}
+}
+
+void system_setting_value_clear(system_setting_value_s *value)
+{
+	if (value->data_type == SYSTEM_SETTING_DATA_TYPE_STRING)
+	{
+		free(value->value.s);
+	}
+
+	memset(&value->value, 0, sizeof(value->value));
+}
+
+/* strings are borrowed, not copied */
+int system_setting_value_init(system_setting_value_s *value, system_setting_data_type_e data_type, void *raw)
+{
+	memset(value, 0, sizeof(*value));
+	value->data_type = data_type;
+
+	switch (data_type)
+	{
+	case SYSTEM_SETTING_DATA_TYPE_STRING:
+		value->value.s = (char*)raw;
+		return raw != NULL ? 0 : -1;
+
+	case SYSTEM_SETTING_DATA_TYPE_INT:
+		value->value.i = *(int*)raw;
+		return 0;
+
+	case SYSTEM_SETTING_DATA_TYPE_DOUBLE:
+		value->value.d = *(double*)raw;
+		return 0;
+
+	case SYSTEM_SETTING_DATA_TYPE_BOOL:
+		value->value.b = *(bool*)raw;
+		return 0;
+
+	default:
+		return -1;
+	}
+}
+
+/* a string is handed over to the caller */
+void system_setting_value_output(const system_setting_value_s *value, void **raw)
+{
+	switch (value->data_type)
+	{
+	case SYSTEM_SETTING_DATA_TYPE_STRING:
+		*(char**)raw = value->value.s;
+		break;
+
+	case SYSTEM_SETTING_DATA_TYPE_INT:
+		*(int*)raw = value->value.i;
+		break;
+
+	case SYSTEM_SETTING_DATA_TYPE_DOUBLE:
+		*(double*)raw = value->value.d;
+		break;
+
+	case SYSTEM_SETTING_DATA_TYPE_BOOL:
+		*(bool*)raw = value->value.b;
+		break;
+
+	default:
+		break;
+	}
+}
+
+bool system_setting_value_equal(const system_setting_value_s *a, const system_setting_value_s *b)
+{
+	if (a->data_type != b->data_type)
+	{
+		return false;
+	}
+
+	switch (a->data_type)
+	{
+	case SYSTEM_SETTING_DATA_TYPE_STRING:
+		return a->value.s != NULL && b->value.s != NULL && !strcmp(a->value.s, b->value.s);
+
+	case SYSTEM_SETTING_DATA_TYPE_INT:
+		return a->value.i == b->value.i;
+
+	case SYSTEM_SETTING_DATA_TYPE_DOUBLE:
+		return a->value.d == b->value.d;
+
+	case SYSTEM_SETTING_DATA_TYPE_BOOL:
+		return a->value.b == b->value.b;
+
+	default:
+		return false;
+	}
+}
+
+static int system_setting_value_check(system_settings_value_h value, system_setting_data_type_e data_type, void *out)
+{
+	if (value == NULL || out == NULL)
+	{
+		LOGE("[%s] INVALID_PARAMETER(0x%08x) : invalid argument", __FUNCTION__, SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER);
+		return SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER;
+	}
+
+	if (value->data_type != data_type)
+	{
+		LOGE("[%s] INVALID_PARAMETER(0x%08x) : invalid data type", __FUNCTION__, SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER);
+		return SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER;
+	}
+
+	return SYSTEM_SETTINGS_ERROR_NONE;
+}
+
+/*PUBLIC*/
+int system_settings_value_get_int(system_settings_value_h value, int *out)
+{
+	int ret = system_setting_value_check(value, SYSTEM_SETTING_DATA_TYPE_INT, out);
+
+	if (ret == SYSTEM_SETTINGS_ERROR_NONE)
+	{
+		*out = value->value.i;
+	}
+	return ret;
+}
+
+int system_settings_value_get_bool(system_settings_value_h value, bool *out)
+{
+	int ret = system_setting_value_check(value, SYSTEM_SETTING_DATA_TYPE_BOOL, out);
+
+	if (ret == SYSTEM_SETTINGS_ERROR_NONE)
+	{
+		*out = value->value.b;
+	}
+	return ret;
+}
+
+int system_settings_value_get_double(system_settings_value_h value, double *out)
+{
+	int ret = system_setting_value_check(value, SYSTEM_SETTING_DATA_TYPE_DOUBLE, out);
+
+	if (ret == SYSTEM_SETTINGS_ERROR_NONE)
+	{
+		*out = value->value.d;
+	}
+	return ret;
+}
+
+int system_settings_value_get_string(system_settings_value_h value, const char **out)
+{
+	int ret = system_setting_value_check(value, SYSTEM_SETTING_DATA_TYPE_STRING, out);
+
+	if (ret == SYSTEM_SETTINGS_ERROR_NONE)
+	{
+		*out = value->value.s;
+	}
+	return ret;
+}
@@ -17,12 +17,19 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/file.h>
 
 #include <vconf.h>
 #include <dlog.h>
+#include <glib.h>
 
 #include <system_settings.h>
 #include <system_settings_private.h>
+#include <system_settings_backend_private.h>
+#include <system_settings_trace_private.h>
 
 #ifdef LOG_TAG
 #undef LOG_TAG
@@ -31,204 +38,548 @@
 #define LOG_TAG "TIZEN_N_SYSTEM_SETTINGS"
 
 
+static int system_setting_vconf_backend_get_value(const char *vconf_key, system_setting_data_type_e data_type, system_setting_value_s *value)
+{
+	int vconf_value;
+
+	memset(value, 0, sizeof(*value));
+	value->data_type = data_type;
+
+	switch (data_type)
+	{
+	case SYSTEM_SETTING_DATA_TYPE_STRING:
+		value->value.s = vconf_get_str(vconf_key);
+		return value->value.s != NULL ? 0 : -1;
+
+	case SYSTEM_SETTING_DATA_TYPE_INT:
+		return vconf_get_int(vconf_key, &value->value.i);
+
+	case SYSTEM_SETTING_DATA_TYPE_DOUBLE:
+		return vconf_get_dbl(vconf_key, &value->value.d);
+
+	case SYSTEM_SETTING_DATA_TYPE_BOOL:
+		if (vconf_get_bool(vconf_key, &vconf_value))
+		{
+			return -1;
+		}
+		value->value.b = vconf_value ? true : false;
+		return 0;
+
+	default:
+		return -1;
+	}
+}
+
+static int system_setting_vconf_backend_set_value(const char *vconf_key, const system_setting_value_s *value)
+{
+	switch (value->data_type)
+	{
+	case SYSTEM_SETTING_DATA_TYPE_STRING:
+		return vconf_set_str(vconf_key, value->value.s);
+
+	case SYSTEM_SETTING_DATA_TYPE_INT:
+		return vconf_set_int(vconf_key, value->value.i);
+
+	case SYSTEM_SETTING_DATA_TYPE_DOUBLE:
+		return vconf_set_dbl(vconf_key, value->value.d);
+
+	case SYSTEM_SETTING_DATA_TYPE_BOOL:
+		return vconf_set_bool(vconf_key, (int)value->value.b);
+
+	default:
+		return -1;
+	}
+}
+
+/*
+ * vconf has no compare-and-set, it is emulated with a read and a write. The
+ * emulation holds a lock of the process and, for the vconf backend, an flock()
+ * of a file shared by the processes using the library, so that their
+ * compare-and-set writers are serialized. Plain writes are not.
+ *
+ * The file is created at boot in a directory owned by root and opened
+ * read-only, which is enough for flock(). A writer that holds it too long
+ * makes the others fail instead of blocking them.
+ */
+#define SYSTEM_SETTING_VCONF_CAS_LOCK_FILE "/run/system-settings/cas.lock"
+#define SYSTEM_SETTING_VCONF_CAS_LOCK_TIMEOUT_US (2 * G_USEC_PER_SEC)
+#define SYSTEM_SETTING_VCONF_CAS_LOCK_POLL_US (1000)
+
+G_LOCK_DEFINE_STATIC(system_setting_vconf_cas);
+
+static int system_setting_vconf_cas_fd = -1;
+static bool system_setting_vconf_cas_fd_opened;
+static bool system_setting_vconf_cas_flocked;
+
+/* called with the lock held */
+static int system_setting_vconf_cas_flock(void)
+{
+	gint64 deadline;
+
+	if (!system_setting_vconf_cas_fd_opened)
+	{
+		system_setting_vconf_cas_fd_opened = true;
+		system_setting_vconf_cas_fd = open(SYSTEM_SETTING_VCONF_CAS_LOCK_FILE, O_RDONLY | O_NOFOLLOW | O_CLOEXEC);
+
+		if (system_setting_vconf_cas_fd < 0)
+		{
+			LOGE("[%s] IO_ERROR(0x%08x) : failed to open %s (%d), compare-and-set is not serialized between processes", __FUNCTION__,
+				SYSTEM_SETTINGS_ERROR_IO_ERROR, SYSTEM_SETTING_VCONF_CAS_LOCK_FILE, errno);
+		}
+	}
+
+	if (system_setting_vconf_cas_fd < 0)
+	{
+		return 0;
+	}
+
+	deadline = g_get_monotonic_time() + SYSTEM_SETTING_VCONF_CAS_LOCK_TIMEOUT_US;
+
+	while (flock(system_setting_vconf_cas_fd, LOCK_EX | LOCK_NB))
+	{
+		if ((errno != EWOULDBLOCK && errno != EINTR) || g_get_monotonic_time() >= deadline)
+		{
+			LOGE("[%s] IO_ERROR(0x%08x) : failed to lock %s (%d)", __FUNCTION__, SYSTEM_SETTINGS_ERROR_IO_ERROR,
+				SYSTEM_SETTING_VCONF_CAS_LOCK_FILE, errno);
+			return -1;
+		}
+
+		g_usleep(SYSTEM_SETTING_VCONF_CAS_LOCK_POLL_US);
+	}
+
+	system_setting_vconf_cas_flocked = true;
+
+	return 0;
+}
+
+static int system_setting_vconf_cas_lock_between(bool between_processes)
+{
+	G_LOCK(system_setting_vconf_cas);
+
+	if (between_processes && system_setting_vconf_cas_flock())
+	{
+		G_UNLOCK(system_setting_vconf_cas);
+		return -1;
+	}
+
+	return 0;
+}
+
+int system_setting_vconf_cas_lock(void)
+{
+	return system_setting_vconf_cas_lock_between(system_setting_backend_get() == &system_setting_backend_vconf);
+}
+
+void system_setting_vconf_cas_unlock(void)
+{
+	if (system_setting_vconf_cas_flocked)
+	{
+		flock(system_setting_vconf_cas_fd, LOCK_UN);
+		system_setting_vconf_cas_flocked = false;
+	}
+
+	G_UNLOCK(system_setting_vconf_cas);
+}
+
+/* called with the lock held */
+static int system_setting_vconf_cas_emulate(const system_setting_backend_s *backend, const char *vconf_key,
+	const system_setting_value_s *expected, const system_setting_value_s *value, system_setting_value_s *current)
+{
+	system_setting_value_s stored;
+
+	if (backend->get_value(vconf_key, expected->data_type, &stored))
+	{
+		return -1;
+	}
+
+	if (!system_setting_value_equal(&stored, expected))
+	{
+		if (current != NULL)
+		{
+			*current = stored;
+		}
+		else
+		{
+			system_setting_value_clear(&stored);
+		}
+		return SYSTEM_SETTING_BACKEND_MISMATCH;
+	}
+
+	system_setting_value_clear(&stored);
+
+	return backend->set_value(vconf_key, value);
+}
+
+static int system_setting_vconf_backend_compare_and_set(const char *vconf_key, const system_setting_value_s *expected,
+	const system_setting_value_s *value, system_setting_value_s *current)
+{
+	int ret;
+
+	if (system_setting_vconf_cas_lock_between(true))
+	{
+		return -1;
+	}
+
+	ret = system_setting_vconf_cas_emulate(&system_setting_backend_vconf, vconf_key, expected, value, current);
+
+	system_setting_vconf_cas_unlock();
+
+	return ret;
+}
+
+static int system_setting_vconf_backend_watch(const char *vconf_key, system_settings_key_e key);
+static int system_setting_vconf_backend_unwatch(const char *vconf_key);
+
+const system_setting_backend_s system_setting_backend_vconf = {
+	.name = "vconf",
+	.get_value = system_setting_vconf_backend_get_value,
+	.set_value = system_setting_vconf_backend_set_value,
+	.compare_and_set = system_setting_vconf_backend_compare_and_set,
+	.watch = system_setting_vconf_backend_watch,
+	.unwatch = system_setting_vconf_backend_unwatch,
+};
+
+static const system_setting_backend_s *system_setting_backend = &system_setting_backend_vconf;
+
+void system_setting_backend_set(const system_setting_backend_s *backend)
+{
+	g_atomic_pointer_set(&system_setting_backend, backend != NULL ? backend : &system_setting_backend_vconf);
+}
+
+const system_setting_backend_s *system_setting_backend_get(void)
+{
+	return g_atomic_pointer_get(&system_setting_backend);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+static int system_setting_vconf_get(const char *vconf_key, system_setting_data_type_e data_type, system_setting_value_s *value)
+{
+	return system_setting_backend_get()->get_value(vconf_key, data_type, value);
+}
+
 int system_setting_vconf_get_value_int(const char *vconf_key, int *value)
 {
-	return vconf_get_int(vconf_key, value);
+	system_setting_value_s vconf_value;
+
+	if (system_setting_vconf_get(vconf_key, SYSTEM_SETTING_DATA_TYPE_INT, &vconf_value))
+	{
+		return -1;
+	}
+
+	*value = vconf_value.value.i;
+	return 0;
 }
 
 int system_setting_vconf_get_value_bool(const char *vconf_key, bool *value)
 {
-	return vconf_get_bool(vconf_key, (int*)value);
+	system_setting_value_s vconf_value;
+
+	if (system_setting_vconf_get(vconf_key, SYSTEM_SETTING_DATA_TYPE_BOOL, &vconf_value))
+	{
+		return -1;
+	}
+
+	*value = vconf_value.value.b;
+	return 0;
 }
 
 int system_setting_vconf_get_value_double(const char *vconf_key, double *value)
 {
-	return vconf_get_dbl(vconf_key, value);
+	system_setting_value_s vconf_value;
+
+	if (system_setting_vconf_get(vconf_key, SYSTEM_SETTING_DATA_TYPE_DOUBLE, &vconf_value))
+	{
+		return -1;
+	}
+
+	*value = vconf_value.value.d;
+	return 0;
 }
 
 int system_setting_vconf_get_value_string(const char *vconf_key, char **value)
 {
-    char *str_value = NULL;
+	system_setting_value_s vconf_value;
 
-    str_value = vconf_get_str(vconf_key);
-        
-    if (str_value != NULL)
-    {
-        *value = str_value;
-        return 0;
-    }
-    else
-    {
-        return -1;
-    }
+	if (system_setting_vconf_get(vconf_key, SYSTEM_SETTING_DATA_TYPE_STRING, &vconf_value))
+	{
+		return -1;
+	}
+
+	*value = vconf_value.value.s;
+	return 0;
+}
+
+int system_setting_vconf_get_value(const char *vconf_key, system_setting_data_type_e data_type, void **value)
+{
+	switch (data_type)
+	{
+	case SYSTEM_SETTING_DATA_TYPE_STRING:
+		return system_setting_vconf_get_value_string(vconf_key, (char**)value);
+
+	case SYSTEM_SETTING_DATA_TYPE_INT:
+		return system_setting_vconf_get_value_int(vconf_key, (int*)value);
+
+	case SYSTEM_SETTING_DATA_TYPE_DOUBLE:
+		return system_setting_vconf_get_value_double(vconf_key, (double*)value);
+
+	case SYSTEM_SETTING_DATA_TYPE_BOOL:
+		return system_setting_vconf_get_value_bool(vconf_key, (bool*)value);
+
+	default:
+		return -1;
+	}
+}
+
+static int system_setting_vconf_set(const char *vconf_key, system_setting_value_s *value)
+{
+	return system_setting_backend_get()->set_value(vconf_key, value);
 }
 
 int system_setting_vconf_set_value_int(const char *vconf_key, int value)
 {
-	return vconf_set_int(vconf_key, value);
+	system_setting_value_s vconf_value = { .data_type = SYSTEM_SETTING_DATA_TYPE_INT, .value.i = value };
+
+	return system_setting_vconf_set(vconf_key, &vconf_value);
 }
 
 int system_setting_vconf_set_value_bool(const char *vconf_key, bool value)
 {
-	return vconf_set_bool(vconf_key, (int)value);
+	system_setting_value_s vconf_value = { .data_type = SYSTEM_SETTING_DATA_TYPE_BOOL, .value.b = value };
+
+	return system_setting_vconf_set(vconf_key, &vconf_value);
 }
 
 int system_setting_vconf_set_value_double(const char *vconf_key, double value)
 {
-	return vconf_set_dbl(vconf_key, value);
+	system_setting_value_s vconf_value = { .data_type = SYSTEM_SETTING_DATA_TYPE_DOUBLE, .value.d = value };
+
+	return system_setting_vconf_set(vconf_key, &vconf_value);
 }
 
 int system_setting_vconf_set_value_string(const char *vconf_key, char *value)
 {
-    return vconf_set_str(vconf_key, value);
+	system_setting_value_s vconf_value = { .data_type = SYSTEM_SETTING_DATA_TYPE_STRING, .value.s = value };
+
+	return system_setting_vconf_set(vconf_key, &vconf_value);
 }
 
 
-/////////////////////////////////////////////////////////////////////////////////////////////
+int system_setting_vconf_set_value(const char *vconf_key, system_setting_data_type_e data_type, void *value)
+{
+	switch (data_type)
+	{
+	case SYSTEM_SETTING_DATA_TYPE_STRING:
+		return system_setting_vconf_set_value_string(vconf_key, (char*)value);
 
-typedef void (*system_setting_vconf_event_cb)(keynode_t *node, void *event_data);
-    
-static void system_setting_vconf_event_cb0(keynode_t *node, void *event_data)
-{       
-	system_settings_key_e pkey = (system_settings_key_e)event_data;
-	printf("*** system_setting_vconf_event_cb0  : %d \n",pkey );
+	case SYSTEM_SETTING_DATA_TYPE_INT:
+		return system_setting_vconf_set_value_int(vconf_key, *(int*)value);
 
-    if (node != NULL)
-    {
-		system_setting_h system_setting_item;
-																														  
-		if (system_settings_get_item(pkey, &system_setting_item))
-		{
-			LOGE("[%s] INVALID_PARAMETER(0x%08x) : invalid key", __FUNCTION__, SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER);
-		}
-		system_setting_item->changed_cb(pkey, NULL);
-    }       
-}
-    
-static void system_setting_vconf_event_cb1(keynode_t *node, void *event_data)
-{       
-	system_settings_key_e pkey = (system_settings_key_e)event_data;
-	printf("*** system_setting_vconf_event_cb1  : %d \n",pkey );
+	case SYSTEM_SETTING_DATA_TYPE_DOUBLE:
+		return system_setting_vconf_set_value_double(vconf_key, *(double*)value);
 
-    if (node != NULL)
-    {
-		system_setting_h system_setting_item;
-																														  
-		if (system_settings_get_item(pkey, &system_setting_item))
-		{
-			LOGE("[%s] INVALID_PARAMETER(0x%08x) : invalid key", __FUNCTION__, SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER);
-		}
-		system_setting_item->changed_cb(pkey, NULL);
-    }       
-}
-    
-static void system_setting_vconf_event_cb2(keynode_t *node, void *event_data)
-{       
-	system_settings_key_e pkey = (system_settings_key_e)event_data;
-	printf("*** system_setting_vconf_event_cb2  : %d \n",pkey );
+	case SYSTEM_SETTING_DATA_TYPE_BOOL:
+		return system_setting_vconf_set_value_bool(vconf_key, *(bool*)value);
 
-    if (node != NULL)
-    {
-		system_setting_h system_setting_item;
-																														  
-		if (system_settings_get_item(pkey, &system_setting_item))
-		{
-			LOGE("[%s] INVALID_PARAMETER(0x%08x) : invalid key", __FUNCTION__, SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER);
-		}
-		system_setting_item->changed_cb(pkey, NULL);
-    }       
+	default:
+		return -1;
+	}
 }
 
-static void system_setting_vconf_event_cb3(keynode_t *node, void *event_data)
+/* value points to the value as for system_setting_vconf_set_value(), strings are borrowed */
+int system_setting_vconf_compare_and_set_value(const char *vconf_key, system_setting_data_type_e data_type, void *expected, void *value, void **current)
 {
-	system_settings_key_e pkey = (system_settings_key_e)event_data;
-	printf("*** system_setting_vconf_event_cb3  : %d \n",pkey );
-
-    if (node != NULL)
-    {
-		system_setting_h system_setting_item;
-																														  
-		if (system_settings_get_item(pkey, &system_setting_item))
-		{
-			LOGE("[%s] INVALID_PARAMETER(0x%08x) : invalid key", __FUNCTION__, SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER);
-		}
-		system_setting_item->changed_cb(pkey, NULL);
-    }       
+	const system_setting_backend_s *backend = system_setting_backend_get();
+	system_setting_value_s expected_value;
+	system_setting_value_s new_value;
+	system_setting_value_s current_value;
+	int ret;
+
+	if (system_setting_value_init(&expected_value, data_type, expected) || system_setting_value_init(&new_value, data_type, value))
+	{
+		return -1;
+	}
+
+	memset(&current_value, 0, sizeof(current_value));
+	current_value.data_type = data_type;
+
+	if (backend->compare_and_set != NULL)
+	{
+		ret = backend->compare_and_set(vconf_key, &expected_value, &new_value, current != NULL ? &current_value : NULL);
+	}
+	else
+	{
+		system_setting_vconf_cas_lock_between(false);
+		ret = system_setting_vconf_cas_emulate(backend, vconf_key, &expected_value, &new_value, current != NULL ? &current_value : NULL);
+		system_setting_vconf_cas_unlock();
+	}
+
+	if (ret == SYSTEM_SETTING_BACKEND_MISMATCH && current != NULL)
+	{
+		system_setting_value_output(&current_value, current);
+	}
+
+	return ret;
 }
 
-static void system_setting_vconf_event_cb4(keynode_t *node, void *event_data)
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+static volatile int system_setting_vconf_changed_filter;
+
+/* the returned string is borrowed from the node */
+static int system_setting_vconf_keynode_get_value(keynode_t *node, system_setting_data_type_e data_type, system_setting_value_s *value)
 {
-	system_settings_key_e pkey = (system_settings_key_e)event_data;
-	printf("*** system_setting_vconf_event_cb4  : %d \n",pkey );
+	value->data_type = data_type;
 
-    if (node != NULL)
-    {
-		system_setting_h system_setting_item;
-																														  
-		if (system_settings_get_item(pkey, &system_setting_item))
-		{
-			LOGE("[%s] INVALID_PARAMETER(0x%08x) : invalid key", __FUNCTION__, SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER);
-		}
-		system_setting_item->changed_cb(pkey, NULL);
-    }       
+	switch (vconf_keynode_get_type(node))
+	{
+	case VCONF_TYPE_STRING:
+		value->value.s = vconf_keynode_get_str(node);
+		return data_type == SYSTEM_SETTING_DATA_TYPE_STRING ? 0 : -1;
+
+	case VCONF_TYPE_INT:
+		value->value.i = vconf_keynode_get_int(node);
+		return data_type == SYSTEM_SETTING_DATA_TYPE_INT ? 0 : -1;
+
+	case VCONF_TYPE_DOUBLE:
+		value->value.d = vconf_keynode_get_dbl(node);
+		return data_type == SYSTEM_SETTING_DATA_TYPE_DOUBLE ? 0 : -1;
+
+	case VCONF_TYPE_BOOL:
+		value->value.b = vconf_keynode_get_bool(node) ? true : false;
+		return data_type == SYSTEM_SETTING_DATA_TYPE_BOOL ? 0 : -1;
+
+	default:
+		return -1;
+	}
 }
 
+/* returns true when value is the value which was notified last */
+/* notifications of a key may come from several threads, the last values are only touched under the lock */
+G_LOCK_DEFINE_STATIC(system_setting_vconf_last_value);
 
-static system_setting_vconf_event_cb system_setting_vconf_get_event_cb_slot(int slot)
+static bool system_setting_vconf_changed_filter_match(system_setting_h item, const system_setting_value_s *value)
 {
-    switch (slot)
-    {
-    case 0:
-        return system_setting_vconf_event_cb0;
+	system_setting_value_s previous;
+	bool match;
 
-    case 1:
-        return system_setting_vconf_event_cb1;
+	G_LOCK(system_setting_vconf_last_value);
 
-    case 2:
-        return system_setting_vconf_event_cb2;
+	match = item->has_last_value && system_setting_value_equal(&item->last_value, value);
 
-    case 3:
-        return system_setting_vconf_event_cb3;
+	if (!match)
+	{
+		previous = item->last_value;
+		system_setting_value_copy(&item->last_value, value);
+		item->has_last_value = true;
+	}
 
-    case 4:
-        return system_setting_vconf_event_cb4;
+	G_UNLOCK(system_setting_vconf_last_value);
 
-    default:
-        return NULL;
-    }
+	/* freed outside the lock */
+	if (!match)
+	{
+		system_setting_value_clear(&previous);
+	}
+
+	return match;
 }
 
-int system_setting_vconf_set_changed_cb(const char *vconf_key, system_settings_key_e key, int slot)
+/*
+ * Common entry of the change notifications of every backend: statistics, the
+ * changed filter and the notification of the registered callbacks.
+ */
+void system_setting_backend_changed(system_settings_key_e key, const system_setting_value_s *value)
 {
-    system_setting_vconf_event_cb vconf_event_cb;
-
-    vconf_event_cb = system_setting_vconf_get_event_cb_slot(slot);
+	system_setting_h system_setting_item;
+
+	system_setting_stat_inc(SYSTEM_SETTINGS_STAT_NOTIFICATIONS);
+	SYSTEM_SETTING_TRACE1(dispatch_entry, key);
+
+	if (key & SYSTEM_SETTING_CONTEXT_WATCH_FLAG)
+	{
+		system_setting_context_changed(key, value);
+		SYSTEM_SETTING_TRACE1(dispatch_return, key);
+		return;
+	}
+
+	/* the key has a value again */
+	system_setting_backoff_reset(key);
+
+	if (system_setting_vconf_changed_filter && value != NULL
+		&& !system_settings_get_item(key, &system_setting_item)
+		&& system_setting_vconf_changed_filter_match(system_setting_item, value))
+	{
+		system_setting_stat_inc(SYSTEM_SETTINGS_STAT_NOTIFICATIONS_FILTERED);
+		SYSTEM_SETTING_TRACE1(dispatch_return, key);
+		return;
+	}
+
+	system_setting_notify_changed(key, value);
+	SYSTEM_SETTING_TRACE1(dispatch_return, key);
+}
 
-    if (vconf_event_cb == NULL)
-    {
-        return SYSTEM_SETTINGS_ERROR_IO_ERROR;
-    }
+/*
+ * vconf identifies a subscription by (vconf key, callback), so a single callback
+ * serves every key. The system settings key is passed as the event data.
+ */
+static void system_setting_vconf_event_cb(keynode_t *node, void *event_data)
+{
+	system_settings_key_e pkey = (system_settings_key_e)(long)event_data;
+	system_settings_key_e item_key = pkey;
+	system_setting_h system_setting_item;
+	system_setting_value_s value;
+	bool has_value;
+
+	if (node == NULL)
+	{
+		return;
+	}
+
+	if (pkey & SYSTEM_SETTING_CONTEXT_WATCH_FLAG)
+	{
+		item_key = SYSTEM_SETTING_CONTEXT_WATCH_ITEM(pkey);
+	}
+
+	has_value = !system_settings_get_item(item_key, &system_setting_item)
+		&& !system_setting_vconf_keynode_get_value(node, system_setting_item->data_type, &value);
+
+	system_setting_backend_changed(pkey, has_value ? &value : NULL);
+}
 
-    if (vconf_notify_key_changed(vconf_key, vconf_event_cb, (void*)key))
-    {
-        return SYSTEM_SETTINGS_ERROR_IO_ERROR;
-    }
+/*PUBLIC*/
+int system_settings_set_changed_filter(bool enable)
+{
+	system_setting_vconf_changed_filter = enable;
 
-    return SYSTEM_SETTINGS_ERROR_NONE;
+	return SYSTEM_SETTINGS_ERROR_NONE;
 }
 
-int system_setting_vconf_unset_changed_cb(const char *vconf_key, int slot)
+static int system_setting_vconf_backend_watch(const char *vconf_key, system_settings_key_e key)
 {
-    system_setting_vconf_event_cb vconf_event_cb;
+	return vconf_notify_key_changed(vconf_key, system_setting_vconf_event_cb, (void*)(long)key) ? -1 : 0;
+}
 
-    vconf_event_cb = system_setting_vconf_get_event_cb_slot(slot);
+static int system_setting_vconf_backend_unwatch(const char *vconf_key)
+{
+	vconf_ignore_key_changed(vconf_key, system_setting_vconf_event_cb);
+	return 0;
+}
 
-    if (vconf_event_cb != NULL)
+int system_setting_vconf_set_changed_cb(const char *vconf_key, system_settings_key_e key)
+{
+    if (system_setting_backend_get()->watch(vconf_key, key))
     {
-        vconf_ignore_key_changed(vconf_key, vconf_event_cb);
+        return SYSTEM_SETTINGS_ERROR_IO_ERROR;
     }
 
     return SYSTEM_SETTINGS_ERROR_NONE;
 }
 
+int system_setting_vconf_unset_changed_cb(const char *vconf_key)
+{
+    system_setting_backend_get()->unwatch(vconf_key);
 
+    return SYSTEM_SETTINGS_ERROR_NONE;
+}
@@ -0,0 +1,160 @@
+/*
+ * Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include <dlog.h>
+#include <glib.h>
+
+#include <system_settings.h>
+#include <system_settings_private.h>
+#include <system_settings_vendor_private.h>
+
+#ifdef LOG_TAG
+#undef LOG_TAG
+#endif
+
+#define LOG_TAG "TIZEN_N_SYSTEM_SETTINGS"
+
+
+static const system_setting_vendor_header_s *vendor_header;
+static const system_setting_vendor_record_s *vendor_records;
+static const char *vendor_strings;
+
+/* items are filled in from the mapped records on first lookup */
+static system_setting_s *vendor_items;
+
+
+static int system_setting_vendor_schema_valid(const system_setting_vendor_header_s *header, size_t size)
+{
+	size_t records_end;
+
+	if (size < sizeof(*header)
+		|| header->magic != SYSTEM_SETTING_VENDOR_SCHEMA_MAGIC
+		|| header->version != SYSTEM_SETTING_VENDOR_SCHEMA_VERSION)
+	{
+		return 0;
+	}
+
+	/* checked before multiplying, a crafted count must not wrap records_end */
+	if (header->count > (size - sizeof(*header)) / sizeof(system_setting_vendor_record_s))
+	{
+		return 0;
+	}
+
+	records_end = sizeof(*header) + (size_t)header->count * sizeof(system_setting_vendor_record_s);
+
+	if (header->strings_size == 0
+		|| header->strings_offset < records_end
+		|| header->strings_offset > size
+		|| header->strings_size > size - header->strings_offset)
+	{
+		return 0;
+	}
+
+	/* every string ends inside the pool */
+	return ((const char*)header)[header->strings_offset + header->strings_size - 1] == '\0';
+}
+
+static void system_setting_vendor_schema_map(void)
+{
+	struct stat st;
+	void *map;
+	int fd;
+
+	fd = open(SYSTEM_SETTING_VENDOR_SCHEMA_FILE, O_RDONLY | O_CLOEXEC);
+
+	if (fd < 0)
+	{
+		return;
+	}
+
+	if (fstat(fd, &st) || st.st_size <= 0)
+	{
+		close(fd);
+		return;
+	}
+
+	map = mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+	close(fd);
+
+	if (map == MAP_FAILED)
+	{
+		LOGE("[%s] IO_ERROR(0x%08x) : failed to map %s", __FUNCTION__, SYSTEM_SETTINGS_ERROR_IO_ERROR, SYSTEM_SETTING_VENDOR_SCHEMA_FILE);
+		return;
+	}
+
+	if (!system_setting_vendor_schema_valid(map, st.st_size))
+	{
+		LOGE("[%s] IO_ERROR(0x%08x) : invalid vendor schema %s", __FUNCTION__, SYSTEM_SETTINGS_ERROR_IO_ERROR, SYSTEM_SETTING_VENDOR_SCHEMA_FILE);
+		munmap(map, st.st_size);
+		return;
+	}
+
+	vendor_items = g_new0(system_setting_s, ((const system_setting_vendor_header_s*)map)->count);
+	vendor_header = map;
+	vendor_records = (const system_setting_vendor_record_s*)(vendor_header + 1);
+	vendor_strings = (const char*)map + vendor_header->strings_offset;
+}
+
+int system_setting_vendor_get_item(system_settings_key_e key, system_setting_h *item)
+{
+	static gsize vendor_schema_mapped = 0;
+	const system_setting_vendor_record_s *record;
+	system_setting_h vendor_item;
+	unsigned int index;
+
+	if (g_once_init_enter(&vendor_schema_mapped))
+	{
+		system_setting_vendor_schema_map();
+		g_once_init_leave(&vendor_schema_mapped, 1);
+	}
+
+	index = (unsigned int)key - SYSTEM_SETTINGS_KEY_VENDOR_BASE;
+
+	if (vendor_header == NULL || index >= vendor_header->count)
+	{
+		return -1;
+	}
+
+	record = &vendor_records[index];
+
+	if (record->data_type > SYSTEM_SETTING_DATA_TYPE_BOOL
+		|| record->vconf_key >= vendor_header->strings_size)
+	{
+		return -1;
+	}
+
+	vendor_item = &vendor_items[index];
+
+	if (g_atomic_pointer_get(&vendor_item->vconf_key) == NULL)
+	{
+		vendor_item->key = key;
+		vendor_item->data_type = record->data_type;
+		vendor_item->min = record->min;
+		vendor_item->max = record->max;
+		g_atomic_pointer_set(&vendor_item->vconf_key, (gpointer)(vendor_strings + record->vconf_key));
+	}
+
+	*item = vendor_item;
+	return 0;
+}
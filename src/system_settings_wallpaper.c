@@ -0,0 +1,432 @@
+/*
+ * Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+
+#include <dlog.h>
+#include <glib.h>
+
+#include <Ecore_X.h>
+#include <Elementary.h>
+
+#include <system_settings.h>
+#include <system_settings_private.h>
+
+#ifdef LOG_TAG
+#undef LOG_TAG
+#endif
+
+#define LOG_TAG "TIZEN_N_SYSTEM_SETTINGS"
+
+#define WALLPAPER_CACHE_DIR "/opt/var/cache/system-settings/wallpaper"
+#define WALLPAPER_HASH_CHUNK (64 * 1024)
+
+/* the palette is computed on a thumbnail of this size */
+#define WALLPAPER_PALETTE_SAMPLE 64
+
+
+static volatile gint wallpaper_prescale;
+
+
+/* derived vconf key holding "<cache path>\t<wallpaper path>" */
+static const char *system_setting_wallpaper_cache_key(system_settings_key_e key)
+{
+	return key == SYSTEM_SETTINGS_KEY_WALLPAPER_HOME_SCREEN
+		? VCONFKEY_SETAPPL_WALLPAPER_HOME_SCREEN_CACHE_STR : VCONFKEY_SETAPPL_WALLPAPER_LOCK_SCREEN_CACHE_STR;
+}
+
+/* derived vconf key holding "<dominant> <accent>...\t<wallpaper path>", colours in hexadecimal */
+static const char *system_setting_wallpaper_palette_key(system_settings_key_e key)
+{
+	return key == SYSTEM_SETTINGS_KEY_WALLPAPER_HOME_SCREEN
+		? VCONFKEY_SETAPPL_WALLPAPER_HOME_SCREEN_PALETTE_STR : VCONFKEY_SETAPPL_WALLPAPER_LOCK_SCREEN_PALETTE_STR;
+}
+
+static char *system_setting_wallpaper_hash(const char *path)
+{
+	GChecksum *checksum;
+	unsigned char *buf;
+	ssize_t len;
+	char *hash = NULL;
+	struct stat st;
+	int fd;
+
+	/* O_NONBLOCK so that a FIFO does not block the open, it is rejected by the S_ISREG check */
+	fd = open(path, O_RDONLY | O_NONBLOCK | O_CLOEXEC);
+
+	if (fd < 0)
+	{
+		return NULL;
+	}
+
+	if (fstat(fd, &st) || !S_ISREG(st.st_mode))
+	{
+		close(fd);
+		return NULL;
+	}
+
+	buf = malloc(WALLPAPER_HASH_CHUNK);
+	checksum = g_checksum_new(G_CHECKSUM_SHA1);
+
+	while (buf != NULL && (len = read(fd, buf, WALLPAPER_HASH_CHUNK)) > 0)
+	{
+		g_checksum_update(checksum, buf, len);
+	}
+
+	if (buf != NULL && len == 0)
+	{
+		hash = g_strdup(g_checksum_get_string(checksum));
+	}
+
+	g_checksum_free(checksum);
+	free(buf);
+	close(fd);
+
+	return hash;
+}
+
+/*
+ * Decodes the image at the size of the root window, scaled to cover it with
+ * the aspect ratio kept, and saves it to cache_path. Returns false when the
+ * image is not larger than the screen, the original is then used as is.
+ */
+static bool system_setting_wallpaper_prescale(const char *path, const char *cache_path, int screen_w, int screen_h)
+{
+	Ecore_Evas *ee;
+	Evas_Object *image;
+	char *tmp_path;
+	double scale;
+	int image_w, image_h;
+	bool ret = false;
+
+	ecore_evas_init();
+	ee = ecore_evas_buffer_new(1, 1);
+
+	if (ee == NULL)
+	{
+		ecore_evas_shutdown();
+		return false;
+	}
+
+	image = evas_object_image_add(ecore_evas_get(ee));
+
+	/* lets the decoder scale down, e.g. JPEG DCT scaling, the result is still at least this size */
+	evas_object_image_load_size_set(image, screen_w, screen_h);
+	evas_object_image_file_set(image, path, NULL);
+	evas_object_image_size_get(image, &image_w, &image_h);
+
+	if (evas_object_image_load_error_get(image) == EVAS_LOAD_ERROR_NONE && image_w > 0 && image_h > 0)
+	{
+		scale = (double)screen_w / image_w > (double)screen_h / image_h
+			? (double)screen_w / image_w : (double)screen_h / image_h;
+
+		if (scale < 1.0)
+		{
+			evas_object_image_smooth_scale_set(image, EINA_TRUE);
+			evas_object_image_scale(image, (int)(image_w * scale + 0.5), (int)(image_h * scale + 0.5));
+
+			/* written aside and renamed so that readers never see a partial file */
+			tmp_path = g_strdup_printf("%s.%d.jpg", cache_path, getpid());
+
+			if (evas_object_image_save(image, tmp_path, NULL, "quality=90") && !rename(tmp_path, cache_path))
+			{
+				ret = true;
+			}
+			else
+			{
+				unlink(tmp_path);
+			}
+
+			g_free(tmp_path);
+		}
+	}
+
+	evas_object_del(image);
+	ecore_evas_free(ee);
+	ecore_evas_shutdown();
+
+	return ret;
+}
+
+static int system_setting_wallpaper_palette(const char *path, system_settings_palette_s *palette)
+{
+	Ecore_Evas *ee;
+	Evas_Object *image;
+	const unsigned int *pixels;
+	int image_w, image_h;
+	int ret = SYSTEM_SETTINGS_ERROR_IO_ERROR;
+
+	ecore_evas_init();
+	ee = ecore_evas_buffer_new(1, 1);
+
+	if (ee == NULL)
+	{
+		ecore_evas_shutdown();
+		return SYSTEM_SETTINGS_ERROR_IO_ERROR;
+	}
+
+	image = evas_object_image_add(ecore_evas_get(ee));
+
+	evas_object_image_load_size_set(image, WALLPAPER_PALETTE_SAMPLE, WALLPAPER_PALETTE_SAMPLE);
+	evas_object_image_file_set(image, path, NULL);
+	evas_object_image_size_get(image, &image_w, &image_h);
+
+	if (evas_object_image_load_error_get(image) == EVAS_LOAD_ERROR_NONE && image_w > 0 && image_h > 0)
+	{
+		if (image_w > WALLPAPER_PALETTE_SAMPLE || image_h > WALLPAPER_PALETTE_SAMPLE)
+		{
+			evas_object_image_scale(image, WALLPAPER_PALETTE_SAMPLE, WALLPAPER_PALETTE_SAMPLE);
+			evas_object_image_size_get(image, &image_w, &image_h);
+		}
+
+		pixels = evas_object_image_data_get(image, EINA_FALSE);
+
+		if (pixels != NULL)
+		{
+			ret = system_setting_palette_compute(pixels, image_w, image_h, evas_object_image_stride_get(image), palette);
+		}
+	}
+
+	evas_object_del(image);
+	ecore_evas_free(ee);
+	ecore_evas_shutdown();
+
+	return ret;
+}
+
+static bool system_setting_wallpaper_palette_parse(const char *palette_value, const char *path, system_settings_palette_s *palette)
+{
+	const char *separator = strchr(palette_value, '\t');
+	char *end;
+	int i;
+
+	if (separator == NULL || strcmp(separator + 1, path))
+	{
+		return false;
+	}
+
+	memset(palette, 0, sizeof(*palette));
+	palette->dominant = strtoul(palette_value, &end, 16);
+
+	for (i = 0; i < SYSTEM_SETTINGS_PALETTE_ACCENT_MAX && *end == ' '; i++)
+	{
+		palette->accents[i] = strtoul(end + 1, &end, 16);
+	}
+
+	palette->accent_count = i;
+
+	return end == separator;
+}
+
+/*
+ * Removes the copies which neither screen uses any more, so that the cache
+ * holds at most the copies of the current home and lock screen wallpapers.
+ */
+static void system_setting_wallpaper_evict(system_settings_key_e key, const char *cache_path)
+{
+	system_settings_key_e other = key == SYSTEM_SETTINGS_KEY_WALLPAPER_HOME_SCREEN
+		? SYSTEM_SETTINGS_KEY_WALLPAPER_LOCK_SCREEN : SYSTEM_SETTINGS_KEY_WALLPAPER_HOME_SCREEN;
+	char *other_value = NULL;
+	char *separator;
+	const char *name;
+	char *file;
+	GDir *dir;
+
+	if (!system_setting_vconf_get_value_string(system_setting_wallpaper_cache_key(other), &other_value)
+		&& (separator = strchr(other_value, '\t')) != NULL)
+	{
+		*separator = '\0';
+	}
+
+	dir = g_dir_open(WALLPAPER_CACHE_DIR, 0, NULL);
+
+	if (dir == NULL)
+	{
+		free(other_value);
+		return;
+	}
+
+	while ((name = g_dir_read_name(dir)) != NULL)
+	{
+		/* "<hash>-<w>x<h>.jpg", the files being written by system_setting_wallpaper_prescale() have more dots */
+		if (strchr(name, '.') != strrchr(name, '.'))
+		{
+			continue;
+		}
+
+		file = g_build_filename(WALLPAPER_CACHE_DIR, name, NULL);
+
+		if ((cache_path == NULL || strcmp(file, cache_path))
+			&& (other_value == NULL || strcmp(file, other_value)))
+		{
+			unlink(file);
+		}
+
+		g_free(file);
+	}
+
+	g_dir_close(dir);
+	free(other_value);
+}
+
+// [string] computes the palette and creates the pre-scaled copy of the wallpaper before its path is written
+int system_setting_check_wallpaper(system_settings_key_e key, system_setting_data_type_e data_type, void* value)
+{
+	const char *path = value;
+	system_settings_palette_s palette;
+	GString *palette_value;
+	char *hash;
+	char *cache_path = NULL;
+	char *cache_value;
+	int screen_w = 0, screen_h = 0;
+	int i;
+
+	/* the palette is otherwise computed by system_settings_get_wallpaper_palette() when asked for */
+	if (path == NULL || !g_atomic_int_get(&wallpaper_prescale))
+	{
+		return SYSTEM_SETTINGS_ERROR_NONE;
+	}
+
+	/* written before the wallpaper key, so change callbacks of the key already see it */
+	if (system_setting_wallpaper_palette(path, &palette) == SYSTEM_SETTINGS_ERROR_NONE)
+	{
+		palette_value = g_string_new(NULL);
+		g_string_append_printf(palette_value, "%06x", palette.dominant);
+
+		for (i = 0; i < palette.accent_count; i++)
+		{
+			g_string_append_printf(palette_value, " %06x", palette.accents[i]);
+		}
+
+		g_string_append_printf(palette_value, "\t%s", path);
+		system_setting_vconf_set_value_string(system_setting_wallpaper_palette_key(key), palette_value->str);
+		g_string_free(palette_value, TRUE);
+	}
+
+	ecore_x_window_size_get(ecore_x_window_root_first_get(), &screen_w, &screen_h);
+	hash = system_setting_wallpaper_hash(path);
+
+	if (hash != NULL && screen_w > 0 && screen_h > 0)
+	{
+		/* named by content, so the home and lock screen share the copy of the same image */
+		cache_path = g_strdup_printf("%s/%s-%dx%d.jpg", WALLPAPER_CACHE_DIR, hash, screen_w, screen_h);
+
+		if (access(cache_path, R_OK)
+			&& (!ecore_file_mkpath(WALLPAPER_CACHE_DIR)
+				|| !system_setting_wallpaper_prescale(path, cache_path, screen_w, screen_h)))
+		{
+			g_free(cache_path);
+			cache_path = NULL;
+		}
+	}
+
+	/* a failure only costs the optimization, the wallpaper is still set */
+	cache_value = g_strdup_printf("%s\t%s", cache_path != NULL ? cache_path : path, path);
+	system_setting_vconf_set_value_string(system_setting_wallpaper_cache_key(key), cache_value);
+	system_setting_wallpaper_evict(key, cache_path);
+
+	g_free(cache_value);
+	g_free(cache_path);
+	g_free(hash);
+
+	return SYSTEM_SETTINGS_ERROR_NONE;
+}
+
+/*PUBLIC*/
+int system_settings_set_wallpaper_prescale(bool enable)
+{
+	g_atomic_int_set(&wallpaper_prescale, enable);
+
+	return SYSTEM_SETTINGS_ERROR_NONE;
+}
+
+int system_settings_get_wallpaper_optimized_path(system_settings_key_e key, char **path)
+{
+	char *wallpaper = NULL;
+	char *cache_value = NULL;
+	char *separator;
+	int ret;
+
+	if ((key != SYSTEM_SETTINGS_KEY_WALLPAPER_HOME_SCREEN && key != SYSTEM_SETTINGS_KEY_WALLPAPER_LOCK_SCREEN) || path == NULL)
+	{
+		LOGE("[%s] INVALID_PARAMETER(0x%08x) : invalid argument", __FUNCTION__, SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER);
+		return SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER;
+	}
+
+	ret = system_settings_get_value(key, SYSTEM_SETTING_DATA_TYPE_STRING, (void**)&wallpaper);
+
+	if (ret != SYSTEM_SETTINGS_ERROR_NONE)
+	{
+		return ret;
+	}
+
+	/* the copy is used only if it was made from the current wallpaper and still exists */
+	if (!system_setting_vconf_get_value_string(system_setting_wallpaper_cache_key(key), &cache_value)
+		&& (separator = strchr(cache_value, '\t')) != NULL
+		&& !strcmp(separator + 1, wallpaper))
+	{
+		*separator = '\0';
+
+		if (!access(cache_value, R_OK))
+		{
+			free(wallpaper);
+			*path = cache_value;
+			return SYSTEM_SETTINGS_ERROR_NONE;
+		}
+	}
+
+	free(cache_value);
+	*path = wallpaper;
+
+	return SYSTEM_SETTINGS_ERROR_NONE;
+}
+
+int system_settings_get_wallpaper_palette(system_settings_key_e key, system_settings_palette_s *palette)
+{
+	char *wallpaper = NULL;
+	char *palette_value = NULL;
+	int ret;
+
+	if ((key != SYSTEM_SETTINGS_KEY_WALLPAPER_HOME_SCREEN && key != SYSTEM_SETTINGS_KEY_WALLPAPER_LOCK_SCREEN) || palette == NULL)
+	{
+		LOGE("[%s] INVALID_PARAMETER(0x%08x) : invalid argument", __FUNCTION__, SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER);
+		return SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER;
+	}
+
+	ret = system_settings_get_value(key, SYSTEM_SETTING_DATA_TYPE_STRING, (void**)&wallpaper);
+
+	if (ret != SYSTEM_SETTINGS_ERROR_NONE)
+	{
+		return ret;
+	}
+
+	/* the wallpaper was set without this library, e.g. straight through vconf */
+	if (system_setting_vconf_get_value_string(system_setting_wallpaper_palette_key(key), &palette_value)
+		|| !system_setting_wallpaper_palette_parse(palette_value, wallpaper, palette))
+	{
+		ret = system_setting_wallpaper_palette(wallpaper, palette);
+	}
+
+	free(palette_value);
+	free(wallpaper);
+
+	return ret;
+}
@@ -0,0 +1,166 @@
+/*
+ * Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Generates the perfect hash table of the key names from the key schema, see
+ * include/system_settings_key_name_private.h. Run by the build.
+ *
+ * usage: system-settings-key-hash-generator <output>
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <system_settings.h>
+#include <system_settings_private.h>
+#include <system_settings_key_name_private.h>
+
+#define SEED_TRIES 1000000
+#define SLOTS_MAX 4096
+
+typedef struct {
+	const char *name;
+	int key;
+} key_name_s;
+
+#define KEY_NAME_ENTRY(name, key, type, vconf_key, min, max, get, check, apply, groups) \
+	{ #name, key },
+
+static const key_name_s key_names[] = {
+	SYSTEM_SETTING_SCHEMA(KEY_NAME_ENTRY)
+};
+
+#define KEY_NAME_COUNT (int)(sizeof(key_names) / sizeof(key_names[0]))
+
+/* fills slots[] with the index of the name of each slot, or -1 */
+static int try_seed(unsigned int seed, unsigned int slot_count, int *slots)
+{
+	size_t length;
+	unsigned int slot;
+	int i;
+
+	for (slot = 0; slot < slot_count; slot++)
+	{
+		slots[slot] = -1;
+	}
+
+	for (i = 0; i < KEY_NAME_COUNT; i++)
+	{
+		slot = system_setting_key_name_hash(key_names[i].name, seed, &length) & (slot_count - 1);
+
+		if (slots[slot] != -1)
+		{
+			return -1;
+		}
+		slots[slot] = i;
+	}
+
+	return 0;
+}
+
+int main(int argc, char *argv[])
+{
+	static int slots[SLOTS_MAX];
+	unsigned int slot_count = 1;
+	unsigned int seed = 0;
+	size_t name_max = 0;
+	unsigned int slot;
+	FILE *out;
+	int found = 0;
+	int i;
+
+	if (argc != 2)
+	{
+		fprintf(stderr, "usage: %s <output>\n", argv[0]);
+		return 1;
+	}
+
+	for (i = 0; i < KEY_NAME_COUNT; i++)
+	{
+		if (strlen(key_names[i].name) > name_max)
+		{
+			name_max = strlen(key_names[i].name);
+		}
+		if (key_names[i].key > 0xff)
+		{
+			fprintf(stderr, "key %s out of range\n", key_names[i].name);
+			return 1;
+		}
+	}
+
+	while (slot_count < (unsigned int)KEY_NAME_COUNT)
+	{
+		slot_count <<= 1;
+	}
+
+	/* the smallest table first, a larger one when no seed fits */
+	for (; slot_count <= SLOTS_MAX && !found; slot_count <<= 1)
+	{
+		for (seed = 0; seed < SEED_TRIES; seed++)
+		{
+			if (!try_seed(seed, slot_count, slots))
+			{
+				found = 1;
+				break;
+			}
+		}
+	}
+
+	if (!found)
+	{
+		fprintf(stderr, "no perfect hash of %d names\n", KEY_NAME_COUNT);
+		return 1;
+	}
+	slot_count >>= 1;
+
+	out = fopen(argv[1], "w");
+	if (out == NULL)
+	{
+		perror(argv[1]);
+		return 1;
+	}
+
+	fprintf(out, "/* generated by system-settings-key-hash-generator from the key schema, do not edit */\n\n");
+	fprintf(out, "#define SYSTEM_SETTING_KEY_NAME_SEED 0x%08xu\n", seed);
+	fprintf(out, "#define SYSTEM_SETTING_KEY_NAME_SLOTS %u\n", slot_count);
+	fprintf(out, "#define SYSTEM_SETTING_KEY_NAME_MAX %zu\n\n", name_max);
+	fprintf(out, "static const struct {\n\tunsigned char length;\n\tunsigned char key;\n\tchar name[SYSTEM_SETTING_KEY_NAME_MAX + 1];\n}");
+	fprintf(out, " system_setting_key_name_slots[SYSTEM_SETTING_KEY_NAME_SLOTS] = {\n");
+
+	for (slot = 0; slot < slot_count; slot++)
+	{
+		if (slots[slot] == -1)
+		{
+			fprintf(out, "\t{ 0, 0, \"\" },\n");
+		}
+		else
+		{
+			fprintf(out, "\t{ %zu, %d, \"%s\" },\n", strlen(key_names[slots[slot]].name),
+				key_names[slots[slot]].key, key_names[slots[slot]].name);
+		}
+	}
+
+	fprintf(out, "};\n");
+
+	if (fclose(out))
+	{
+		perror(argv[1]);
+		return 1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,436 @@
+/*
+ * Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Replays a trace recorded with SYSTEM_SETTINGS_RECORD=<file> and reports the
+ * latency of each kind of operation, next to the latency of the recording.
+ *
+ * usage: system-settings-replay [-m] [-s speed] <trace>
+ *
+ *   -m        replay against the in-memory backend, seeded with the first
+ *             value of each key found in the trace. Recorded notifications
+ *             are replayed as writes to the store. Without -m the real vconf
+ *             backend is used and recorded notifications are skipped.
+ *   -s speed  1 keeps the recorded timing, 10 runs 10 times faster and 0 runs
+ *             as fast as possible (default 1).
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <time.h>
+
+#include <glib.h>
+
+#include <system_settings.h>
+#include <system_settings_private.h>
+#include <system_settings_backend_private.h>
+#include <system_settings_record_private.h>
+
+#define OP_COUNT (SYSTEM_SETTING_RECORD_COMPARE_AND_SET + 1)
+
+typedef struct {
+	system_setting_record_s record;
+	bool has_value;
+	system_setting_value_s value;
+} replay_event_s;
+
+typedef struct {
+	GArray *recorded;		/* uint64_t ns */
+	GArray *replayed;		/* uint64_t ns */
+	unsigned int errors;	/* replayed calls whose result differs from the recording */
+} replay_stat_s;
+
+static const char *op_names[OP_COUNT] = {
+	[SYSTEM_SETTING_RECORD_GET] = "get",
+	[SYSTEM_SETTING_RECORD_SET] = "set",
+	[SYSTEM_SETTING_RECORD_NOTIFY] = "notify",
+	[SYSTEM_SETTING_RECORD_SUBSCRIBE] = "subscribe",
+	[SYSTEM_SETTING_RECORD_UNSUBSCRIBE] = "unsubscribe",
+	[SYSTEM_SETTING_RECORD_COMPARE_AND_SET] = "cas",
+};
+
+static unsigned int callbacks_delivered;
+
+
+static uint64_t now_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+static void replay_changed_cb(system_settings_key_e key, system_settings_value_h value, void *user_data)
+{
+	callbacks_delivered++;
+}
+
+static int read_value(FILE *in, const system_setting_record_s *record, system_setting_value_s *value)
+{
+	int32_t int_value;
+	uint8_t bool_value;
+
+	memset(value, 0, sizeof(*value));
+	value->data_type = record->data_type;
+
+	switch (record->data_type)
+	{
+	case SYSTEM_SETTING_DATA_TYPE_STRING:
+		value->value.s = calloc(1, record->size + 1);
+		return value->value.s != NULL && (record->size == 0 || fread(value->value.s, record->size, 1, in) == 1) ? 0 : -1;
+
+	case SYSTEM_SETTING_DATA_TYPE_INT:
+		if (record->size != sizeof(int_value) || fread(&int_value, sizeof(int_value), 1, in) != 1)
+		{
+			return -1;
+		}
+		value->value.i = int_value;
+		return 0;
+
+	case SYSTEM_SETTING_DATA_TYPE_DOUBLE:
+		if (record->size != sizeof(double))
+		{
+			return -1;
+		}
+		return fread(&value->value.d, sizeof(double), 1, in) == 1 ? 0 : -1;
+
+	case SYSTEM_SETTING_DATA_TYPE_BOOL:
+		if (record->size != sizeof(bool_value) || fread(&bool_value, sizeof(bool_value), 1, in) != 1)
+		{
+			return -1;
+		}
+		value->value.b = bool_value != 0;
+		return 0;
+
+	default:
+		return -1;
+	}
+}
+
+static GArray *load_trace(const char *path)
+{
+	system_setting_record_header_s header;
+	replay_event_s event;
+	GArray *events;
+	FILE *in;
+
+	in = fopen(path, "rb");
+	if (in == NULL)
+	{
+		perror(path);
+		return NULL;
+	}
+
+	if (fread(&header, sizeof(header), 1, in) != 1
+		|| header.magic != SYSTEM_SETTING_RECORD_MAGIC || header.version != SYSTEM_SETTING_RECORD_VERSION)
+	{
+		fprintf(stderr, "%s: not a system settings trace\n", path);
+		fclose(in);
+		return NULL;
+	}
+
+	events = g_array_new(FALSE, FALSE, sizeof(replay_event_s));
+
+	while (fread(&event.record, sizeof(event.record), 1, in) == 1)
+	{
+		event.has_value = event.record.data_type != SYSTEM_SETTING_RECORD_NO_VALUE;
+
+		if (event.has_value && read_value(in, &event.record, &event.value))
+		{
+			fprintf(stderr, "%s: truncated record %u\n", path, events->len);
+			break;
+		}
+
+		if (event.record.op == 0 || event.record.op >= OP_COUNT)
+		{
+			fprintf(stderr, "%s: unknown operation %u\n", path, event.record.op);
+			break;
+		}
+
+		g_array_append_val(events, event);
+	}
+
+	fclose(in);
+	return events;
+}
+
+/* stores the first value of each key so that the replayed reads succeed */
+static void seed_memory_backend(GArray *events)
+{
+	bool seeded[SYSTEM_SETTINGS_KEY_COUNT] = { false, };
+	system_setting_h item;
+	replay_event_s *event;
+	unsigned int i;
+
+	for (i = 0; i < events->len; i++)
+	{
+		event = &g_array_index(events, replay_event_s, i);
+
+		if (!event->has_value || (unsigned int)event->record.key >= SYSTEM_SETTINGS_KEY_COUNT
+			|| seeded[event->record.key] || system_settings_get_item(event->record.key, &item))
+		{
+			continue;
+		}
+
+		if (event->value.data_type == item->data_type)
+		{
+			system_setting_backend_memory.set_value(item->vconf_key, &event->value);
+			seeded[event->record.key] = true;
+		}
+	}
+}
+
+static int replay_event(replay_event_s *event, bool memory)
+{
+	system_setting_h item;
+	union {
+		char *s;
+		int i;
+		double d;
+		bool b;
+	} out;
+	void *in;
+	int ret;
+
+	if (system_settings_get_item(event->record.key, &item))
+	{
+		return SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER;
+	}
+
+	switch (event->record.op)
+	{
+	case SYSTEM_SETTING_RECORD_GET:
+		memset(&out, 0, sizeof(out));
+		ret = system_settings_get_value(event->record.key, item->data_type, (void**)&out);
+		if (ret == SYSTEM_SETTINGS_ERROR_NONE && item->data_type == SYSTEM_SETTING_DATA_TYPE_STRING)
+		{
+			free(out.s);
+		}
+		return ret;
+
+	case SYSTEM_SETTING_RECORD_SET:
+		if (!event->has_value)
+		{
+			return event->record.result;
+		}
+		in = event->value.data_type == SYSTEM_SETTING_DATA_TYPE_STRING ? (void*)event->value.value.s : (void*)&event->value.value;
+		return system_settings_set_value(event->record.key, event->value.data_type, in);
+
+	case SYSTEM_SETTING_RECORD_COMPARE_AND_SET:
+		/* a conflict depends on the other writers of the recording, only the successful ones are replayed */
+		if (!event->has_value || event->value.data_type != item->data_type || event->record.result != SYSTEM_SETTINGS_ERROR_NONE)
+		{
+			return event->record.result;
+		}
+		memset(&out, 0, sizeof(out));
+		ret = system_settings_get_value(event->record.key, item->data_type, (void**)&out);
+		if (ret != SYSTEM_SETTINGS_ERROR_NONE)
+		{
+			return ret;
+		}
+		in = event->value.data_type == SYSTEM_SETTING_DATA_TYPE_STRING ? (void*)event->value.value.s : (void*)&event->value.value;
+		ret = system_settings_compare_and_set_value(event->record.key, item->data_type,
+				item->data_type == SYSTEM_SETTING_DATA_TYPE_STRING ? (void*)out.s : (void*)&out, in, NULL);
+		if (item->data_type == SYSTEM_SETTING_DATA_TYPE_STRING)
+		{
+			free(out.s);
+		}
+		return ret;
+
+	case SYSTEM_SETTING_RECORD_NOTIFY:
+		if (!memory)
+		{
+			return SYSTEM_SETTINGS_ERROR_NONE;
+		}
+		if (event->has_value)
+		{
+			return system_setting_backend_memory.set_value(item->vconf_key, &event->value) ? SYSTEM_SETTINGS_ERROR_IO_ERROR : SYSTEM_SETTINGS_ERROR_NONE;
+		}
+		system_setting_backend_changed(event->record.key, NULL);
+		return SYSTEM_SETTINGS_ERROR_NONE;
+
+	case SYSTEM_SETTING_RECORD_SUBSCRIBE:
+		return system_settings_add_value_changed_cb(event->record.key, replay_changed_cb, NULL);
+
+	case SYSTEM_SETTING_RECORD_UNSUBSCRIBE:
+		return system_settings_remove_value_changed_cb(event->record.key, replay_changed_cb);
+
+	default:
+		return SYSTEM_SETTINGS_ERROR_INVALID_PARAMETER;
+	}
+}
+
+static int compare_ns(const void *a, const void *b)
+{
+	uint64_t x = *(const uint64_t*)a;
+	uint64_t y = *(const uint64_t*)b;
+
+	return x < y ? -1 : x > y;
+}
+
+static uint64_t percentile(GArray *samples, double p)
+{
+	if (samples->len == 0)
+	{
+		return 0;
+	}
+
+	return g_array_index(samples, uint64_t, (unsigned int)((samples->len - 1) * p));
+}
+
+static void print_stats(replay_stat_s *stats)
+{
+	int op;
+
+	printf("%-12s %8s %8s %12s %12s %12s %12s %12s\n", "op", "count", "errors",
+			"rec p50", "rec p99", "p50", "p99", "max");
+
+	for (op = 1; op < OP_COUNT; op++)
+	{
+		if (stats[op].replayed->len == 0)
+		{
+			continue;
+		}
+
+		g_array_sort(stats[op].recorded, compare_ns);
+		g_array_sort(stats[op].replayed, compare_ns);
+
+		printf("%-12s %8u %8u %12llu %12llu %12llu %12llu %12llu\n", op_names[op],
+				stats[op].replayed->len, stats[op].errors,
+				(unsigned long long)percentile(stats[op].recorded, 0.50),
+				(unsigned long long)percentile(stats[op].recorded, 0.99),
+				(unsigned long long)percentile(stats[op].replayed, 0.50),
+				(unsigned long long)percentile(stats[op].replayed, 0.99),
+				(unsigned long long)percentile(stats[op].replayed, 1.0));
+	}
+
+	printf("latencies in ns, %u callbacks delivered\n", callbacks_delivered);
+}
+
+int main(int argc, char *argv[])
+{
+	replay_stat_s stats[OP_COUNT];
+	replay_event_s *event;
+	GArray *events;
+	bool memory = false;
+	double speed = 1.0;
+	uint64_t start, target, begin, end, now;
+	uint64_t sample;
+	unsigned int i;
+	int opt;
+	int ret;
+
+	while ((opt = getopt(argc, argv, "ms:")) != -1)
+	{
+		switch (opt)
+		{
+		case 'm':
+			memory = true;
+			break;
+		case 's':
+			speed = atof(optarg);
+			break;
+		default:
+			fprintf(stderr, "usage: %s [-m] [-s speed] <trace>\n", argv[0]);
+			return 1;
+		}
+	}
+
+	if (optind + 1 != argc || speed < 0)
+	{
+		fprintf(stderr, "usage: %s [-m] [-s speed] <trace>\n", argv[0]);
+		return 1;
+	}
+
+	events = load_trace(argv[optind]);
+	if (events == NULL)
+	{
+		return 1;
+	}
+
+	if (memory)
+	{
+		system_setting_backend_set(&system_setting_backend_memory);
+		seed_memory_backend(events);
+	}
+
+	for (i = 0; i < OP_COUNT; i++)
+	{
+		stats[i].recorded = g_array_new(FALSE, FALSE, sizeof(uint64_t));
+		stats[i].replayed = g_array_new(FALSE, FALSE, sizeof(uint64_t));
+		stats[i].errors = 0;
+	}
+
+	start = now_ns();
+
+	for (i = 0; i < events->len; i++)
+	{
+		event = &g_array_index(events, replay_event_s, i);
+
+		if (speed > 0)
+		{
+			target = start + (uint64_t)(event->record.timestamp / speed);
+			now = now_ns();
+			if (target > now)
+			{
+				usleep((target - now) / 1000);
+			}
+		}
+
+		begin = now_ns();
+		ret = replay_event(event, memory);
+		end = now_ns();
+
+		if (event->record.op == SYSTEM_SETTING_RECORD_NOTIFY && !memory)
+		{
+			continue;
+		}
+
+		sample = end - begin;
+		g_array_append_val(stats[event->record.op].replayed, sample);
+		sample = event->record.duration;
+		g_array_append_val(stats[event->record.op].recorded, sample);
+
+		if (ret != event->record.result)
+		{
+			stats[event->record.op].errors++;
+		}
+	}
+
+	printf("%u records replayed on the %s backend in %.3f s\n", events->len,
+			system_setting_backend_get()->name, (now_ns() - start) / 1e9);
+	print_stats(stats);
+
+	for (i = 0; i < events->len; i++)
+	{
+		event = &g_array_index(events, replay_event_s, i);
+		if (event->has_value)
+		{
+			system_setting_value_clear(&event->value);
+		}
+	}
+	g_array_free(events, TRUE);
+
+	for (i = 0; i < OP_COUNT; i++)
+	{
+		g_array_free(stats[i].recorded, TRUE);
+		g_array_free(stats[i].replayed, TRUE);
+	}
+
+	return 0;
+}
@@ -0,0 +1,209 @@
+/*
+ * Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the License);
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Compiles a vendor key description into the binary schema mapped by the
+ * library. Each line of the input describes one key:
+ *
+ *   # id  type    vconf key                    [min max]
+ *   0     int     db/vendor/led_brightness     0 255
+ *   1     bool    db/vendor/glove_mode
+ *   2     string  db/vendor/boot_animation
+ *
+ * id is the offset from SYSTEM_SETTINGS_KEY_VENDOR_BASE.
+ *
+ * usage: system-settings-vendor-compiler <input> <output>
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <system_settings.h>
+#include <system_settings_private.h>
+#include <system_settings_vendor_private.h>
+
+#define LINE_MAX_LEN 1024
+#define ID_MAX 0xffff
+
+static int parse_type(const char *name, uint32_t *type)
+{
+	if (!strcmp(name, "string"))
+	{
+		*type = SYSTEM_SETTING_DATA_TYPE_STRING;
+	}
+	else if (!strcmp(name, "int"))
+	{
+		*type = SYSTEM_SETTING_DATA_TYPE_INT;
+	}
+	else if (!strcmp(name, "double"))
+	{
+		*type = SYSTEM_SETTING_DATA_TYPE_DOUBLE;
+	}
+	else if (!strcmp(name, "bool"))
+	{
+		*type = SYSTEM_SETTING_DATA_TYPE_BOOL;
+	}
+	else
+	{
+		return -1;
+	}
+	return 0;
+}
+
+int main(int argc, char *argv[])
+{
+	system_setting_vendor_header_s header;
+	system_setting_vendor_record_s *records = NULL;
+	char *strings = NULL;
+	uint32_t count = 0;
+	uint32_t strings_size = 1;	/* offset 0 is the empty string */
+	char line[LINE_MAX_LEN];
+	int line_no = 0;
+	FILE *in;
+	FILE *out;
+	void *grown;
+	uint32_t i;
+
+	if (argc != 3)
+	{
+		fprintf(stderr, "usage: %s <input> <output>\n", argv[0]);
+		return 1;
+	}
+
+	in = fopen(argv[1], "r");
+	if (in == NULL)
+	{
+		perror(argv[1]);
+		return 1;
+	}
+
+	strings = calloc(1, 1);
+	if (strings == NULL)
+	{
+		fprintf(stderr, "out of memory\n");
+		return 1;
+	}
+
+	while (fgets(line, sizeof(line), in) != NULL)
+	{
+		char type_name[32];
+		char vconf_key[LINE_MAX_LEN];
+		unsigned int id;
+		int min = 0;
+		int max = 0;
+		int fields;
+		size_t key_len;
+
+		line_no++;
+
+		if (line[0] == '#' || strspn(line, " \t\r\n") == strlen(line))
+		{
+			continue;
+		}
+
+		fields = sscanf(line, "%u %31s %1023s %d %d", &id, type_name, vconf_key, &min, &max);
+
+		if (fields != 3 && fields != 5)
+		{
+			fprintf(stderr, "%s:%d: expected <id> <type> <vconf key> [min max]\n", argv[1], line_no);
+			return 1;
+		}
+
+		if (id > ID_MAX)
+		{
+			fprintf(stderr, "%s:%d: id %u is out of range\n", argv[1], line_no, id);
+			return 1;
+		}
+
+		if (id >= count)
+		{
+			grown = realloc(records, (id + 1) * sizeof(*records));
+			if (grown == NULL)
+			{
+				fprintf(stderr, "out of memory\n");
+				return 1;
+			}
+			records = grown;
+
+			for (i = count; i <= id; i++)
+			{
+				records[i].data_type = SYSTEM_SETTING_VENDOR_TYPE_NONE;
+				records[i].min = 0;
+				records[i].max = 0;
+				records[i].vconf_key = 0;
+			}
+			count = id + 1;
+		}
+		else if (records[id].data_type != SYSTEM_SETTING_VENDOR_TYPE_NONE)
+		{
+			fprintf(stderr, "%s:%d: duplicated id %u\n", argv[1], line_no, id);
+			return 1;
+		}
+
+		if (parse_type(type_name, &records[id].data_type))
+		{
+			fprintf(stderr, "%s:%d: unknown type '%s'\n", argv[1], line_no, type_name);
+			return 1;
+		}
+
+		key_len = strlen(vconf_key) + 1;
+		grown = realloc(strings, strings_size + key_len);
+		if (grown == NULL)
+		{
+			fprintf(stderr, "out of memory\n");
+			return 1;
+		}
+		strings = grown;
+
+		memcpy(strings + strings_size, vconf_key, key_len);
+
+		records[id].min = min;
+		records[id].max = max;
+		records[id].vconf_key = strings_size;
+		strings_size += key_len;
+	}
+
+	fclose(in);
+
+	memset(&header, 0, sizeof(header));
+	header.magic = SYSTEM_SETTING_VENDOR_SCHEMA_MAGIC;
+	header.version = SYSTEM_SETTING_VENDOR_SCHEMA_VERSION;
+	header.count = count;
+	header.strings_offset = sizeof(header) + count * sizeof(*records);
+	header.strings_size = strings_size;
+
+	out = fopen(argv[2], "wb");
+	if (out == NULL)
+	{
+		perror(argv[2]);
+		return 1;
+	}
+
+	if (fwrite(&header, sizeof(header), 1, out) != 1
+		|| (count && fwrite(records, sizeof(*records), count, out) != count)
+		|| fwrite(strings, strings_size, 1, out) != 1
+		|| fclose(out))
+	{
+		perror(argv[2]);
+		return 1;
+	}
+
+	free(records);
+	free(strings);
+
+	return 0;
+}